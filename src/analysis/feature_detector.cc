@@ -2,7 +2,7 @@
 #include "ast/ast.h"
 #include <functional>
 
-// Scan view nodes for event handler attributes
+// Scan view nodes for event handler attributes and keyed loops
 static void scan_view_for_events(ASTNode *node, FeatureFlags &flags)
 {
     if (!node)
@@ -40,6 +40,8 @@ static void scan_view_for_events(ASTNode *node, FeatureFlags &flags)
     }
     else if (auto *viewForEach = dynamic_cast<ViewForEachStatement *>(node))
     {
+        if (viewForEach->key_expr)
+            flags.keyed = true;
         for (const auto &child : viewForEach->children)
             scan_view_for_events(child.get(), flags);
     }
@@ -72,7 +74,28 @@ FeatureFlags detect_features(const std::vector<Component> &components,
         }
     }
 
-    // Detect keyboard usage (Input.isKeyDown) and Json.parse usage
+    // Detect batch { } / sync { } blocks anywhere in method bodies
+    std::function<void(ASTNode *)> scan_batch = [&](ASTNode *node)
+    {
+        if (!node || flags.batch)
+            return;
+        if (dynamic_cast<BatchStatement *>(node))
+        {
+            flags.batch = true;
+            return;
+        }
+        node->for_each_child_node([&](ASTNode *child) { scan_batch(child); });
+    };
+    for (const auto &comp : components)
+    {
+        for (const auto &method : comp.methods)
+        {
+            for (const auto &stmt : method.body)
+                scan_batch(stmt.get());
+        }
+    }
+
+    // Detect keyboard usage (Input.isKeyDown) and Json.parse/stringify usage
     // by scanning for specific patterns in method bodies
     std::function<void(Expression *)> scan_expr = [&](Expression *expr)
     {
@@ -85,11 +108,15 @@ FeatureFlags detect_features(const std::vector<Component> &components,
             {
                 flags.keyboard = true;
             }
-            // Check for Json.parse pattern
-            if (call->name == "Json.parse")
+            // Check for Json.parse pattern (Json.feed decodes with the same runtime)
+            if (call->name == "Json.parse" || call->name == "Json.feed")
             {
                 flags.json = true;
             }
+            if (call->name == "Json.stringify")
+            {
+                flags.json_stringify = true;
+            }
             for (auto &arg : call->args)
                 scan_expr(arg.value.get());
         }
@@ -151,6 +178,11 @@ FeatureFlags detect_features(const std::vector<Component> &components,
                 }
             }
         }
+        else
+        {
+            // Any other expression (template strings, indexing, ...): scan its children
+            expr->for_each_child([&](Expression *child) { scan_expr(child); });
+        }
     };
 
     std::function<void(Statement *)> scan_stmt = [&](Statement *stmt)
@@ -184,6 +216,17 @@ FeatureFlags detect_features(const std::vector<Component> &components,
         {
             scan_expr(ret->value.get());
         }
+        else
+        {
+            // Loops and other statements: scan whatever they contain
+            stmt->for_each_child_node([&](ASTNode *child)
+            {
+                if (auto *child_expr = dynamic_cast<Expression *>(child))
+                    scan_expr(child_expr);
+                else if (auto *child_stmt = dynamic_cast<Statement *>(child))
+                    scan_stmt(child_stmt);
+            });
+        }
     };
 
     for (const auto &comp : components)
@@ -195,6 +238,12 @@ FeatureFlags detect_features(const std::vector<Component> &components,
                 scan_stmt(stmt.get());
             }
         }
+        // A JsonStream member needs the runtime even before anything feeds it
+        for (const auto &var : comp.state)
+        {
+            if (var->type == "JsonStream")
+                flags.json = true;
+        }
     }
 
     return flags;
@@ -320,6 +369,28 @@ void emit_feature_event_handlers(std::ostream &out, const FeatureFlags &f)
     }
 }
 
+// Emit the body of __coi_events::keep_text: one line per event type that carries a string
+void emit_feature_event_text(std::ostream &out, const FeatureFlags &f)
+{
+    auto keep = [&](const char *type, const char *field)
+    {
+        out << "    if (q.e.opcode == " << type << "::OPCODE) keep(const_cast<" << type << "*>(q.e.as<" << type << ">())->" << field << ", q, own);\n";
+    };
+    if (f.input)
+        keep("webcc::dom::InputEvent", "value");
+    if (f.change)
+        keep("webcc::dom::ChangeEvent", "value");
+    if (f.router)
+        keep("webcc::system::PopstateEvent", "path");
+    if (f.websocket)
+        keep("webcc::websocket::MessageEvent", "data");
+    if (f.fetch)
+    {
+        keep("webcc::fetch::SuccessEvent", "data");
+        keep("webcc::fetch::ErrorEvent", "error");
+    }
+}
+
 // Check if the Dispatcher template is needed
 bool needs_dispatcher(const FeatureFlags &f)
 {
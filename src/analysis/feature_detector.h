@@ -21,7 +21,10 @@ struct FeatureFlags
     bool router = false;      // Browser history/popstate (any component)
     bool websocket = false;   // WebSocket connections
     bool fetch = false;       // HTTP fetch requests
-    bool json = false;        // JSON parsing (Json.parse)
+    bool json = false;        // JSON parsing (Json.parse, Json.feed)
+    bool json_stringify = false; // JSON serializers (Json.stringify)
+    bool keyed = false;       // Keyed <for> loops (reconciliation helpers)
+    bool batch = false;       // batch { } / sync { } blocks (update scheduler)
 };
 
 // Detect which features are actually used by analyzing components
@@ -34,6 +37,9 @@ void emit_feature_globals(std::ostream &out, const FeatureFlags &f);
 // Emit event handlers for enabled features
 void emit_feature_event_handlers(std::ostream &out, const FeatureFlags &f);
 
+// Emit the body of __coi_events::keep_text: one line per event type that carries a string
+void emit_feature_event_text(std::ostream &out, const FeatureFlags &f);
+
 // Check if the Dispatcher template is needed
 bool needs_dispatcher(const FeatureFlags &f);
 
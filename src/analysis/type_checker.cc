@@ -1147,8 +1147,7 @@ static void validate_variant_binding_types(ASTNode *node)
         }
     }
 
-    for (auto *child : node->get_child_nodes())
-        validate_variant_binding_types(child);
+    node->for_each_child_node([](ASTNode *child) { validate_variant_binding_types(child); });
 }
 
 void validate_types(const std::vector<Component> &components,
@@ -2287,6 +2286,27 @@ void validate_view_hierarchy(const std::vector<Component> &components,
         return scope;
     };
 
+    // Loop items render their <if> blocks statically, so there is nothing to keep
+    std::function<void(ASTNode *)> reject_kept_if_in_loop = [&](ASTNode *node)
+    {
+        if (auto *el = dynamic_cast<HTMLElement *>(node))
+        {
+            for (const auto &child : el->children)
+                reject_kept_if_in_loop(child.get());
+        }
+        else if (auto *viewIf = dynamic_cast<ViewIfStatement *>(node))
+        {
+            if (viewIf->keep)
+            {
+                throw std::runtime_error("<if ... keep> is not supported inside <for> at line " + std::to_string(viewIf->line));
+            }
+            for (const auto &child : viewIf->then_children)
+                reject_kept_if_in_loop(child.get());
+            for (const auto &child : viewIf->else_children)
+                reject_kept_if_in_loop(child.get());
+        }
+    };
+
     std::function<void(ASTNode *, const Component *, std::map<std::string, std::string> &)> validate_node =
         [&](ASTNode *node, const Component *parent_comp, std::map<std::string, std::string> &scope)
     {
@@ -2581,6 +2601,21 @@ void validate_view_hierarchy(const std::vector<Component> &components,
         }
         else if (auto *viewIf = dynamic_cast<ViewIfStatement *>(node))
         {
+            if (viewIf->keep)
+            {
+                // Kept branches are parked by moving their top-level nodes
+                for (const auto *branch : {&viewIf->then_children, &viewIf->else_children})
+                {
+                    for (const auto &child : *branch)
+                    {
+                        if (!dynamic_cast<HTMLElement *>(child.get()) && !dynamic_cast<ComponentInstantiation *>(child.get()))
+                        {
+                            throw std::runtime_error("<if ... keep> branches may only hold elements and components at the top level at line " +
+                                std::to_string(viewIf->line));
+                        }
+                    }
+                }
+            }
             for (const auto &child : viewIf->then_children)
             {
                 validate_node(child.get(), parent_comp, scope);
@@ -2597,6 +2632,7 @@ void validate_view_hierarchy(const std::vector<Component> &components,
             loop_scope[viewFor->var_name] = "int32"; // Range loops always use int32
             for (const auto &child : viewFor->children)
             {
+                reject_kept_if_in_loop(child.get());
                 validate_node(child.get(), parent_comp, loop_scope);
             }
         }
@@ -2620,8 +2656,30 @@ void validate_view_hierarchy(const std::vector<Component> &components,
             {
                 loop_scope[viewForEach->var_name] = "unknown";
             }
+            if (viewForEach->window_start)
+            {
+                for (Expression *bound : {viewForEach->window_start.get(), viewForEach->window_end.get()})
+                {
+                    std::string bound_type = normalize_type(infer_expression_type(bound, scope));
+                    if (bound_type != "unknown" && !is_compatible_type(bound_type, "int32"))
+                    {
+                        throw std::runtime_error("<for> window bounds must be int, got '" + display_type_name(bound_type) +
+                            "' at line " + std::to_string(viewForEach->line));
+                    }
+                }
+                // Windowed items are reconciled by key, which needs one root per item
+                auto *comp = viewForEach->children.size() == 1 ? dynamic_cast<ComponentInstantiation *>(viewForEach->children[0].get()) : nullptr;
+                bool single_root = viewForEach->children.size() == 1 &&
+                                   (dynamic_cast<HTMLElement *>(viewForEach->children[0].get()) || (comp && !comp->is_member_reference));
+                if (!single_root)
+                {
+                    throw std::runtime_error("<for> with window={...} needs exactly one element or child component per item at line " +
+                        std::to_string(viewForEach->line));
+                }
+            }
             for (const auto &child : viewForEach->children)
             {
+                reject_kept_if_in_loop(child.get());
                 validate_node(child.get(), parent_comp, loop_scope);
             }
         }
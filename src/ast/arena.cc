@@ -0,0 +1,45 @@
+#include "arena.h"
+#include <cstddef>
+#include <new>
+
+static thread_local AstArena* active_arena = nullptr;
+
+AstArena::~AstArena() {
+    for (char* block : blocks) ::operator delete(block);
+}
+
+void* AstArena::allocate(size_t size) {
+    constexpr size_t align = alignof(std::max_align_t);
+    size = (size + align - 1) & ~(align - 1);
+    nodes++;
+
+    if (static_cast<size_t>(end - next) < size) {
+        // Oversized nodes get a block of their own so the current one keeps
+        // its free space
+        if (size > block_size / 4) {
+            char* block = static_cast<char*>(::operator new(size));
+            blocks.push_back(block);
+            return block;
+        }
+        next = static_cast<char*>(::operator new(block_size));
+        end = next + block_size;
+        blocks.push_back(next);
+    }
+    void* p = next;
+    next += size;
+    return p;
+}
+
+AstArena& AstArena::current() {
+    if (active_arena) return *active_arena;
+    static thread_local AstArena thread_arena;
+    return thread_arena;
+}
+
+AstArena::Scope::Scope(AstArena& arena) : previous(active_arena) {
+    active_arena = &arena;
+}
+
+AstArena::Scope::~Scope() {
+    active_arena = previous;
+}
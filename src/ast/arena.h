@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Bump allocator that AST nodes are allocated from. Deleting a node only runs
+// its destructor; the memory of all nodes is released at once when the arena
+// is destroyed, so an arena must outlive every node allocated from it.
+class AstArena {
+    public:
+        AstArena() = default;
+        AstArena(const AstArena&) = delete;
+        AstArena& operator=(const AstArena&) = delete;
+        ~AstArena();
+
+        void* allocate(size_t size);
+
+        size_t node_count() const { return nodes; }
+        size_t block_count() const { return blocks.size(); }
+
+        // Arena that nodes created on this thread are allocated from: the
+        // innermost AstArena::Scope, or a per-thread arena that lives until
+        // the thread exits when there is none
+        static AstArena& current();
+
+        // Makes an arena the current one of this thread until the scope ends
+        class Scope {
+            public:
+                explicit Scope(AstArena& arena);
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+                ~Scope();
+
+            private:
+                AstArena* previous;
+        };
+
+    private:
+        static constexpr size_t block_size = 64 * 1024;
+
+        std::vector<char*> blocks;
+        char* next = nullptr;
+        char* end = nullptr;
+        size_t nodes = 0;
+};
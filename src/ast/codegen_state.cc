@@ -1,4 +1,5 @@
 #include "codegen_state.h"
+#include <algorithm>
 
 std::set<std::string> g_ref_props;
 std::string g_ws_assignment_target;
@@ -6,3 +7,60 @@ std::string g_ws_assignment_target;
 std::map<std::string, ComponentArrayLoopInfo> g_component_array_loops;
 std::map<std::string, ArrayLoopInfo> g_array_loops;
 std::map<std::string, HtmlLoopVarInfo> g_html_loop_var_infos;
+
+bool g_update_scheduler = false;
+bool g_frame_updates = false;
+std::vector<std::string> g_dirty_slots;
+std::map<std::string, std::vector<std::string>> g_var_updates;
+
+std::set<std::string> g_memo_components;
+std::map<std::string, int> g_memo_slot_counts;
+
+std::string mark_dirty_updates(const std::vector<std::string> &calls, const std::string &indent)
+{
+    std::string code;
+    for (const auto &call : calls)
+    {
+        size_t slot = std::find(g_dirty_slots.begin(), g_dirty_slots.end(), call) - g_dirty_slots.begin();
+        if (slot == g_dirty_slots.size())
+            g_dirty_slots.push_back(call);
+        code += indent + "_mark_dirty(" + std::to_string(slot) + ");\n";
+    }
+    return code;
+}
+
+std::string schedule_updates(const std::vector<std::string> &calls, const std::string &indent)
+{
+    auto direct = [&](const std::string &prefix)
+    {
+        std::string code;
+        for (const auto &call : calls)
+            code += prefix + call + "\n";
+        return code;
+    };
+    if (!g_update_scheduler || calls.empty())
+        return direct(indent);
+    if (g_frame_updates)
+        return mark_dirty_updates(calls, indent);
+    return indent + "if (__coi_sched::g_batch) {\n" + mark_dirty_updates(calls, indent + "    ") +
+           indent + "} else {\n" + direct(indent + "    ") + indent + "}\n";
+}
+
+std::string schedule_updates_inline(const std::vector<std::string> &calls)
+{
+    std::string result;
+    bool space = false;
+    for (char c : schedule_updates(calls, " "))
+    {
+        if (c == '\n' || c == ' ')
+        {
+            space = true;
+            continue;
+        }
+        if (space)
+            result += ' ';
+        result += c;
+        space = false;
+    }
+    return result;
+}
@@ -3,6 +3,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 // Shared mutable state used during component->C++ lowering.
 // Declared here and defined in codegen_state.cc so ownership is explicit.
@@ -15,8 +16,9 @@ struct ComponentArrayLoopInfo
     int loop_id;
     std::string component_type;
     std::string parent_var;
+    std::string anchor_var;
     std::string var_name;
-    std::string item_creation_code;
+    std::string item_creation_code;  // Inserts the item before anchor_var
     bool is_member_ref_loop;
     bool is_only_child;
 };
@@ -25,13 +27,6 @@ extern std::map<std::string, ComponentArrayLoopInfo> g_component_array_loops;
 struct ArrayLoopInfo
 {
     int loop_id;
-    std::string parent_var;
-    std::string anchor_var;
-    std::string elements_vec_name;
-    std::string var_name;
-    std::string item_creation_code;
-    std::string root_element_var;
-    bool is_only_child;
 };
 extern std::map<std::string, ArrayLoopInfo> g_array_loops;
 
@@ -41,3 +36,24 @@ struct HtmlLoopVarInfo
     std::string iterable_expr;
 };
 extern std::map<std::string, HtmlLoopVarInfo> g_html_loop_var_infos;
+
+// Deferred updaters (__coi_sched in the generated runtime). With the scheduler
+// on, each updater call of a component gets a dirty slot; mutations mark slots
+// and the component's _flush_dirty() runs every marked one once.
+extern bool g_update_scheduler;   // Runtime present: frame schedule or batch/sync blocks used
+extern bool g_frame_updates;      // app { schedule = "frame"; }: always defer to the frame end
+extern std::vector<std::string> g_dirty_slots;  // Updater calls of the component being generated
+extern std::map<std::string, std::vector<std::string>> g_var_updates;  // Member -> updater calls its mutation triggers
+
+// Components generated with cached bindings (app { memo = [...]; })
+extern std::set<std::string> g_memo_components;
+extern std::map<std::string, int> g_memo_slot_counts;  // Cached bindings per memo component
+
+// Lower a list of updater calls (e.g. "_update_count();") for the current
+// component: run them directly, mark their slots (frame schedule), or choose
+// at runtime depending on whether a batch { } is open.
+std::string schedule_updates(const std::vector<std::string> &calls, const std::string &indent);
+// Mark the calls' slots unconditionally (sync { } hands them to the drain)
+std::string mark_dirty_updates(const std::vector<std::string> &calls, const std::string &indent);
+// Same as schedule_updates, as a one-line lambda body: " a(); b();"
+std::string schedule_updates_inline(const std::vector<std::string> &calls);
@@ -31,6 +31,7 @@ struct RouteEntry {
     std::vector<RouteParam> path_params;           // ':' segments in path order (names from parser, types from type checker)
     std::vector<RouteCtorSlot> ctor_order;         // How to fill the component constructor (built by type checker)
     bool is_default = false;                       // True for 'else' route (catch-all)
+    int keep = 0;                                  // 'keep N': pages parked when navigating away (0 = destroyed)
     int line = 0;
 };
 
@@ -96,6 +97,17 @@ struct AppConfig {
     // Deploy base, emitted as <base href>. Set to a subpath (e.g. "/coi/") for
     // subpath deploys like GitHub project pages.
     std::string base = "/";
+    // When reactive updaters run: "sync" (at the end of each mutating method) or
+    // "frame" (marked dirty and run once per frame, before the final flush).
+    std::string schedule = "sync";
+    // Components whose bindings remember what they last wrote and skip
+    // unchanged DOM writes (memo = [Dashboard, Chart];)
+    std::set<std::string> memo;
+    // Merge back-to-back input/change events of one element into the last one,
+    // and run consecutive WebSocket messages as one update batch
+    bool coalesce = false;
+    // Milliseconds per frame spent dispatching events; the rest wait a frame
+    int event_budget = 8;
 };
 
 // Per-event bitmask over element ids, stored as 64-bit words (word el>>6,
@@ -1,4 +1,5 @@
 #include "component.h"
+#include "../codegen_state.h"
 
 // Resolve a component reference as it appears at a use site (a view child key
 // like "Button" or "TurboUI_Button", a state type like "Store" or
@@ -64,6 +65,12 @@ void emit_component_lifecycle_methods(std::stringstream &ss,
 
     // Destroy method
     ss << "    void _destroy() {\n";
+    if (g_update_scheduler)
+    {
+        // Drop queued updates: the view they would patch is going away
+        ss << "        __coi_sched::cancel(_sched_ticket, this);\n";
+        ss << "        _sched_live = false;\n";
+    }
 
     // Collect all elements that are conditionally created in if/else regions
     std::set<int> conditional_els;
@@ -103,6 +110,25 @@ void emit_component_lifecycle_methods(std::stringstream &ss,
         }
     };
 
+    // Kept <if> branches: the hidden one sits in the park with its handlers
+    // registered. Unregister them and drop the park with its nodes.
+    auto emit_kept_if_cleanup = [&]() {
+        for (const auto &region : if_regions)
+        {
+            if (!region.keep)
+                continue;
+            std::string p = "_if_" + std::to_string(region.if_id);
+            ss << "        if (" << p << "_park.is_valid()) {\n";
+            for (int el_id : region.then_element_ids)
+                emit_remove_handlers_for_element(el_id, "            ", "!" + p + "_state && " + p + "_then_built");
+            for (int el_id : region.else_element_ids)
+                emit_remove_handlers_for_element(el_id, "            ", p + "_state && " + p + "_else_built");
+            ss << "            webcc::dom::remove_element(" << p << "_park);\n";
+            ss << "            " << p << "_park = webcc::DOMElement();\n";
+            ss << "        }\n";
+        }
+    };
+
     // Determine if the view has if/else regions that control root elements
     // If so, we need to conditionally remove elements based on _if_N_state
     std::set<int> then_els, else_els;
@@ -216,13 +242,23 @@ void emit_component_lifecycle_methods(std::stringstream &ss,
             ss << "        webcc::dom::remove_element(el[0]);\n";
         }
     }
+    emit_kept_if_cleanup();
+
     // Cleanup route components
     if (component.router)
     {
+        bool any_kept = false;
         for (size_t i = 0; i < component.router->routes.size(); ++i)
         {
             ss << "        if (_route_" << i << ") { _route_" << i << "->_destroy(); delete _route_" << i << "; }\n";
+            if (component.router->routes[i].keep > 0)
+            {
+                ss << "        while (auto* _p = _route_" << i << "_keep.pop()) { _p->_destroy(); delete _p; }\n";
+                any_kept = true;
+            }
         }
+        if (any_kept)
+            ss << "        if (_route_park.is_valid()) webcc::dom::remove_element(_route_park);\n";
     }
 
     // Unregister signal listeners bound via listen { ... }
@@ -238,6 +274,12 @@ void emit_component_lifecycle_methods(std::stringstream &ss,
     // Used for member references inside if-statements that toggle visibility
     // skip_dom_removal: if true, only unregisters handlers (caller will bulk-clear DOM)
     ss << "    void _remove_view(bool skip_dom_removal = false) {\n";
+    if (g_update_scheduler)
+    {
+        // Drop queued updates: the view they would patch is going away
+        ss << "        __coi_sched::cancel(_sched_ticket, this);\n";
+        ss << "        _sched_live = false;\n";
+    }
 
     // Never rendered (e.g. a member component inside a region whose condition
     // was never true): nothing to remove, no handlers to unregister, and the
@@ -346,6 +388,7 @@ void emit_component_lifecycle_methods(std::stringstream &ss,
             ss << "        if (!skip_dom_removal) webcc::dom::remove_element(el[0]);\n";
         }
     }
+    emit_kept_if_cleanup();
     ss << "    }\n";
 
     // _get_root_element method - returns the root DOM element for this component
@@ -458,48 +501,53 @@ void emit_component_lifecycle_methods(std::stringstream &ss,
     if (needs_tick)
     {
         session.components_with_tick.insert(qualified_name(component.module_name, component.name));
-        ss << "    void tick(double dt) {\n";
-
-        if (has_user_tick)
-        {
-            if (user_tick_has_args)
-                ss << "        _user_tick(dt);\n";
-            else
-                ss << "        _user_tick();\n";
-        }
-
-        for (auto const &[comp_name, count] : component_members)
-        {
-            if (ticks(comp_name))
-            {
-                for (int i = 0; i < count; ++i)
-                {
-                    ss << "        " << comp_name << "_" << i << ".tick(dt);\n";
-                }
-            }
-        }
-
-        for (const auto *var : tickable_state_members)
-        {
-            if (var->type.ends_with("[]"))
-                ss << "        for (auto &_c : " << var->name << ") _c.tick(dt);\n";
-            else
-                ss << "        " << var->name << ".tick(dt);\n";
-        }
+    }
 
-        // Forward tick to the currently-mounted route page. Route pages are heap
-        // pointers, so guard on non-null (inactive routes are nullptr).
-        if (component.router)
+    // Ticking goes through the flat __coi_tick registry: only components with
+    // a tick block hold an entry, and update_wrapper runs the entries instead
+    // of walking the component tree. _tick_attach() (always generated, called
+    // from view() and when a component array stores an item) registers this
+    // component and the members that would not be mounted by a view of their
+    // own: view children inside closed <if> branches and logic-only members.
+    // Array items attach when stored; route pages attach in their view().
+    if (has_user_tick)
+    {
+        ss << "    __coi_tick::Slot _tick;\n";
+        ss << "    static void _tick_run(void* _self, double dt) { static_cast<"
+           << qualified_name(component.module_name, component.name) << "*>(_self)->_user_tick("
+           << (user_tick_has_args ? "dt" : "") << "); }\n";
+    }
+    ss << "    void _tick_attach() {\n";
+    if (has_user_tick)
+    {
+        ss << "        _tick.attach(this, &_tick_run);\n";
+    }
+    for (auto const &[comp_name, count] : component_members)
+    {
+        if (ticks(comp_name))
         {
-            for (size_t i = 0; i < component.router->routes.size(); ++i)
+            for (int i = 0; i < count; ++i)
             {
-                const auto &route = component.router->routes[i];
-                if (ticks(qualified_name(route.module_name, route.component_name)))
-                {
-                    ss << "        if (_route_" << i << ") _route_" << i << "->tick(dt);\n";
-                }
+                ss << "        " << comp_name << "_" << i << "._tick_attach();\n";
             }
         }
-        ss << "    }\n";
+    }
+    for (const auto *var : tickable_state_members)
+    {
+        if (!var->type.ends_with("[]"))
+            ss << "        " << var->name << "._tick_attach();\n";
+    }
+    ss << "    }\n";
+    // Built-in pauseTick()/resumeTick() hold and release this component's own
+    // tick block; members and array items keep ticking. No-ops without one.
+    if (has_user_tick)
+    {
+        ss << "    void pauseTick() { _tick.pause(); }\n";
+        ss << "    void resumeTick() { _tick.resume(); }\n";
+    }
+    else
+    {
+        ss << "    void pauseTick() {}\n";
+        ss << "    void resumeTick() {}\n";
     }
 }
@@ -40,11 +40,37 @@ void emit_component_router_methods(std::stringstream &ss, const Component &compo
     ss << "        _sync_route();\n";
     ss << "    }\n";
 
-    // _sync_route() method - destroys old component and creates the matching one
+    bool any_kept = false;
+    for (const auto &route : component.router->routes)
+    {
+        if (route.keep > 0)
+            any_kept = true;
+    }
+
+    // _sync_route() method - destroys old component and creates the matching one.
+    // A page of a 'keep' route is parked instead: its root moves into a detached
+    // element and the instance goes to the route's Keep pool under the path it was
+    // created for, so navigating back to that path reattaches it with its state.
     ss << "    void _sync_route() {\n";
-    // First destroy any existing route component
+    if (any_kept)
+    {
+        ss << "        if (!_route_park.is_valid()) {\n";
+        ss << "            _route_park = webcc::DOMElement(webcc::next_deferred_handle());\n";
+        ss << "            webcc::dom::create_element_deferred(_route_park, \"div\");\n";
+        ss << "        }\n";
+    }
+    // First destroy (or park) any existing route component
     for (size_t i = 0; i < component.router->routes.size(); ++i)
     {
+        if (component.router->routes[i].keep > 0)
+        {
+            ss << "        if (_route_" << i << ") {\n";
+            ss << "            webcc::dom::append_child(_route_park, _route_" << i << "->_get_root_element());\n";
+            ss << "            _route_" << i << "_keep.put(_route_" << i << ", _route_shown);\n";
+            ss << "            _route_" << i << " = nullptr;\n";
+            ss << "        }\n";
+            continue;
+        }
         ss << "        if (_route_" << i << ") { _route_" << i << "->_destroy(); delete _route_" << i << "; _route_" << i << " = nullptr; }\n";
     }
 
@@ -102,11 +128,23 @@ void emit_component_router_methods(std::stringstream &ss, const Component &compo
     // Emit creation, mounting, and early-return for a matched route.
     auto emit_route_mount = [&](size_t i, const RouteEntry &route, const std::string &indent)
     {
+        if (route.keep > 0)
+        {
+            ss << indent << "_route_shown = _current_route;\n";
+            ss << indent << "if ((_route_" << i << " = _route_" << i << "_keep.take(_current_route))) {\n";
+            ss << indent << "    webcc::dom::insert_before(_route_parent, _route_" << i << "->_get_root_element(), _route_anchor);\n";
+            ss << indent << "    _trim_routes();\n";
+            ss << indent << "    webcc::flush();\n";
+            ss << indent << "    return;\n";
+            ss << indent << "}\n";
+        }
         ss << indent << "_route_" << i << " = new " << qualified_name(route.module_name, route.component_name) << "{";
         emit_ctor_args(i, route);
         ss << "};\n";
         ss << indent << "_route_" << i << "->view(_route_parent);\n";
         ss << indent << "webcc::dom::insert_before(_route_parent, _route_" << i << "->_get_root_element(), _route_anchor);\n";
+        if (any_kept)
+            ss << indent << "_trim_routes();\n";
         ss << indent << "webcc::flush();\n";
         ss << indent << "return;\n";
     };
@@ -182,5 +220,20 @@ void emit_component_router_methods(std::stringstream &ss, const Component &compo
         }
     }
 
+    if (any_kept)
+        ss << "        _trim_routes();\n";
     ss << "    }\n";
+
+    // _trim_routes() - destroys the parked pages that exceed their route's cap,
+    // after the next page has been taken out of its pool
+    if (any_kept)
+    {
+        ss << "    void _trim_routes() {\n";
+        for (size_t i = 0; i < component.router->routes.size(); ++i)
+        {
+            if (component.router->routes[i].keep > 0)
+                ss << "        while (auto* _old = _route_" << i << "_keep.trim()) { _old->_destroy(); delete _old; }\n";
+        }
+        ss << "    }\n";
+    }
 }
@@ -138,10 +138,79 @@ static bool loop_region_uses_dispatcher(const LoopRegion &region,
            region.item_update_code.find(needle) != std::string::npos;
 }
 
+// Keyed HTML loops with a single root element are reconciled by key; the rest
+// fall back to rebuilding every item.
+static bool html_loop_reconciles(const LoopRegion &region)
+{
+    return region.is_keyed && region.is_html_loop && !region.root_element_var.empty() && region.html_patch.single_root;
+}
+
+// A copy of the rendered items tells which survivors changed. Not needed when the
+// item is its own key (a surviving key is an unchanged item) or when the item's
+// bindings read component state (every survivor is patched), and only possible
+// when the iterable is a plain member whose type can be named.
+static bool html_loop_keeps_shadow(const LoopRegion &region)
+{
+    if (region.key_expr == region.var_name || region.iterable_expr.empty() || region.html_patch.reads_state)
+        return false;
+    for (char c : region.iterable_expr)
+    {
+        if (!std::isalnum(static_cast<unsigned char>(c)) && c != '_')
+            return false;
+    }
+    return true;
+}
+
 // ============================================================================
 // Code Generation Helpers
 // ============================================================================
 
+// Dirty slots of the component's updaters (g_dirty_slots) and their hook into
+// __coi_sched. Only rendered components queue themselves: an unrendered one
+// renders its current state when view() runs.
+static void emit_dirty_scheduler(std::stringstream &ss, const std::string &struct_name)
+{
+    size_t words = std::max<size_t>(1, (g_dirty_slots.size() + 63) / 64);
+    ss << "    uint64_t _dirty[" << words << "] = {};\n";
+    ss << "    uint32_t _sched_ticket = 0;\n";
+    ss << "    bool _sched_live = false;\n";
+    ss << "    void _mark_dirty(int _slot) {\n";
+    ss << "        if (!_sched_live) return;\n";
+    ss << "        _dirty[_slot >> 6] |= 1ULL << (_slot & 63);\n";
+    ss << "        if (!__coi_sched::queued(_sched_ticket, this)) _sched_ticket = __coi_sched::enqueue(this, &_sched_run);\n";
+    ss << "    }\n";
+    ss << "    static void _sched_run(void* _self, uint32_t _ticket) {\n";
+    ss << "        auto* _c = static_cast<" << struct_name << "*>(_self);\n";
+    ss << "        if (_c->_sched_ticket == _ticket) _c->_flush_dirty();\n";
+    ss << "    }\n";
+    ss << "    void _flush_dirty() {\n";
+    ss << "        _sched_ticket = 0;\n";
+    ss << "        uint64_t _d[" << words << "];\n";
+    ss << "        for (int _i = 0; _i < " << words << "; _i++) { _d[_i] = _dirty[_i]; _dirty[_i] = 0; }\n";
+    for (size_t slot = 0; slot < g_dirty_slots.size(); slot++)
+    {
+        ss << "        if (_d[" << (slot >> 6) << "] & (1ULL << " << (slot & 63) << ")) " << g_dirty_slots[slot] << "\n";
+    }
+    ss << "    }\n";
+}
+
+// Release every item of a reconciled keyed HTML loop and forget what was rendered
+static void emit_html_loop_teardown(std::stringstream &ss, const LoopRegion &region)
+{
+    std::string prefix = "_loop_" + std::to_string(region.loop_id);
+    const LoopItemPatch &patch = region.html_patch;
+    std::string stride = std::to_string(patch.slots.size());
+    ss << "            for (int _i = 0; _i < (int)" << prefix << "_elements.size(); _i++) " << prefix << "_release(" << prefix << "_elements[_i], "
+       << (patch.slots.empty() ? "nullptr" : "&" + prefix + "_nodes[_i * " + stride + "]") << ");\n";
+    ss << "            " << prefix << "_elements.clear();\n";
+    if (!patch.slots.empty())
+        ss << "            " << prefix << "_nodes.clear();\n";
+    ss << "            " << prefix << "_keys.clear();\n";
+    if (html_loop_keeps_shadow(region))
+        ss << "            " << prefix << "_shadow.clear();\n";
+    ss << "            " << prefix << "_count = 0;\n";
+}
+
 static void emit_component_members(std::stringstream &ss, const std::map<std::string, int> &component_members)
 {
     for (const auto &[comp_name, count] : component_members)
@@ -157,7 +226,7 @@ static void emit_loop_vector_members(std::stringstream &ss, const std::set<std::
 {
     for (const auto &comp_name : loop_component_types)
     {
-        ss << "    coi::vector<" << comp_name << "> _loop_" << comp_name << "s;\n";
+        ss << "    __coi_stable::vector<" << comp_name << "> _loop_" << comp_name << "s;\n";
     }
 }
 
@@ -167,19 +236,36 @@ static void emit_loop_region_members(std::stringstream &ss, const std::vector<Lo
     {
         ss << "    webcc::handle _loop_" << region.loop_id << "_parent;\n";
         ss << "    webcc::handle _loop_" << region.loop_id << "_anchor;\n";
-        if (region.is_keyed)
-        {
-            // Simple count tracking - no map needed for inline sync
-            ss << "    int _loop_" << region.loop_id << "_count = 0;\n";
-        }
-        else
+        ss << "    int _loop_" << region.loop_id << "_count = 0;\n";
+        if (region.is_keyed && !region.item_mount_code.empty())
         {
-            ss << "    int _loop_" << region.loop_id << "_count = 0;\n";
+            // Keys of the rendered items, in DOM order (for keyed reconciliation)
+            ss << "    coi::vector<uint64_t> _loop_" << region.loop_id << "_keys;\n";
         }
         if (region.is_html_loop)
         {
             ss << "    coi::vector<webcc::handle> _loop_" << region.loop_id << "_elements;\n";
         }
+        if (html_loop_reconciles(region))
+        {
+            const LoopItemPatch &patch = region.html_patch;
+            ss << "    coi::vector<uint64_t> _loop_" << region.loop_id << "_keys;\n";
+            if (!patch.slots.empty())
+            {
+                // Patched element handles of each item, index-aligned with _elements
+                ss << "    coi::vector<webcc::handle> _loop_" << region.loop_id << "_nodes;\n";
+            }
+            if (html_loop_keeps_shadow(region))
+            {
+                // Items as last rendered, to patch only the survivors that changed
+                ss << "    __coi_keyed::plain_t<decltype(" << region.iterable_expr << ")> _loop_" << region.loop_id << "_shadow;\n";
+            }
+            if (!region.window_start_expr.empty())
+            {
+                // Iterable index of the first rendered item
+                ss << "    int _loop_" << region.loop_id << "_first = 0;\n";
+            }
+        }
     }
 }
 
@@ -190,6 +276,14 @@ static void emit_if_region_members(std::stringstream &ss, const std::vector<IfRe
         ss << "    webcc::handle _if_" << region.if_id << "_parent;\n";
         ss << "    webcc::handle _if_" << region.if_id << "_anchor;\n";
         ss << "    bool _if_" << region.if_id << "_state = false;\n";
+        if (region.keep)
+        {
+            // Detached element holding the hidden branch's nodes, and whether each
+            // branch has been created since the last view()
+            ss << "    webcc::handle _if_" << region.if_id << "_park;\n";
+            ss << "    bool _if_" << region.if_id << "_then_built = false;\n";
+            ss << "    bool _if_" << region.if_id << "_else_built = false;\n";
+        }
     }
 }
 
@@ -306,6 +400,9 @@ std::string Component::to_webcc(CompilerSession &session)
         ComponentTypeContext::instance().register_method_signature(m.name, m.return_type, param_types);
     }
 
+    // Updater slots are numbered per component
+    g_dirty_slots.clear();
+
     // Populate global context for reference params
     g_ref_props.clear();
     for (auto &param : params)
@@ -400,8 +497,9 @@ std::string Component::to_webcc(CompilerSession &session)
             info.loop_id = region.loop_id;
             info.component_type = region.component_type;
             info.parent_var = "_loop_" + std::to_string(region.loop_id) + "_parent";
+            info.anchor_var = "_loop_" + std::to_string(region.loop_id) + "_anchor";
             info.var_name = region.var_name;
-            info.item_creation_code = region.item_creation_code;
+            info.item_creation_code = transform_to_insert_before(region.item_creation_code, info.parent_var, info.anchor_var);
             info.is_member_ref_loop = true;
             info.is_only_child = region.is_only_child;
             g_component_array_loops[region.iterable_expr] = info;
@@ -417,13 +515,6 @@ std::string Component::to_webcc(CompilerSession &session)
         {
             ArrayLoopInfo info;
             info.loop_id = region.loop_id;
-            info.parent_var = "_loop_" + std::to_string(region.loop_id) + "_parent";
-            info.anchor_var = "_loop_" + std::to_string(region.loop_id) + "_anchor";
-            info.elements_vec_name = "_loop_" + std::to_string(region.loop_id) + "_elements";
-            info.var_name = region.var_name;
-            info.item_creation_code = transform_to_insert_before(region.item_creation_code, info.parent_var, info.anchor_var);
-            info.root_element_var = region.root_element_var;
-            info.is_only_child = region.is_only_child;
             g_array_loops[region.iterable_expr] = info;
 
             HtmlLoopVarInfo var_info;
@@ -478,7 +569,7 @@ std::string Component::to_webcc(CompilerSession &session)
                 // coi::vector<string> because the child doesn't know what size array it will
                 // receive. Using coi::array<T, N> here would cause a type mismatch.
           
-                std::string vec_type = "coi::vector<" + convert_type(resolve_component_type(elem_type)) + ">";
+                std::string vec_type = dynamic_array_type(convert_type(resolve_component_type(elem_type)));
                 ss << "    " << (var->is_mutable ? "" : "const ") << vec_type;
                 if (var->is_reference)
                     ss << "&";
@@ -584,17 +675,9 @@ std::string Component::to_webcc(CompilerSession &session)
 
         callback_type = "coi::function<void(" + param_types + ")>";
 
-        ss << "    int _next_listener_id_" << signal.name << " = 1;\n";
-        ss << "    coi::vector<int> _listener_ids_" << signal.name << ";\n";
-        ss << "    coi::vector<" << callback_type << "> _listeners_" << signal.name << ";\n";
-        ss << "    int _listener_dispatch_depth_" << signal.name << " = 0;\n";
-        ss << "    bool _listener_needs_compact_" << signal.name << " = false;\n";
-
+        ss << "    __coi_signal::Listeners<" << callback_type << "> _listeners_" << signal.name << ";\n";
         ss << "    int _add_listener_" << signal.name << "(" << callback_type << " cb) {\n";
-        ss << "        int id = _next_listener_id_" << signal.name << "++;\n";
-        ss << "        _listener_ids_" << signal.name << ".push_back(id);\n";
-        ss << "        _listeners_" << signal.name << ".push_back(cb);\n";
-        ss << "        return id;\n";
+        ss << "        return _listeners_" << signal.name << ".add(coi::move(cb));\n";
         ss << "    }\n";
 
         // Zero-arg listener adapter (ignore all signal payload fields).
@@ -642,38 +725,11 @@ std::string Component::to_webcc(CompilerSession &session)
         }
 
         ss << "    void _remove_listener_" << signal.name << "(int id) {\n";
-        ss << "        for (int i = 0; i < (int)_listener_ids_" << signal.name << ".size(); ++i) {\n";
-        ss << "            if (_listener_ids_" << signal.name << "[i] == id) {\n";
-        ss << "                if (_listener_dispatch_depth_" << signal.name << " > 0) {\n";
-        ss << "                    _listener_ids_" << signal.name << "[i] = 0;\n";
-        ss << "                    _listeners_" << signal.name << "[i] = nullptr;\n";
-        ss << "                    _listener_needs_compact_" << signal.name << " = true;\n";
-        ss << "                } else {\n";
-        ss << "                    _listener_ids_" << signal.name << ".remove(i);\n";
-        ss << "                    _listeners_" << signal.name << ".remove(i);\n";
-        ss << "                }\n";
-        ss << "                return;\n";
-        ss << "            }\n";
-        ss << "        }\n";
+        ss << "        _listeners_" << signal.name << ".remove(id);\n";
         ss << "    }\n";
 
         ss << "    void _emit_" << signal.name << "(" << param_decl << ") {\n";
-        ss << "        _listener_dispatch_depth_" << signal.name << "++;\n";
-        ss << "        int _emit_count = (int)_listeners_" << signal.name << ".size();\n";
-        ss << "        for (int i = 0; i < _emit_count; ++i) {\n";
-        ss << "            auto cb = _listeners_" << signal.name << "[i];\n";
-        ss << "            if(cb) cb(" << arg_list << ");\n";
-        ss << "        }\n";
-        ss << "        _listener_dispatch_depth_" << signal.name << "--;\n";
-        ss << "        if (_listener_dispatch_depth_" << signal.name << " == 0 && _listener_needs_compact_" << signal.name << ") {\n";
-        ss << "            for (int i = (int)_listener_ids_" << signal.name << ".size() - 1; i >= 0; --i) {\n";
-        ss << "                if (_listener_ids_" << signal.name << "[i] == 0) {\n";
-        ss << "                    _listener_ids_" << signal.name << ".remove(i);\n";
-        ss << "                    _listeners_" << signal.name << ".remove(i);\n";
-        ss << "                }\n";
-        ss << "            }\n";
-        ss << "            _listener_needs_compact_" << signal.name << " = false;\n";
-        ss << "        }\n";
+        ss << "        _listeners_" << signal.name << ".emit(" << arg_list << ");\n";
         ss << "    }\n";
     }
 
@@ -712,6 +768,23 @@ std::string Component::to_webcc(CompilerSession &session)
             const auto& route = router->routes[i];
             ss << "    " << qualified_name(route.module_name, route.component_name) << "* _route_" << i << " = nullptr;\n";
         }
+        // Parked pages of 'keep' routes, the detached element holding their nodes,
+        // and the path the shown page was created for
+        bool any_kept = false;
+        for (size_t i = 0; i < router->routes.size(); ++i)
+        {
+            const auto &route = router->routes[i];
+            if (route.keep == 0)
+                continue;
+            any_kept = true;
+            ss << "    __coi_route::Keep<" << qualified_name(route.module_name, route.component_name) << ", " << route.keep
+               << "> _route_" << i << "_keep;\n";
+        }
+        if (any_kept)
+        {
+            ss << "    webcc::handle _route_park;\n";
+            ss << "    coi::string _route_shown;\n";
+        }
     }
 
     // Listener registration tokens for listen { ... } bindings
@@ -753,11 +826,18 @@ std::string Component::to_webcc(CompilerSession &session)
         std::string update_code;
         std::set<std::string> dependencies;
         std::set<MemberDependency> member_dependencies;
+        std::map<std::string, std::set<std::string>> field_dependencies;
+        std::set<std::string> whole_dependencies;
         std::string method_name;
     };
 
     std::map<ElementAttrKey, ElementAttrBinding> element_attr_bindings;
 
+    // Cached bindings (app { memo = [...]; }) skip the DOM call when the
+    // element already shows the formatted value; each gets a __coi_memo::Slot
+    bool memo = g_memo_components.count(qualified_name(module_name, name)) > 0;
+    int memo_slots = 0;
+
     // Collect bindings grouped by element+attribute
     for (const auto &binding : bindings)
     {
@@ -794,12 +874,21 @@ std::string Component::to_webcc(CompilerSession &session)
             dom_call = "webcc::dom::set_inner_text(" + el_var + ", ";
         }
 
+        // Formatted writes of a cached binding go through its slot. Properties stay
+        // uncached: the user edits them without the binding knowing.
+        auto formatted_call = [&]()
+        {
+            if (!memo || dom_call.rfind("webcc::dom::set_property(", 0) == 0)
+                return dom_call;
+            return "if (!_memo[" + std::to_string(memo_slots++) + "].same(" + el_var + ", _fmt.c_str())) " + dom_call;
+        };
+
         bool optimized = false;
         if (binding.expr)
         {
             if (auto strLit = dynamic_cast<StringLiteral *>(binding.expr))
             {
-                update_line = generate_formatter_block_from_string_literal(strLit, dom_call);
+                update_line = generate_formatter_block_from_string_literal(strLit, formatted_call());
                 optimized = true;
             }
         }
@@ -811,7 +900,7 @@ std::string Component::to_webcc(CompilerSession &session)
                 args_str.pop_back();
 
             std::vector<std::string> args = parse_concat_args(args_str);
-            update_line = generate_formatter_block(args, dom_call);
+            update_line = generate_formatter_block(args, formatted_call());
             optimized = true;
         }
 
@@ -824,7 +913,7 @@ std::string Component::to_webcc(CompilerSession &session)
             }
             else
             {
-                update_line = generate_formatter_block({binding.value_code}, dom_call);
+                update_line = generate_formatter_block({binding.value_code}, formatted_call());
             }
         }
 
@@ -839,8 +928,30 @@ std::string Component::to_webcc(CompilerSession &session)
             {
                 element_attr_bindings[key].member_dependencies.insert(mem_dep);
             }
+            for (const auto &[var, fields] : binding.field_dependencies)
+            {
+                element_attr_bindings[key].field_dependencies[var].insert(fields.begin(), fields.end());
+            }
+            for (const auto &var : binding.whole_dependencies)
+            {
+                element_attr_bindings[key].whole_dependencies.insert(var);
+            }
+        }
+    }
+
+    // Private state read through fields (pos.x) gets one updater per field, so a
+    // method writing only pos.x skips the bindings of pos.y. Pub mut state keeps
+    // the single _update_<var>() that also notifies the parent.
+    std::set<std::string> field_split_vars;
+    for (auto &var : state)
+    {
+        if (!pub_mut_vars.count(var->name))
+        {
+            field_split_vars.insert(var->name);
         }
     }
+    std::map<std::string, std::map<std::string, std::vector<UpdateEntry>>> field_update_entries;
+    std::map<std::string, std::vector<std::string>> whole_read_updates;  // Run on any write of the var
 
     // Generate shared element+attribute update methods
     int shared_update_counter = 0;
@@ -870,6 +981,21 @@ std::string Component::to_webcc(CompilerSession &session)
             entry.if_region_id = key.if_region_id;
             entry.in_then_branch = key.in_then_branch;
             var_update_entries[dep].push_back(entry);
+
+            if (!field_split_vars.count(dep))
+                continue;
+            auto fields = binding.field_dependencies.find(dep);
+            if (fields != binding.field_dependencies.end() && !binding.whole_dependencies.count(dep))
+            {
+                for (const auto &field : fields->second)
+                {
+                    field_update_entries[dep][field].push_back(entry);
+                }
+            }
+            else
+            {
+                whole_read_updates[dep].push_back(entry.code);
+            }
         }
     }
 
@@ -910,83 +1036,88 @@ std::string Component::to_webcc(CompilerSession &session)
 
     }
 
-    // Generate _update_{varname}() methods
-    std::set<std::string> generated_updaters;
-    for (const auto &[var_name, entries] : var_update_entries)
+    // Body of an updater: binding calls outside if regions, then the ones of each
+    // if region under its branch check
+    auto emit_update_entries = [&](const std::vector<UpdateEntry> &entries)
     {
-        if (!entries.empty())
+        // Deduplicate entries outside if regions
+        std::set<std::string> non_if_calls;
+        for (const auto &entry : entries)
         {
-            ss << "    void _update_" << var_name << "() {\n";
-
-            // Deduplicate entries outside if regions
-            std::set<std::string> non_if_calls;
-            for (const auto &entry : entries)
+            if (entry.if_region_id < 0)
             {
-                if (entry.if_region_id < 0)
-                {
-                    non_if_calls.insert(entry.code);
-                }
-            }
-            for (const auto &code : non_if_calls)
-            {
-                ss << "        " << code << "\n";
+                non_if_calls.insert(entry.code);
             }
+        }
+        for (const auto &code : non_if_calls)
+        {
+            ss << "        " << code << "\n";
+        }
 
-            std::map<int, std::pair<std::set<std::string>, std::set<std::string>>> if_grouped;
-            for (const auto &entry : entries)
+        std::map<int, std::pair<std::set<std::string>, std::set<std::string>>> if_grouped;
+        for (const auto &entry : entries)
+        {
+            if (entry.if_region_id >= 0)
             {
-                if (entry.if_region_id >= 0)
+                if (entry.in_then_branch)
                 {
-                    if (entry.in_then_branch)
-                    {
-                        if_grouped[entry.if_region_id].first.insert(entry.code);
-                    }
-                    else
-                    {
-                        if_grouped[entry.if_region_id].second.insert(entry.code);
-                    }
+                    if_grouped[entry.if_region_id].first.insert(entry.code);
+                }
+                else
+                {
+                    if_grouped[entry.if_region_id].second.insert(entry.code);
                 }
             }
+        }
 
-            for (const auto &[if_id, branches] : if_grouped)
-            {
-                const auto &then_codes = branches.first;
-                const auto &else_codes = branches.second;
+        for (const auto &[if_id, branches] : if_grouped)
+        {
+            const auto &then_codes = branches.first;
+            const auto &else_codes = branches.second;
 
-                if (!then_codes.empty() && !else_codes.empty())
+            if (!then_codes.empty() && !else_codes.empty())
+            {
+                ss << "        if (_if_" << if_id << "_state) {\n";
+                for (const auto &code : then_codes)
                 {
-                    ss << "        if (_if_" << if_id << "_state) {\n";
-                    for (const auto &code : then_codes)
-                    {
-                        ss << "            " << code << "\n";
-                    }
-                    ss << "        } else {\n";
-                    for (const auto &code : else_codes)
-                    {
-                        ss << "            " << code << "\n";
-                    }
-                    ss << "        }\n";
+                    ss << "            " << code << "\n";
                 }
-                else if (!then_codes.empty())
+                ss << "        } else {\n";
+                for (const auto &code : else_codes)
                 {
-                    ss << "        if (_if_" << if_id << "_state) {\n";
-                    for (const auto &code : then_codes)
-                    {
-                        ss << "            " << code << "\n";
-                    }
-                    ss << "        }\n";
+                    ss << "            " << code << "\n";
                 }
-                else if (!else_codes.empty())
+                ss << "        }\n";
+            }
+            else if (!then_codes.empty())
+            {
+                ss << "        if (_if_" << if_id << "_state) {\n";
+                for (const auto &code : then_codes)
                 {
-                    ss << "        if (!_if_" << if_id << "_state) {\n";
-                    for (const auto &code : else_codes)
-                    {
-                        ss << "            " << code << "\n";
-                    }
-                    ss << "        }\n";
+                    ss << "            " << code << "\n";
                 }
+                ss << "        }\n";
+            }
+            else if (!else_codes.empty())
+            {
+                ss << "        if (!_if_" << if_id << "_state) {\n";
+                for (const auto &code : else_codes)
+                {
+                    ss << "            " << code << "\n";
+                }
+                ss << "        }\n";
             }
+        }
+    };
 
+    // Generate _update_{varname}() methods
+    std::set<std::string> generated_updaters;
+    for (const auto &[var_name, entries] : var_update_entries)
+    {
+        if (!entries.empty())
+        {
+            ss << "    void _update_" << var_name << "() {\n";
+            emit_update_entries(entries);
             // Call callback for pub mut state vars
             if (pub_mut_vars.count(var_name))
             {
@@ -1004,6 +1135,20 @@ std::string Component::to_webcc(CompilerSession &session)
         }
     }
 
+    // Generate _update_{varname}__{field}() methods for bindings read through fields
+    std::map<std::string, std::map<std::string, std::string>> field_updaters;
+    for (const auto &[var_name, per_field] : field_update_entries)
+    {
+        for (const auto &[field, entries] : per_field)
+        {
+            std::string method_name = "_update_" + var_name + "__" + field;
+            ss << "    void " << method_name << "() {\n";
+            emit_update_entries(entries);
+            ss << "    }\n";
+            field_updaters[var_name][field] = method_name + "();";
+        }
+    }
+
     // Generate _update methods for pub mut variables without UI bindings
     for (const auto &var_name : pub_mut_vars)
     {
@@ -1064,7 +1209,142 @@ std::string Component::to_webcc(CompilerSession &session)
             std::string count_var = "_loop_" + std::to_string(region.loop_id) + "_count";
             std::string parent_var = "_loop_" + std::to_string(region.loop_id) + "_parent";
 
-            if (region.is_html_loop)
+            if (html_loop_reconciles(region))
+            {
+                // Keyed HTML element loop: reconcile by key. Survivors keep their
+                // elements, are patched only when their item changed and are moved
+                // only when off the longest increasing run.
+                std::string id = std::to_string(region.loop_id);
+                std::string prefix = "_loop_" + id;
+                const LoopItemPatch &patch = region.html_patch;
+                std::string stride = std::to_string(patch.slots.size());
+                bool shadow = html_loop_keeps_shadow(region);
+                // A windowed loop renders items [_w0, _w1) only. When its items can be
+                // patched, the elements of items leaving the window are handed to the
+                // ones entering it instead of being removed and created again.
+                bool windowed = !region.window_start_expr.empty();
+                bool recycle = windowed && patch.patchable;
+                std::string at = windowed ? "_w0 + _j" : "_j";
+
+                ss << "        coi::vector<uint64_t> _nk;\n";
+                if (windowed)
+                {
+                    ss << "        int _w0, _w1;\n";
+                    ss << "        __coi_keyed::window(" << region.window_start_expr << ", " << region.window_end_expr << ", (int)" << region.iterable_expr << ".size(), _w0, _w1);\n";
+                    ss << "        _nk.reserve(_w1 - _w0);\n";
+                    ss << "        for (int _i = _w0; _i < _w1; _i++) { auto& " << region.var_name << " = " << region.iterable_expr << "[_i]; _nk.push_back(__coi_keyed::key(" << region.key_expr << ")); }\n";
+                }
+                else
+                {
+                    ss << "        _nk.reserve(" << region.iterable_expr << ".size());\n";
+                    ss << "        for (auto& " << region.var_name << " : " << region.iterable_expr << ") _nk.push_back(__coi_keyed::key(" << region.key_expr << "));\n";
+                }
+                ss << "        coi::vector<int> _src;\n";
+                ss << "        coi::vector<uint8_t> _stay, _used;\n";
+                ss << "        __coi_keyed::diff(" << prefix << "_keys, _nk, _src, _stay, _used);\n";
+                std::string old_slots = patch.slots.empty() ? "nullptr" : "&" + prefix + "_nodes[_i * " + stride + "]";
+                if (recycle)
+                {
+                    ss << "        coi::vector<int> _free;\n";
+                    ss << "        for (int _i = (int)" << prefix << "_keys.size() - 1; _i >= 0; _i--) {\n";
+                    ss << "            if (!_used[_i]) _free.push_back(_i);\n";
+                    ss << "        }\n";
+                }
+                else
+                {
+                    ss << "        for (int _i = 0; _i < (int)" << prefix << "_keys.size(); _i++) {\n";
+                    ss << "            if (!_used[_i]) " << prefix << "_release(" << prefix << "_elements[_i], " << old_slots << ");\n";
+                    ss << "        }\n";
+                }
+                ss << "        int _new_count = (int)_nk.size();\n";
+                ss << "        coi::vector<webcc::handle> _els;\n";
+                ss << "        _els.reserve(_new_count);\n";
+                if (!patch.slots.empty())
+                {
+                    ss << "        coi::vector<webcc::handle> _nodes;\n";
+                    ss << "        _nodes.reserve(_new_count * " << stride << ");\n";
+                }
+                if (recycle)
+                {
+                    ss << "        coi::vector<uint8_t> _recycled;\n";
+                    ss << "        _recycled.reserve(_new_count);\n";
+                }
+                ss << "        for (int _j = 0; _j < _new_count; _j++) {\n";
+                if (recycle)
+                {
+                    ss << "            _recycled.push_back(0);\n";
+                    ss << "            if (_src[_j] < 0 && !_free.empty()) { _src[_j] = _free[_free.size() - 1]; _free.pop_back(); _recycled[_j] = 1; }\n";
+                }
+                ss << "            int _s = _src[_j];\n";
+                ss << "            _els.push_back(_s >= 0 ? " << prefix << "_elements[_s] : webcc::handle());\n";
+                if (!patch.slots.empty())
+                {
+                    ss << "            for (int _k = 0; _k < " << stride << "; _k++) _nodes.push_back(_s >= 0 ? " << prefix << "_nodes[_s * " << stride << " + _k] : webcc::handle());\n";
+                }
+                ss << "        }\n";
+                if (recycle)
+                {
+                    // More items left the window than entered it
+                    ss << "        for (int _f = 0; _f < (int)_free.size(); _f++) {\n";
+                    ss << "            int _i = _free[_f];\n";
+                    ss << "            " << prefix << "_release(" << prefix << "_elements[_i], " << old_slots << ");\n";
+                    ss << "        }\n";
+                }
+                ss << "        \n";
+                // Walk back to front so each item is placed right before its successor
+                std::string slots_arg = patch.slots.empty() ? "nullptr" : "&_nodes[_j * " + stride + "]";
+                ss << "        g_view_depth++;\n";
+                ss << "        webcc::handle _ref = " << prefix << "_anchor;\n";
+                ss << "        for (int _j = _new_count - 1; _j >= 0; _j--) {\n";
+                ss << "            if (_src[_j] < 0) {\n";
+                ss << "                _els[_j] = " << prefix << "_create(" << at << ", _ref, " << slots_arg << ");\n";
+                ss << "            } else {\n";
+                std::string changed;
+                if (region.key_expr == region.var_name && !patch.reads_state)
+                    changed = "";  // Same key, same item
+                else if (shadow)
+                    changed = "!__coi_keyed::same(" + prefix + "_shadow[_src[_j]], " + region.iterable_expr + "[" + at + "])";
+                else
+                    changed = "true";
+                if (recycle)
+                    changed = changed.empty() ? "_recycled[_j]" : "_recycled[_j] || " + changed;
+                std::string move_stmt = "webcc::dom::insert_before(" + parent_var + ", _els[_j], _ref);";
+                if (changed.empty())
+                {
+                    ss << "                if (!_stay[_j]) " << move_stmt << "\n";
+                }
+                else if (patch.patchable)
+                {
+                    ss << "                if (" << changed << ") " << prefix << "_patch(" << at << ", " << slots_arg << ");\n";
+                    ss << "                if (!_stay[_j]) " << move_stmt << "\n";
+                }
+                else
+                {
+                    ss << "                if (" << changed << ") {\n";
+                    ss << "                    " << prefix << "_release(_els[_j], " << slots_arg << ");\n";
+                    ss << "                    _els[_j] = " << prefix << "_create(" << at << ", _ref, " << slots_arg << ");\n";
+                    ss << "                } else if (!_stay[_j]) " << move_stmt << "\n";
+                }
+                ss << "            }\n";
+                ss << "            _ref = _els[_j];\n";
+                ss << "        }\n";
+                ss << "        if (--g_view_depth == 0) webcc::flush();\n";
+                ss << "        " << prefix << "_elements = coi::move(_els);\n";
+                if (!patch.slots.empty())
+                    ss << "        " << prefix << "_nodes = coi::move(_nodes);\n";
+                ss << "        " << prefix << "_keys = coi::move(_nk);\n";
+                if (shadow && windowed)
+                {
+                    ss << "        " << prefix << "_shadow.clear();\n";
+                    ss << "        for (int _i = _w0; _i < _w1; _i++) " << prefix << "_shadow.push_back(" << region.iterable_expr << "[_i]);\n";
+                }
+                else if (shadow)
+                    ss << "        " << prefix << "_shadow = " << region.iterable_expr << ";\n";
+                if (windowed)
+                    ss << "        " << prefix << "_first = _w0;\n";
+                ss << "        " << count_var << " = _new_count;\n";
+            }
+            else if (region.is_html_loop)
             {
                 // Keyed HTML element loop (e.g., <for msg in messages key={msg}><div>{msg}</div></for>)
                 std::string elements_vec = "_loop_" + std::to_string(region.loop_id) + "_elements";
@@ -1091,6 +1371,65 @@ std::string Component::to_webcc(CompilerSession &session)
                 ss << "        if (--g_view_depth == 0) webcc::flush();\n";
                 ss << "        " << count_var << " = _new_count;\n";
             }
+            else if (!region.item_mount_code.empty())
+            {
+                // Keyed component loop with owned instances: reconcile by key. Survivors
+                // are patched in place and only moved when off the longest increasing
+                // run; only added/removed keys are mounted/destroyed.
+                std::string vec_name = "_loop_" + region.component_type + "s";
+                std::string keys_vec = "_loop_" + std::to_string(region.loop_id) + "_keys";
+                std::string anchor_var = "_loop_" + std::to_string(region.loop_id) + "_anchor";
+                bool windowed = !region.window_start_expr.empty();
+
+                ss << "        coi::vector<uint64_t> _nk;\n";
+                if (windowed)
+                {
+                    // Only items [_w0, _w1) have an instance; _loop_X[_j] renders item _w0 + _j
+                    ss << "        int _w0, _w1;\n";
+                    ss << "        __coi_keyed::window(" << region.window_start_expr << ", " << region.window_end_expr << ", (int)" << region.iterable_expr << ".size(), _w0, _w1);\n";
+                    ss << "        _nk.reserve(_w1 - _w0);\n";
+                    ss << "        for (int _i = _w0; _i < _w1; _i++) { auto& " << region.var_name << " = " << region.iterable_expr << "[_i]; _nk.push_back(__coi_keyed::key(" << region.key_expr << ")); }\n";
+                }
+                else
+                {
+                    ss << "        _nk.reserve(" << region.iterable_expr << ".size());\n";
+                    ss << "        for (auto& " << region.var_name << " : " << region.iterable_expr << ") _nk.push_back(__coi_keyed::key(" << region.key_expr << "));\n";
+                }
+                ss << "        coi::vector<int> _src;\n";
+                ss << "        coi::vector<uint8_t> _stay, _used;\n";
+                ss << "        __coi_keyed::diff(" << keys_vec << ", _nk, _src, _stay, _used);\n";
+                ss << "        for (int _i = 0; _i < (int)" << keys_vec << ".size(); _i++) {\n";
+                ss << "            if (!_used[_i]) " << vec_name << "[_i]._destroy();\n";
+                ss << "        }\n";
+                ss << "        int _new_count = (int)_nk.size();\n";
+                ss << "        decltype(" << vec_name << ") _next;\n";
+                ss << "        _next.reserve(_new_count);\n";
+                ss << "        for (int _j = 0; _j < _new_count; _j++) {\n";
+                ss << "            if (_src[_j] >= 0) _next.push_back(coi::move(" << vec_name << "[_src[_j]]));\n";
+                ss << "            else _next.push_back(" << region.component_type << "());\n";
+                ss << "        }\n";
+                ss << "        " << vec_name << " = coi::move(_next);\n";
+                ss << "        \n";
+                // Walk back to front so each item is placed right before its successor
+                ss << "        g_view_depth++;\n";
+                ss << "        webcc::handle _ref = " << anchor_var << ";\n";
+                ss << "        for (int _j = _new_count - 1; _j >= 0; _j--) {\n";
+                ss << "            auto& " << region.var_name << " = " << region.iterable_expr << "[" << (windowed ? "_w0 + _j" : "_j") << "];\n";
+                ss << "            auto& _inst = " << vec_name << "[_j];\n";
+                ss << "            if (_src[_j] < 0) {\n";
+                ss << indent_code(transform_to_insert_before(region.item_mount_code, parent_var, "_ref"), "        ");
+                ss << "            } else {\n";
+                ss << indent_code(region.item_patch_code, "    ");
+                // Survivors were moved into a new vector: re-point their handlers
+                ss << "                _inst._rebind();\n";
+                ss << "                if (!_stay[_j]) webcc::dom::insert_before(" << parent_var << ", _inst._get_root_element(), _ref);\n";
+                ss << "            }\n";
+                ss << "            _ref = _inst._get_root_element();\n";
+                ss << "        }\n";
+                ss << "        if (--g_view_depth == 0) webcc::flush();\n";
+                ss << "        " << keys_vec << " = coi::move(_nk);\n";
+                ss << "        " << count_var << " = _new_count;\n";
+            }
             else
             {
                 // Keyed component loop
@@ -1140,8 +1479,6 @@ std::string Component::to_webcc(CompilerSession &session)
                 ss << indent_code(item_code, "    ");
                 ss << "            }\n";
 
-                ss << "            for (int _i = 0; _i < old_count; _i++) " << vec_name << "[_i]._rebind();\n";
-
                 ss << "        } else {\n";
                 ss << "            while ((int)" << vec_name << ".size() > new_count) {\n";
                 ss << "                " << vec_name << "[" << vec_name << ".size() - 1]._destroy();\n";
@@ -1185,10 +1522,199 @@ std::string Component::to_webcc(CompilerSession &session)
         ss << "    }\n";
     }
 
-    // Generate _sync_loop_X_item() methods for keyed HTML loops (single-item patch)
+    // Generate _reconcile_loop_X() for keyed loops over component arrays (<{item}/>).
+    // Reassigning the array lands here: items whose key and view carry over (copies
+    // of a rendered item) are kept and moved, the rest are removed or mounted.
+    for (const auto &region : loop_regions)
+    {
+        if (!(region.is_keyed && region.is_member_ref_loop))
+            continue;
+
+        std::string arr = region.iterable_expr;
+        std::string var = region.var_name;
+        std::string parent_var = "_loop_" + std::to_string(region.loop_id) + "_parent";
+        std::string anchor_var = "_loop_" + std::to_string(region.loop_id) + "_anchor";
+        std::string count_var = "_loop_" + std::to_string(region.loop_id) + "_count";
+
+        ss << "    void _reconcile_loop_" << region.loop_id << "(decltype(" << arr << ")& _next) {\n";
+        ss << "        if (!" << parent_var << ".is_valid()) { " << arr << " = coi::move(_next); return; }\n";
+        ss << "        coi::vector<uint64_t> _ok, _nk;\n";
+        ss << "        _ok.reserve(" << arr << ".size());\n";
+        ss << "        _nk.reserve(_next.size());\n";
+        ss << "        for (auto& " << var << " : " << arr << ") _ok.push_back(__coi_keyed::key(" << region.key_expr << "));\n";
+        ss << "        for (auto& " << var << " : _next) _nk.push_back(__coi_keyed::key(" << region.key_expr << "));\n";
+        ss << "        coi::vector<int> _src;\n";
+        ss << "        coi::vector<uint8_t> _stay, _used;\n";
+        ss << "        __coi_keyed::diff(_ok, _nk, _src, _stay, _used);\n";
+        // A fresh instance with a reused key has no view of its own yet
+        ss << "        for (int _j = 0; _j < (int)_next.size(); _j++) {\n";
+        ss << "            if (_src[_j] < 0) continue;\n";
+        ss << "            webcc::handle _root = " << arr << "[_src[_j]]._get_root_element();\n";
+        ss << "            if (_root.is_valid() && (int32_t)_next[_j]._get_root_element() == (int32_t)_root) continue;\n";
+        ss << "            _used[_src[_j]] = 0;\n";
+        ss << "            _src[_j] = -1;\n";
+        ss << "            _stay[_j] = 0;\n";
+        ss << "        }\n";
+        if (region.is_only_child)
+        {
+            // Bulk optimization when nothing survives: unregister handlers only, then
+            // clear parent's innerHTML and put the anchor back
+            ss << "        bool _any_kept = false;\n";
+            ss << "        for (int _i = 0; _i < (int)_used.size(); _i++) _any_kept = _any_kept || _used[_i];\n";
+            ss << "        if (!_any_kept && " << count_var << " > 0) {\n";
+            ss << "            for (auto& " << var << " : " << arr << ") " << var << "._remove_view(true);\n";
+            ss << "            webcc::dom::set_inner_html(" << parent_var << ", \"\");\n";
+            ss << "            webcc::dom::append_child(" << parent_var << ", " << anchor_var << ");\n";
+            ss << "        } else {\n";
+            ss << "            for (int _i = 0; _i < (int)_used.size(); _i++) if (!_used[_i]) " << arr << "[_i]._remove_view();\n";
+            ss << "        }\n";
+        }
+        else
+        {
+            ss << "        for (int _i = 0; _i < (int)_used.size(); _i++) if (!_used[_i]) " << arr << "[_i]._remove_view();\n";
+        }
+        ss << "        " << arr << " = coi::move(_next);\n";
+        ss << "        \n";
+        ss << "        g_view_depth++;\n";
+        ss << "        webcc::handle _ref = " << anchor_var << ";\n";
+        ss << "        for (int _j = (int)" << arr << ".size() - 1; _j >= 0; _j--) {\n";
+        ss << "            auto& " << var << " = " << arr << "[_j];\n";
+        ss << "            if (_src[_j] < 0) {\n";
+        ss << indent_code(transform_to_insert_before(region.item_creation_code, parent_var, "_ref"), "");
+        ss << "            } else {\n";
+        // Survivors were copied into a new vector: re-point their handlers
+        ss << "                " << var << "._rebind();\n";
+        ss << "                if (!_stay[_j]) webcc::dom::insert_before(" << parent_var << ", " << var << "._get_root_element(), _ref);\n";
+        ss << "            }\n";
+        ss << "            _ref = " << var << "._get_root_element();\n";
+        ss << "        }\n";
+        ss << "        if (--g_view_depth == 0) webcc::flush();\n";
+        ss << "        " << count_var << " = (int)" << arr << ".size();\n";
+        ss << "    }\n";
+    }
+
+    // Generate per-item helpers for reconciled keyed HTML loops:
+    //   _loop_X_create()  - build an item before `_ref`, recording its slot handles
+    //   _loop_X_patch()   - re-apply a surviving item's dynamic parts to its slots
+    //   _loop_X_release() - unregister an item's handlers and remove its element
+    //   _sync_loop_X_item() - patch one item in place, or append the next one
+    for (const auto &region : loop_regions)
+    {
+        if (!html_loop_reconciles(region))
+            continue;
+
+        std::string prefix = "_loop_" + std::to_string(region.loop_id);
+        std::string parent_var = prefix + "_parent";
+        std::string anchor_var = prefix + "_anchor";
+        const LoopItemPatch &patch = region.html_patch;
+        std::string stride = std::to_string(patch.slots.size());
+        bool shadow = html_loop_keeps_shadow(region);
+
+        ss << "    webcc::handle " << prefix << "_create(int _idx, webcc::handle _ref, webcc::handle* _slots) {\n";
+        ss << "        auto& " << region.var_name << " = " << region.iterable_expr << "[_idx];\n";
+        ss << indent_code(transform_to_insert_before(region.item_creation_code, parent_var, "_ref"), "");
+        for (size_t k = 0; k < patch.slots.size(); k++)
+        {
+            ss << "        _slots[" << k << "] = " << patch.slots[k] << ";\n";
+        }
+        ss << "        return " << region.root_element_var << ";\n";
+        ss << "    }\n";
+
+        if (patch.patchable)
+        {
+            ss << "    void " << prefix << "_patch(int _idx, webcc::handle* _slots) {\n";
+            ss << "        auto& " << region.var_name << " = " << region.iterable_expr << "[_idx];\n";
+            for (size_t k = 0; k < patch.slots.size(); k++)
+            {
+                ss << "        webcc::handle " << patch.slots[k] << " = _slots[" << k << "];\n";
+            }
+            ss << indent_code(patch.code, "        ");
+            ss << "    }\n";
+        }
+
+        ss << "    void " << prefix << "_release(webcc::handle _root, webcc::handle* _slots) {\n";
+        if (patch.patchable)
+        {
+            for (const auto &[dispatcher, var] : patch.handlers)
+            {
+                size_t k = std::find(patch.slots.begin(), patch.slots.end(), var) - patch.slots.begin();
+                ss << "        " << dispatcher << ".remove(_slots[" << k << "]);\n";
+            }
+        }
+        else
+        {
+            for (const auto &spec : get_event_specs())
+            {
+                if (loop_region_uses_dispatcher(region, spec.dispatcher_name))
+                {
+                    ss << "        " << spec.dispatcher_name << ".remove(_root);\n";
+                }
+            }
+        }
+        ss << "        webcc::dom::remove_element(_root);\n";
+        ss << "    }\n";
+
+        // Position of the item among the rendered ones: its index, or its offset
+        // from the first rendered item in a windowed loop
+        bool windowed = !region.window_start_expr.empty();
+        std::string pos = windowed ? "_p" : "_idx";
+        std::string pos_slots = patch.slots.empty() ? "nullptr" : "&" + prefix + "_nodes[" + pos + " * " + stride + "]";
+
+        ss << "    void _sync_loop_" << region.loop_id << "_item(int _idx) {\n";
+        ss << "        if (!" << parent_var << ".is_valid()) return;\n";
+        ss << "        if (_idx < 0 || _idx >= (int)" << region.iterable_expr << ".size()) return;\n";
+        if (windowed)
+        {
+            ss << "        int _w0, _w1;\n";
+            ss << "        __coi_keyed::window(" << region.window_start_expr << ", " << region.window_end_expr << ", (int)" << region.iterable_expr << ".size(), _w0, _w1);\n";
+            ss << "        if (_w0 != " << prefix << "_first) { _sync_loop_" << region.loop_id << "(); return; }\n";
+            ss << "        if (_idx < _w0 || _idx >= _w1) return;\n";
+            ss << "        int _p = _idx - _w0;\n";
+        }
+        ss << "        int _n = (int)" << prefix << "_elements.size();\n";
+        ss << "        if (" << pos << " > _n) { _sync_loop_" << region.loop_id << "(); return; }\n";
+        ss << "        auto& " << region.var_name << " = " << region.iterable_expr << "[_idx];\n";
+        ss << "        if (" << pos << " == _n) {\n";
+        if (!patch.slots.empty())
+        {
+            ss << "            for (int _k = 0; _k < " << stride << "; _k++) " << prefix << "_nodes.push_back(webcc::handle());\n";
+        }
+        ss << "            " << prefix << "_elements.push_back(" << prefix << "_create(_idx, " << anchor_var << ", " << pos_slots << "));\n";
+        ss << "            " << prefix << "_keys.push_back(__coi_keyed::key(" << region.key_expr << "));\n";
+        if (shadow)
+        {
+            ss << "            " << prefix << "_shadow.push_back(" << region.var_name << ");\n";
+        }
+        ss << "            " << prefix << "_count = _n + 1;\n";
+        ss << "            return;\n";
+        ss << "        }\n";
+        if (shadow)
+        {
+            ss << "        if (__coi_keyed::same(" << prefix << "_shadow[" << pos << "], " << region.var_name << ")) return;\n";
+        }
+        if (patch.patchable)
+        {
+            ss << "        " << prefix << "_patch(_idx, " << pos_slots << ");\n";
+        }
+        else
+        {
+            ss << "        webcc::handle _ref = (" << pos << " + 1 < _n) ? " << prefix << "_elements[" << pos << " + 1] : " << anchor_var << ";\n";
+            ss << "        " << prefix << "_release(" << prefix << "_elements[" << pos << "], " << pos_slots << ");\n";
+            ss << "        " << prefix << "_elements[" << pos << "] = " << prefix << "_create(_idx, _ref, " << pos_slots << ");\n";
+        }
+        ss << "        " << prefix << "_keys[" << pos << "] = __coi_keyed::key(" << region.key_expr << ");\n";
+        if (shadow)
+        {
+            ss << "        " << prefix << "_shadow[" << pos << "] = " << region.var_name << ";\n";
+        }
+        ss << "    }\n";
+    }
+
+    // Generate _sync_loop_X_item() methods for the remaining keyed HTML loops (rebuild one item)
     for (const auto &region : loop_regions)
     {
-        if (!(region.is_keyed && region.is_html_loop) || region.root_element_var.empty())
+        if (!(region.is_keyed && region.is_html_loop) || region.root_element_var.empty() ||
+            html_loop_reconciles(region))
             continue;
 
         std::string elements_vec = "_loop_" + std::to_string(region.loop_id) + "_elements";
@@ -1243,6 +1769,54 @@ std::string Component::to_webcc(CompilerSession &session)
         ss << "        _if_" << region.if_id << "_state = new_state;\n";
         ss << "        \n";
 
+        if (region.keep)
+        {
+            // Kept branches move between the anchor and a detached park element:
+            // elements, handlers, child components and loops of the hidden branch
+            // stay alive. A branch shown again refreshes the bindings its guarded
+            // updaters skipped while it was hidden.
+            std::string p = "_if_" + std::to_string(region.if_id);
+            ss << "        if (!" << p << "_park.is_valid()) {\n";
+            ss << "            " << p << "_park = webcc::DOMElement(webcc::next_deferred_handle());\n";
+            ss << "            webcc::dom::create_element_deferred(" << p << "_park, \"div\");\n";
+            ss << "        }\n";
+            auto emit_swap = [&](bool show_then)
+            {
+                for (const auto &root : show_then ? region.else_roots : region.then_roots)
+                {
+                    ss << "            webcc::dom::append_child(" << p << "_park, " << root << ");\n";
+                }
+                std::string built = p + (show_then ? "_then_built" : "_else_built");
+                ss << "            if (" << built << ") {\n";
+                for (const auto &root : show_then ? region.then_roots : region.else_roots)
+                {
+                    ss << "                webcc::dom::insert_before(" << p << "_parent, " << root << ", " << p << "_anchor);\n";
+                }
+                for (const auto &[key, binding] : element_attr_bindings)
+                {
+                    if (key.if_region_id == region.if_id && key.in_then_branch == show_then)
+                    {
+                        ss << "                " << binding.method_name << "();\n";
+                    }
+                }
+                ss << "            } else {\n";
+                ss << (show_then ? region.then_creation_code : region.else_creation_code);
+                ss << "            " << built << " = true;\n";
+                ss << "            }\n";
+            };
+            ss << "        if (new_state) {\n";
+            emit_swap(true);
+            ss << "        } else {\n";
+            emit_swap(false);
+            ss << "        }\n";
+            if (!event_handlers.empty())
+            {
+                ss << "        _rebind();\n";
+            }
+            ss << "    }\n";
+            continue;
+        }
+
         std::map<std::string, std::set<int>> event_els;
         for (const auto &spec : get_event_specs())
         {
@@ -1327,6 +1901,12 @@ std::string Component::to_webcc(CompilerSession &session)
                         ss << "                " << vec_name << ".pop_back();\n";
                         ss << "            }\n";
                         ss << "            _loop_" << loop_id << "_count = 0;\n";
+                        if (lr.is_keyed && !lr.item_mount_code.empty())
+                            ss << "            _loop_" << loop_id << "_keys.clear();\n";
+                    }
+                    else if (html_loop_reconciles(lr))
+                    {
+                        emit_html_loop_teardown(ss, lr);
                     }
                     else if (lr.is_html_loop)
                     {
@@ -1402,6 +1982,12 @@ std::string Component::to_webcc(CompilerSession &session)
                         ss << "                " << vec_name << ".pop_back();\n";
                         ss << "            }\n";
                         ss << "            _loop_" << loop_id << "_count = 0;\n";
+                        if (lr.is_keyed && !lr.item_mount_code.empty())
+                            ss << "            _loop_" << loop_id << "_keys.clear();\n";
+                    }
+                    else if (html_loop_reconciles(lr))
+                    {
+                        emit_html_loop_teardown(ss, lr);
                     }
                     else if (lr.is_html_loop)
                     {
@@ -1460,49 +2046,90 @@ std::string Component::to_webcc(CompilerSession &session)
         collect_child_updates(root.get(), child_updates, update_counters);
     }
 
+    // Updater calls each member's mutation triggers (also read by sync { } blocks)
+    g_var_updates.clear();
+    auto add_var_update = [&](const std::string &var, const std::string &call)
+    {
+        g_var_updates[var].push_back(call);
+    };
+    for (const auto &var : generated_updaters)
+    {
+        add_var_update(var, "_update_" + var + "();");
+    }
+    for (const auto &[var, calls] : child_updates)
+    {
+        for (const auto &call : calls)
+        {
+            size_t start = call.find_first_not_of(' ');
+            add_var_update(var, call.substr(start, call.find_last_not_of(" \n") + 1 - start));
+        }
+    }
+    for (const auto &[var, if_ids] : var_to_if_ids)
+    {
+        for (int if_id : if_ids)
+        {
+            add_var_update(var, "_sync_if_" + std::to_string(if_id) + "();");
+        }
+    }
+    for (const auto &[var, loop_ids] : var_to_loop_ids)
+    {
+        // Skip _sync_loop for component arrays with inline operations
+        // Those are handled inline in statements (push/pop/clear) or in Assignment (full reassignment)
+        if (g_component_array_loops.find(var) == g_component_array_loops.end() &&
+            g_array_loops.find(var) == g_array_loops.end())
+        {
+            for (int loop_id : loop_ids)
+            {
+                add_var_update(var, "_sync_loop_" + std::to_string(loop_id) + "();");
+            }
+        }
+    }
+
     // Helper lambda for method generation
     auto generate_method = [&](FunctionDef &method)
     {
         std::set<std::string> modified_vars;
-        method.collect_modifications(modified_vars);
+        std::set<std::string> field_mods;
+        method.collect_modifications(modified_vars, &field_mods);
 
-        std::string updates;
+        std::vector<std::string> update_calls;
+        auto add_call = [&](const std::string &call)
+        {
+            if (std::find(update_calls.begin(), update_calls.end(), call) == update_calls.end())
+                update_calls.push_back(call);
+        };
         bool is_init_method = (method.name == "init");
         for (const auto &mod : modified_vars)
         {
-            if (generated_updaters.count(mod) && !is_init_method)
+            if (!g_var_updates.count(mod) || is_init_method)
             {
-                updates += "        _update_" + mod + "();\n";
+                continue;
             }
-            if (child_updates.count(mod) && !is_init_method)
+            // Only fields of mod were written: run their updaters instead of _update_<mod>()
+            bool by_field = field_split_vars.count(mod) && !field_mods.count(mod);
+            for (const auto &call : g_var_updates[mod])
             {
-                for (const auto &call : child_updates[mod])
+                if (!by_field || call != "_update_" + mod + "();")
                 {
-                    updates += call;
+                    add_call(call);
+                    continue;
                 }
-            }
-            if (var_to_if_ids.count(mod) && !is_init_method)
-            {
-                for (int if_id : var_to_if_ids[mod])
+                for (auto it = field_mods.lower_bound(mod + "."); it != field_mods.end() && it->rfind(mod + ".", 0) == 0; ++it)
                 {
-                    updates += "        _sync_if_" + std::to_string(if_id) + "();\n";
+                    auto field = field_updaters[mod].find(it->substr(mod.size() + 1));
+                    if (field != field_updaters[mod].end())
+                        add_call(field->second);
                 }
-            }
-            if (var_to_loop_ids.count(mod) && !is_init_method)
-            {
-                // Skip _sync_loop for component arrays with inline operations
-                // Those are handled inline in statements (push/pop/clear) or in Assignment (full reassignment)
-                if (g_component_array_loops.find(mod) == g_component_array_loops.end() &&
-                    g_array_loops.find(mod) == g_array_loops.end())
+                for (const auto &whole : whole_read_updates[mod])
                 {
-                    for (int loop_id : var_to_loop_ids[mod])
-                    {
-                        updates += "        _sync_loop_" + std::to_string(loop_id) + "();\n";
-                    }
+                    add_call(whole);
                 }
             }
         }
 
+        // Run now, or mark for the update scheduler (see schedule_updates)
+        std::string updates = schedule_updates(update_calls, "        ");
+
         for (const auto &mod : modified_vars)
         {
             if (g_ref_props.count(mod))
@@ -1537,6 +2164,7 @@ std::string Component::to_webcc(CompilerSession &session)
     {
         generate_method(method);
     }
+    g_var_updates.clear();
 
     // Only a component's pub mut members expose an onXChange hook. Pods are plain
     // value structs with no hooks, so a fine-grained callback only fits when obj is
@@ -1558,12 +2186,12 @@ std::string Component::to_webcc(CompilerSession &session)
             if (!member_dep_is_reactive(mem_dep))
                 continue;
             std::string callback_name = make_callback_name(mem_dep.member);
-            ss << "        " << mem_dep.object << "." << callback_name << " = [this]() {";
+            std::vector<std::string> calls;
             for (const auto &method_name : methods)
             {
-                ss << " " << method_name << "();";
+                calls.push_back(method_name + "();");
             }
-            ss << " };\n";
+            ss << "        " << mem_dep.object << "." << callback_name << " = [this]() {" << schedule_updates_inline(calls) << " };\n";
         }
     };
 
@@ -1576,7 +2204,8 @@ std::string Component::to_webcc(CompilerSession &session)
                 for (const auto &member : it->second.pub_mut_members)
                 {
                     std::string callback_name = make_callback_name(member);
-                    ss << "        " << param->name << "." << callback_name << " = [this]() { _update_" << member << "(); };\n";
+                    ss << "        " << param->name << "." << callback_name << " = [this]() {"
+                       << schedule_updates_inline({"_update_" + member + "();"}) << " };\n";
                 }
             }
         }
@@ -1635,6 +2264,7 @@ std::string Component::to_webcc(CompilerSession &session)
     // An invalid handle appends (see dom INSERT_BEFORE: insertBefore(el, ref || null)).
     ss << "    void view(webcc::handle parent = webcc::dom::get_body(), webcc::handle _before = webcc::handle()) {\n";
     ss << "        g_view_depth++;\n";
+    ss << "        _tick_attach();\n";
 
     bool has_init = false;
     bool has_mount = false;
@@ -1656,6 +2286,12 @@ std::string Component::to_webcc(CompilerSession &session)
     }
     // End view - flushes only at outermost level, then register event handlers
     ss << "        if (--g_view_depth == 0) webcc::flush();\n";
+    if (g_update_scheduler)
+    {
+        // Rendered from current state: nothing pending, and later marks are queued
+        ss << "        for (auto& _w : _dirty) _w = 0;\n";
+        ss << "        _sched_live = true;\n";
+    }
     // Register event handlers
     emit_all_event_registrations(ss, element_count, event_handlers, masks);
 
@@ -1667,7 +2303,8 @@ std::string Component::to_webcc(CompilerSession &session)
             if (!member_dep_is_reactive(mem_dep))
                 continue;
             std::string callback_name = make_callback_name(mem_dep.member);
-            ss << "        " << mem_dep.object << "." << callback_name << " = [this]() { _sync_if_" << region.if_id << "(); };\n";
+            ss << "        " << mem_dep.object << "." << callback_name << " = [this]() {"
+               << schedule_updates_inline({"_sync_if_" + std::to_string(region.if_id) + "();"}) << " };\n";
         }
     }
 
@@ -1691,8 +2328,12 @@ std::string Component::to_webcc(CompilerSession &session)
     }
     ss << "    }\n";
 
-    // Rebind method (always generated, even if empty, for component array reallocation)
+    // Rebind method (always generated, even if empty, for component array items that move)
     ss << "    void _rebind() {\n";
+    if (g_update_scheduler)
+    {
+        ss << "        __coi_sched::repoint(_sched_ticket, this);\n";
+    }
     if (!event_handlers.empty())
     {
         emit_all_event_registrations(ss, element_count, event_handlers, masks);
@@ -1713,6 +2354,20 @@ std::string Component::to_webcc(CompilerSession &session)
 
     emit_component_lifecycle_methods(ss, session, *this, masks, if_regions, element_count, component_members);
 
+    if (g_update_scheduler)
+    {
+        emit_dirty_scheduler(ss, qualified_name(module_name, name));
+    }
+
+    if (memo)
+    {
+        g_memo_slot_counts[qualified_name(module_name, name)] = memo_slots;
+    }
+    if (memo_slots > 0)
+    {
+        ss << "    __coi_memo::Slot _memo[" << memo_slots << "];\n";
+    }
+
     ss << "};\n";
 
     g_ref_props.clear();
@@ -40,9 +40,9 @@ std::string FunctionDef::to_webcc(const std::string& injected_code) {
     return result;
 }
 
-void FunctionDef::collect_modifications(std::set<std::string>& mods) const {
+void FunctionDef::collect_modifications(std::set<std::string>& mods, std::set<std::string>* field_mods) const {
     for(const auto& stmt : body) {
-        collect_mods_recursive(stmt.get(), mods);
+        collect_mods_recursive(stmt.get(), mods, field_mods);
     }
 }
 
@@ -59,10 +59,13 @@ std::string DataDef::to_webcc() {
         ss << ">\n";
     }
     
-    ss << "struct " << qualified_name(module_name, name) << " {\n";
+    std::string struct_name = qualified_name(module_name, name);
+    ss << "struct " << struct_name << " {\n";
     for(const auto& field : fields){
         ss << "    " << convert_type(field.type) << " " << field.name << ";\n";
     }
+    // Memberwise equality (deleted if a field has none); lets keyed loops skip unchanged items
+    ss << "    bool operator==(const " << struct_name << "&) const = default;\n";
     ss << "};\n";
     return ss.str();
 }
@@ -18,7 +18,7 @@ struct FunctionDef {
     std::vector<std::unique_ptr<Statement>> body;
 
     std::string to_webcc(const std::string& injected_code = "");
-    void collect_modifications(std::set<std::string>& mods) const;
+    void collect_modifications(std::set<std::string>& mods, std::set<std::string>* field_mods = nullptr) const;
 };
 
 struct DataField {
@@ -4,6 +4,7 @@
 #include "node.h" 
 #include "../defs/def_parser.h"
 #include "../codegen/json_codegen.h"
+#include "../codegen/codegen_utils.h"
 #include "../cli/error.h"
 #include <cctype>
 
@@ -168,6 +169,14 @@ static std::string transform_embedded_expression(const std::string& expr) {
         }
     }
     
+    // Json.stringify(value) only wraps its argument, so it works on raw text too
+    if (auto* method_def = DefSchema::instance().lookup_method(obj, method)) {
+        if (method_def->mapping_type == MappingType::Intrinsic &&
+            method_def->mapping_value == "json_stringify" && raw_args.size() == 1) {
+            return "__coi_json::stringify(" + raw_args[0] + ")" + suffix;
+        }
+    }
+    
     // Check WebSocket and other typed methods by resolving symbol type
     std::string obj_type = ComponentTypeContext::instance().get_symbol_type(obj);
     if (!obj_type.empty()) {
@@ -219,6 +228,20 @@ static std::string generate_ws_dispatcher(const std::string& event_type,
     return "";
 }
 
+// Resolve the type argument of Json.parse/Json.feed ("User" or "User[]"),
+// including component-local types (e.g., "TestStruct" -> "App_TestStruct")
+static std::string resolve_json_data_type(Expression* type_arg) {
+    std::string data_type = type_arg->to_webcc();
+
+    // Handle array types: resolve the element type, then add [] back
+    bool is_array = data_type.size() > 2 && data_type.substr(data_type.size() - 2) == "[]";
+    if (is_array) {
+        std::string elem_type = data_type.substr(0, data_type.size() - 2);
+        return ComponentTypeContext::instance().resolve(elem_type) + "[]";
+    }
+    return ComponentTypeContext::instance().resolve(data_type);
+}
+
 // Helper to generate intrinsic code
 static std::string generate_intrinsic(const std::string& intrinsic_name,
                                       const std::vector<CallArg>& args) {                           
@@ -245,6 +268,14 @@ static std::string generate_intrinsic(const std::string& intrinsic_name,
     if (intrinsic_name == "is_hidden" && args.empty()) {
         return "(webcc::system::is_hidden() != 0)";
     }
+
+    // Memo binding counters (__coi_memo exists only when the app lists memo components)
+    if (intrinsic_name == "memo_written" && args.empty()) {
+        return g_memo_components.empty() ? "0" : "(int)__coi_memo::g_written";
+    }
+    if (intrinsic_name == "memo_skipped" && args.empty()) {
+        return g_memo_components.empty() ? "0" : "(int)__coi_memo::g_skipped";
+    }
     
     // WebSocket.connect with callback arguments
     // Usage: WebSocket.connect("url", msgHandler, openHandler, closeHandler, errorHandler)
@@ -504,23 +535,38 @@ static std::string generate_intrinsic(const std::string& intrinsic_name,
         }
         
         // First arg is data type identifier (e.g., "User" or "User[]")
-        // Resolve component-local types (e.g., "TestStruct" -> "App_TestStruct")
-        std::string data_type = args[0].value->to_webcc();
-        
-        // Handle array types: resolve the element type, then add [] back
-        bool is_array = data_type.size() > 2 && data_type.substr(data_type.size() - 2) == "[]";
-        if (is_array) {
-            std::string elem_type = data_type.substr(0, data_type.size() - 2);
-            elem_type = ComponentTypeContext::instance().resolve(elem_type);
-            data_type = elem_type + "[]";
-        } else {
-            data_type = ComponentTypeContext::instance().resolve(data_type);
-        }
+        std::string data_type = resolve_json_data_type(args[0].value.get());
         
         // Second arg is JSON string expression
         std::string json_expr = args[1].value->to_webcc();
         return generate_json_parse(data_type, json_expr);
     }
+
+    // Json.feed - decodes the array elements a chunk completes, consumed via match
+    if (intrinsic_name == "json_feed") {
+        if (args.size() != 3) {
+            ErrorHandler::compiler_error(
+                "Json.feed takes exactly 3 arguments: Json.feed(Type[], stream, chunk)");
+        }
+        for (const auto& arg : args) {
+            if (!arg.name.empty() || arg.is_reference) {
+                ErrorHandler::compiler_error(
+                    "Json.feed takes plain arguments. Use: Json.feed(Type[], stream, chunk)");
+            }
+        }
+
+        std::string data_type = resolve_json_data_type(args[0].value.get());
+        if (data_type.size() < 2 || data_type.substr(data_type.size() - 2) != "[]") {
+            ErrorHandler::compiler_error(
+                "Json.feed streams the elements of an array. Use: Json.feed(" + data_type + "[], stream, chunk)");
+        }
+        return generate_json_feed(data_type, args[1].value->to_webcc(), args[2].value->to_webcc());
+    }
+
+    // Json.stringify - overload resolution on the argument picks the serializer
+    if (intrinsic_name == "json_stringify" && args.size() == 1) {
+        return "__coi_json::stringify(" + args[0].value->to_webcc() + ")";
+    }
     
     return "";  // Unknown intrinsic
 }
@@ -588,15 +634,7 @@ std::string StringLiteral::to_webcc() {
         std::string content;
         for(auto& p : parts) content += p.content;
 
-        std::string escaped;
-        for(char c : content) {
-            if(c == '"') escaped += "\\\"";
-            else if(c == '\\') escaped += "\\\\";
-            else if(c == '\n') escaped += "\\n";
-            else if(c == '\t') escaped += "\\t";
-            else escaped += c;
-        }
-        return "\"" + escaped + "\"";
+        return to_cpp_string_literal(content);
     }
 
     std::string code = "coi::string::concat(";
@@ -606,15 +644,7 @@ std::string StringLiteral::to_webcc() {
             // Transform embedded expressions to apply @inline templates (e.g., subStr -> substr)
             code += transform_embedded_expression(parts[i].content);
         } else {
-            std::string escaped;
-            for(char c : parts[i].content) {
-                if(c == '"') escaped += "\\\"";
-                else if(c == '\\') escaped += "\\\\";
-                else if(c == '\n') escaped += "\\n";
-                else if(c == '\t') escaped += "\\t";
-                else escaped += c;
-            }
-            code += "\"" + escaped + "\"";
+            code += to_cpp_string_literal(parts[i].content);
         }
     }
     code += ")";
@@ -1018,11 +1048,8 @@ std::string FunctionCall::to_webcc() {
     return result;
 }
 
-std::vector<Expression*> FunctionCall::get_children() {
-    std::vector<Expression*> children;
-    children.reserve(args.size());
-    for (auto& arg : args) children.push_back(arg.value.get());
-    return children;
+void FunctionCall::for_each_child(ChildVisitor<Expression> visit) {
+    for (auto& arg : args) visit(arg.value.get());
 }
 
 void FunctionCall::collect_dependencies(std::set<std::string>& deps) {
@@ -1031,10 +1058,8 @@ void FunctionCall::collect_dependencies(std::set<std::string>& deps) {
     if (dot_pos != std::string::npos) {
         deps.insert(name.substr(0, dot_pos));
     }
-    // Also traverse children via get_children()
-    for (auto* child : get_children()) {
-        if (child) child->collect_dependencies(deps);
-    }
+    // Also traverse children via for_each_child()
+    for_each_child([&](Expression* child) { child->collect_dependencies(deps); });
 }
 
 MemberAccess::MemberAccess(std::unique_ptr<Expression> obj, const std::string& mem)
@@ -1079,10 +1104,8 @@ void MemberAccess::collect_member_dependencies(std::set<MemberDependency>& membe
     if (auto id = dynamic_cast<Identifier*>(object.get())) {
         member_deps.insert({id->name, member});
     }
-    // Also traverse children via get_children()
-    for (auto* child : get_children()) {
-        if (child) child->collect_member_dependencies(member_deps);
-    }
+    // Also traverse children via for_each_child()
+    for_each_child([&](Expression* child) { child->collect_member_dependencies(member_deps); });
 }
 
 PostfixOp::PostfixOp(std::unique_ptr<Expression> expr, const std::string& o)
@@ -1153,11 +1176,8 @@ std::string ArrayLiteral::to_webcc() {
     return code;
 }
 
-std::vector<Expression*> ArrayLiteral::get_children() {
-    std::vector<Expression*> children;
-    children.reserve(elements.size());
-    for (auto& elem : elements) children.push_back(elem.get());
-    return children;
+void ArrayLiteral::for_each_child(ChildVisitor<Expression> visit) {
+    for (auto& elem : elements) visit(elem.get());
 }
 
 bool ArrayLiteral::is_static() {
@@ -1228,11 +1248,8 @@ std::string ComponentConstruction::to_webcc() {
     return result;
 }
 
-std::vector<Expression*> ComponentConstruction::get_children() {
-    std::vector<Expression*> children;
-    children.reserve(args.size());
-    for (auto& arg : args) children.push_back(arg.value.get());
-    return children;
+void ComponentConstruction::for_each_child(ChildVisitor<Expression> visit) {
+    for (auto& arg : args) visit(arg.value.get());
 }
 
 // Match expression code generation
@@ -1377,3 +1394,59 @@ void BlockExpr::collect_dependencies(std::set<std::string>& deps) {
     }
 }
 
+
+void collect_field_dependencies(ASTNode* node, std::map<std::string, std::set<std::string>>& fields,
+                                std::set<std::string>& whole) {
+    if (!node) return;
+    if (auto* id = dynamic_cast<Identifier*>(node)) {
+        whole.insert(id->name);
+        return;
+    }
+    if (auto* member = dynamic_cast<MemberAccess*>(node)) {
+        if (auto* id = dynamic_cast<Identifier*>(member->object.get())) {
+            fields[id->name].insert(member->member);
+            return;
+        }
+    }
+    if (auto* call = dynamic_cast<FunctionCall*>(node)) {
+        // "pos.items.size" reads field items of pos; "pos.len" may read all of pos
+        size_t first = call->name.find('.');
+        if (first != std::string::npos) {
+            size_t second = call->name.find('.', first + 1);
+            std::string root = call->name.substr(0, first);
+            if (second != std::string::npos && root.find('[') == std::string::npos)
+                fields[root].insert(call->name.substr(first + 1, second - first - 1));
+            else
+                whole.insert(root.substr(0, root.find('[')));
+        }
+    }
+    if (auto* str = dynamic_cast<StringLiteral*>(node)) {
+        // Same split over the interpolated text of template strings
+        for (auto& part : str->parse()) {
+            if (!part.is_expr) continue;
+            const std::string& expr = part.content;
+            size_t pos = 0;
+            while (pos < expr.length()) {
+                if (!isalpha(expr[pos]) && expr[pos] != '_') {
+                    pos++;
+                    continue;
+                }
+                size_t start = pos;
+                while (pos < expr.length() && (isalnum(expr[pos]) || expr[pos] == '_')) pos++;
+                if (start > 0 && expr[start - 1] == '.') continue;  // A member, not a variable
+                std::string name = expr.substr(start, pos - start);
+                size_t mem = pos + 1;
+                size_t end = mem;
+                while (end < expr.length() && (isalnum(expr[end]) || expr[end] == '_')) end++;
+                // pos.x and pos.x.len() read field x; pos.len() may read all of pos
+                if (pos < expr.length() && expr[pos] == '.' && end > mem && !isdigit(expr[mem]) &&
+                    (end == expr.length() || expr[end] != '('))
+                    fields[name].insert(expr.substr(mem, end - mem));
+                else
+                    whole.insert(name);
+            }
+        }
+        return;
+    }
+    node->for_each_child_node([&](ASTNode* child) { collect_field_dependencies(child, fields, whole); });
+}
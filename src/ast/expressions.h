@@ -64,7 +64,7 @@ struct BinaryOp : Expression {
 
     BinaryOp(std::unique_ptr<Expression> l, const std::string& o, std::unique_ptr<Expression> r);
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override { return {left.get(), right.get()}; }
+    void for_each_child(ChildVisitor<Expression> visit) override { visit(left.get()); visit(right.get()); }
 };
 
 // Unified argument for function calls and component construction
@@ -84,7 +84,7 @@ struct FunctionCall : Expression {
     explicit FunctionCall(const std::string& n) : name(n){}
     std::string args_to_string();
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override;
+    void for_each_child(ChildVisitor<Expression> visit) override;
     // Custom: also handles object.method() dot notation
     void collect_dependencies(std::set<std::string>& deps) override;
 };
@@ -95,7 +95,7 @@ struct MemberAccess : Expression {
 
     MemberAccess(std::unique_ptr<Expression> obj, const std::string& mem);
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override { return {object.get()}; }
+    void for_each_child(ChildVisitor<Expression> visit) override { visit(object.get()); }
     // Custom: adds this as a member dependency (object.member)
     void collect_member_dependencies(std::set<MemberDependency>& member_deps) override;
 };
@@ -106,7 +106,7 @@ struct PostfixOp : Expression {
 
     PostfixOp(std::unique_ptr<Expression> expr, const std::string& o);
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override { return {operand.get()}; }
+    void for_each_child(ChildVisitor<Expression> visit) override { visit(operand.get()); }
 };
 
 struct UnaryOp : Expression {
@@ -115,7 +115,7 @@ struct UnaryOp : Expression {
 
     UnaryOp(const std::string& o, std::unique_ptr<Expression> expr);
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override { return {operand.get()}; }
+    void for_each_child(ChildVisitor<Expression> visit) override { visit(operand.get()); }
     bool is_static() override;
 };
 
@@ -125,7 +125,7 @@ struct ReferenceExpression : Expression {
 
     ReferenceExpression(std::unique_ptr<Expression> expr) : operand(std::move(expr)) {}
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override { return {operand.get()}; }
+    void for_each_child(ChildVisitor<Expression> visit) override { visit(operand.get()); }
 };
 
 // Move expression: :expr - explicitly transfers ownership
@@ -134,7 +134,7 @@ struct MoveExpression : Expression {
 
     MoveExpression(std::unique_ptr<Expression> expr) : operand(std::move(expr)) {}
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override { return {operand.get()}; }
+    void for_each_child(ChildVisitor<Expression> visit) override { visit(operand.get()); }
 };
 
 struct TernaryOp : Expression {
@@ -144,7 +144,7 @@ struct TernaryOp : Expression {
 
     TernaryOp(std::unique_ptr<Expression> cond, std::unique_ptr<Expression> t, std::unique_ptr<Expression> f);
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override { return {condition.get(), true_expr.get(), false_expr.get()}; }
+    void for_each_child(ChildVisitor<Expression> visit) override { visit(condition.get()); visit(true_expr.get()); visit(false_expr.get()); }
     bool is_static() override;
 };
 
@@ -154,7 +154,7 @@ struct ArrayLiteral : Expression {
 
     ArrayLiteral() = default;
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override;
+    void for_each_child(ChildVisitor<Expression> visit) override;
     bool is_static() override;
     
     // Propagate element type to anonymous struct literals (ComponentConstruction with empty name)
@@ -168,7 +168,7 @@ struct ArrayRepeatLiteral : Expression {
 
     ArrayRepeatLiteral() = default;
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override { return {value.get(), count.get()}; }
+    void for_each_child(ChildVisitor<Expression> visit) override { visit(value.get()); visit(count.get()); }
     bool is_static() override;
 };
 
@@ -178,7 +178,7 @@ struct IndexAccess : Expression {
 
     IndexAccess(std::unique_ptr<Expression> arr, std::unique_ptr<Expression> idx);
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override { return {array.get(), index.get()}; }
+    void for_each_child(ChildVisitor<Expression> visit) override { visit(array.get()); visit(index.get()); }
 };
 
 // Enum value access: Mode::Idle or App.Mode::Idle
@@ -204,7 +204,7 @@ struct ComponentConstruction : Expression {
 
     explicit ComponentConstruction(const std::string& name) : component_name(name) {}
     std::string to_webcc() override;
-    std::vector<Expression*> get_children() override;
+    void for_each_child(ChildVisitor<Expression> visit) override;
 };
 
 // Match pattern for pattern matching in match expressions
@@ -265,11 +265,9 @@ struct MatchExpr : Expression {
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
     bool is_static() override;
-    std::vector<ASTNode*> get_child_nodes() override {
-        std::vector<ASTNode*> nodes;
-        nodes.push_back(subject.get());
-        for (auto& arm : arms) nodes.push_back(arm.body.get());
-        return nodes;
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override {
+        visit(subject.get());
+        for (auto& arm : arms) visit(arm.body.get());
     }
 };
 
@@ -281,9 +279,13 @@ struct BlockExpr : Expression {
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
     bool is_static() override { return false; }
-    std::vector<ASTNode*> get_child_nodes() override {
-        std::vector<ASTNode*> nodes;
-        for (auto& s : statements) nodes.push_back(s.get());
-        return nodes;
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override {
+        for (auto& s : statements) visit(s.get());
     }
 };
+
+// Split the variables a subtree reads into those read only through a field
+// (pos.x, list.items.size()) and those read as a whole (pos, f(pos), pos.len()).
+// Bindings that read a variable only through fields are updated per field.
+void collect_field_dependencies(ASTNode* node, std::map<std::string, std::set<std::string>>& fields,
+                                std::set<std::string>& whole);
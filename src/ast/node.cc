@@ -3,6 +3,14 @@
 #include <cctype>
 #include <algorithm>
 
+std::string dynamic_array_type(const std::string& elem_type) {
+    // Component arrays keep their items at fixed addresses (see __coi_stable)
+    if (ComponentTypeContext::instance().component_types.count(elem_type)) {
+        return "__coi_stable::vector<" + elem_type + ">";
+    }
+    return "coi::vector<" + elem_type + ">";
+}
+
 std::string convert_type(const std::string& type) {
     if (type == "string") return "coi::string";
     
@@ -111,8 +119,7 @@ std::string convert_type(const std::string& type) {
     }
     // Handle dynamic arrays: T[]
     if (type.ends_with("[]")) {
-        std::string inner = type.substr(0, type.length() - 2);
-        return "coi::vector<" + convert_type(inner) + ">";
+        return dynamic_array_type(convert_type(type.substr(0, type.length() - 2)));
     }
     // Handle fixed-size arrays: T[N] and maps: V[K]
     size_t bracket_pos = type.rfind('[');
@@ -7,6 +7,8 @@
 #include <map>
 #include <sstream>
 #include <functional>
+#include <type_traits>
+#include "arena.h"
 
 // Forward declarations
 struct Expression;
@@ -35,6 +37,27 @@ struct MemberDependency {
     }
 };
 
+// Non-owning reference to a callable that visits child nodes, so child
+// iteration takes any lambda without std::function's allocation. Null
+// children are skipped here; visitors never see them.
+template <typename Node>
+class ChildVisitor {
+public:
+    template <typename F>
+        requires(!std::is_same_v<std::remove_cvref_t<F>, ChildVisitor>)
+    ChildVisitor(F &&f)
+        : callable((void *)std::addressof(f)),
+          invoke([](void *c, Node *child) { (*static_cast<std::remove_reference_t<F> *>(c))(child); }) {}
+
+    void operator()(Node *child) const {
+        if (child) invoke(callable, child);
+    }
+
+private:
+    void *callable;
+    void (*invoke)(void *, Node *);
+};
+
 // Base AST node
 struct ASTNode {
     virtual ~ASTNode() = default;
@@ -45,7 +68,11 @@ struct ASTNode {
     // Uniform child access for whole-AST traversals that span statements and
     // expressions (e.g. reactive-mod collection). Override on any node with
     // children so generic walks never need to enumerate node types by hand.
-    virtual std::vector<ASTNode*> get_child_nodes() { return {}; }
+    virtual void for_each_child_node(ChildVisitor<ASTNode> visit) {}
+
+    // Nodes live in the current AstArena; deleting one only destroys it
+    static void *operator new(size_t size) { return AstArena::current().allocate(size); }
+    static void operator delete(void *) noexcept {}
 
     int line = 0;
 };
@@ -54,30 +81,23 @@ struct ASTNode {
 struct Expression : ASTNode {
     virtual bool is_static() { return false; }
     
-    // Returns child expressions for traversal. Override in subclasses with children.
-    virtual std::vector<Expression*> get_children() { return {}; }
+    // Visits child expressions for traversal. Override in subclasses with children.
+    virtual void for_each_child(ChildVisitor<Expression> visit) {}
 
-    // Bridge get_children() into the node-level traversal. Nodes with statement
-    // children (BlockExpr, MatchExpr) override get_child_nodes() directly.
-    std::vector<ASTNode*> get_child_nodes() override {
-        std::vector<ASTNode*> nodes;
-        for (auto* child : get_children())
-            if (child) nodes.push_back(child);
-        return nodes;
+    // Bridge for_each_child() into the node-level traversal. Nodes with statement
+    // children (BlockExpr, MatchExpr) override for_each_child_node() directly.
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override {
+        for_each_child([&](Expression *child) { visit(child); });
     }
 
     // Default implementation: traverse all children
     void collect_dependencies(std::set<std::string>& deps) override {
-        for (auto* child : get_children()) {
-            if (child) child->collect_dependencies(deps);
-        }
+        for_each_child([&](Expression *child) { child->collect_dependencies(deps); });
     }
     
     // Default implementation: traverse all children
     void collect_member_dependencies(std::set<MemberDependency>& member_deps) override {
-        for (auto* child : get_children()) {
-            if (child) child->collect_member_dependencies(member_deps);
-        }
+        for_each_child([&](Expression *child) { child->collect_member_dependencies(member_deps); });
     }
 };
 
@@ -91,6 +111,7 @@ struct ComponentTypeContext {
     std::set<std::string> local_data_types;    // Data types defined in this component
     std::set<std::string> local_enum_types;    // Enum types defined in this component
     std::set<std::string> global_data_types;   // Fully-qualified global data type names
+    std::set<std::string> component_types;     // Qualified names of all components (kept across components)
     std::map<std::string, int> method_param_counts;  // Method name -> param count
     
     // Store full method signatures for lambda generation
@@ -218,6 +239,9 @@ struct ComponentTypeContext {
 // Type conversion utility
 std::string convert_type(const std::string& type);
 
+// C++ type of a dynamic array whose element type is already converted
+std::string dynamic_array_type(const std::string& elem_type);
+
 // Generate qualified name with module prefix (e.g., "TurboUI_Button" for module "TurboUI", name "Button")
 inline std::string qualified_name(const std::string& module_name, const std::string& name) {
     if (module_name.empty()) return name;
@@ -73,8 +73,8 @@ std::string VarDeclaration::to_webcc()
                 return result;
             }
             
-            // Mutable dynamic array - use vector with brace init (variadic constructor)
-            std::string vec_type = "coi::vector<" + convert_type(elem_type) + ">";
+            // Mutable dynamic array - use vector with brace init
+            std::string vec_type = dynamic_array_type(convert_type(elem_type));
 
             std::string result = vec_type;
             if (is_reference)
@@ -172,47 +172,27 @@ std::string Assignment::to_webcc()
         rhs = convert_type(target_type) + "((int32_t)" + rhs + ")";
     }
 
-    // For component array FULL REASSIGNMENT (arr = newArr), we need to:
-    // 1. Remove old items' views BEFORE assignment (unregister event handlers + remove DOM)
-    // 2. Do the assignment
-    // 3. Re-render all items in the new array with fresh handles
+    // For component array FULL REASSIGNMENT (arr = newArr), hand the new array to
+    // the loop's keyed reconciler: it removes views whose key is gone, keeps and
+    // moves the ones that carry over, and renders the rest.
     auto it = g_component_array_loops.find(name);
     if (it != g_component_array_loops.end() && it->second.is_member_ref_loop)
     {
         const auto &info = it->second;
-        std::string var = info.var_name;
-        std::string parent_var = "_loop_" + std::to_string(info.loop_id) + "_parent";
-        std::string count_var = "_loop_" + std::to_string(info.loop_id) + "_count";
-        std::string result;
-
-        // Remove old views BEFORE assignment (unregisters event handlers from dispatchers)
-        result += "if (" + count_var + " > 0) {\n";
-        if (info.is_only_child)
-        {
-            // Bulk optimization: unregister handlers only, then clear parent's innerHTML
-            result += "    for (auto& " + var + " : " + name + ") { " + var + "._remove_view(true); }\n";
-            result += "    webcc::dom::set_inner_html(" + parent_var + ", \"\");\n";
-        }
-        else
-        {
-            // Normal path: each _remove_view removes its own DOM element
-            result += "    for (auto& " + var + " : " + name + ") { " + var + "._remove_view(); }\n";
-        }
-        result += "}\n";
-
-        // Do the assignment
-        result += lhs + " = " + rhs + ";\n";
-
-        // Re-render all items in the new array with fresh handles
-        result += count_var + " = (int)" + name + ".size();\n";
-        result += "g_view_depth++;\n";
-        result += "for (auto& " + var + " : " + name + ") {\n";
-        result += info.item_creation_code;
-        result += "}\n";
-        result += "if (--g_view_depth == 0) webcc::flush();";
+        std::string result = "{\n";
+        result += "decltype(" + lhs + ") _next = " + rhs + ";\n";
+        result += "_reconcile_loop_" + std::to_string(info.loop_id) + "(_next);\n";
+        result += "}";
         return result;
     }
 
+    // Keyed HTML loops reconcile the whole array: unchanged items keep their elements
+    auto html_loop_it = g_array_loops.find(name);
+    if (html_loop_it != g_array_loops.end())
+    {
+        return lhs + " = " + rhs + ";\n_sync_loop_" + std::to_string(html_loop_it->second.loop_id) + "();";
+    }
+
     return lhs + " = " + rhs + ";";
 }
 
@@ -257,11 +237,27 @@ std::string IndexAssignment::to_webcc()
             // Get the element that should be after this one (or null if at end)
             result += "{ int _idx = " + idx + ";\n";
             result += "  webcc::handle _node = " + arr + "[_idx]._get_root_element();\n";
-            result += "  webcc::handle _ref = (_idx + 1 < (int)" + arr + ".size()) ? " + arr + "[_idx + 1]._get_root_element() : webcc::handle{0};\n";
+            result += "  webcc::handle _ref = (_idx + 1 < (int)" + arr + ".size()) ? " + arr + "[_idx + 1]._get_root_element() : " + it->second.anchor_var + ";\n";
             result += "  webcc::dom::move_before(" + parent_var + ", _node, _ref);\n";
             result += "}";
             return result;
         }
+
+        // Keyed HTML loop: patch the element at that index in place
+        auto html_loop_it = g_array_loops.find(id->name);
+        if (html_loop_it != g_array_loops.end())
+        {
+            std::string arr = array->to_webcc();
+            std::string idx = index->to_webcc();
+            std::string result = "{ int _idx = " + idx + ";\n";
+            if (compound_op.empty())
+                result += arr + "[_idx] = " + val + ";\n";
+            else
+                result += arr + "[_idx] = " + arr + "[_idx] " + compound_op + " " + val + ";\n";
+            result += "_sync_loop_" + std::to_string(html_loop_it->second.loop_id) + "_item(_idx);\n";
+            result += "}";
+            return result;
+        }
     }
 
     if (compound_op.empty())
@@ -293,6 +289,33 @@ std::string MemberAssignment::to_webcc()
         val = "coi::move(" + val + ")";
     }
 
+    // Field of a keyed HTML loop element (rows[i].label = ...): write it through
+    // the index once and patch just that item.
+    Expression *root = object.get();
+    while (auto member_acc = dynamic_cast<MemberAccess *>(root))
+    {
+        root = member_acc->object.get();
+    }
+    if (auto index_acc = dynamic_cast<IndexAccess *>(root))
+    {
+        auto *arr_id = dynamic_cast<Identifier *>(index_acc->array.get());
+        auto html_loop_it = arr_id ? g_array_loops.find(arr_id->name) : g_array_loops.end();
+        if (html_loop_it != g_array_loops.end())
+        {
+            std::string elem = index_acc->to_webcc();
+            std::string obj = object->to_webcc();
+            obj = arr_id->to_webcc() + "[_idx]" + obj.substr(elem.size());
+            std::string result = "{ int _idx = " + index_acc->index->to_webcc() + ";\n";
+            if (compound_op.empty())
+                result += obj + "." + member + " = " + val + ";\n";
+            else
+                result += obj + "." + member + " = " + obj + "." + member + " " + compound_op + " " + val + ";\n";
+            result += "_sync_loop_" + std::to_string(html_loop_it->second.loop_id) + "_item(_idx);\n";
+            result += "}";
+            return result;
+        }
+    }
+
     std::string obj = object->to_webcc();
     std::string result;
     if (compound_op.empty())
@@ -306,11 +329,6 @@ std::string MemberAssignment::to_webcc()
 
     // Fast path: if assigning to a keyed HTML loop item member (e.g., task.status = ...),
     // patch only that loop item instead of re-syncing the whole loop.
-    Expression *root = object.get();
-    while (auto member_acc = dynamic_cast<MemberAccess *>(root))
-    {
-        root = member_acc->object.get();
-    }
     if (auto id = dynamic_cast<Identifier *>(root))
     {
         auto it = g_html_loop_var_infos.find(id->name);
@@ -403,19 +421,15 @@ std::string ExpressionStatement::to_webcc()
                 if (method == "push" && call->args.size() == 1)
                 {
                     // arr.push(item) -> add to array, bind callbacks, render view if parent exists
-                    // IMPORTANT: push_back may reallocate the vector, invalidating all existing
-                    // items' `this` pointers in their registered event handlers. We must rebind
-                    // all existing items after push_back to update their handler lambdas.
+                    // Component arrays never move existing items on push_back, so their
+                    // registered handlers stay valid without a rebind.
                     std::string item_expr = call->args[0].value->to_webcc();
                     std::string parent_var = "_loop_" + std::to_string(info.loop_id) + "_parent";
                     std::string count_var = "_loop_" + std::to_string(info.loop_id) + "_count";
                     result = "{\n";
-                    result += "int _old_count = (int)" + arr_name + ".size();\n";
                     result += arr_name + ".push_back(" + item_expr + ");\n";
                     // Only render view if parent container exists (not during init)
                     result += "if (" + parent_var + ".is_valid()) {\n";
-                    // (IMPORTANT!!!) Rebind all existing items in case vector reallocated
-                    result += "    for (int _i = 0; _i < _old_count; _i++) " + arr_name + "[_i]._rebind();\n";
                     result += "    auto& " + var + " = " + arr_name + "[" + arr_name + ".size() - 1];\n";
                     // Inject the item creation code (callback bindings + view call)
                     result += info.item_creation_code;
@@ -427,9 +441,29 @@ std::string ExpressionStatement::to_webcc()
                 else if (method == "pop" && call->args.empty())
                 {
                     // arr.pop() -> remove view then pop from array
+                    std::string parent_var = "_loop_" + std::to_string(info.loop_id) + "_parent";
+                    std::string count_var = "_loop_" + std::to_string(info.loop_id) + "_count";
                     result = "if (!" + arr_name + ".empty()) {\n";
                     result += "    " + arr_name + ".back()._remove_view();\n";
                     result += "    " + arr_name + ".pop_back();\n";
+                    result += "    if (" + parent_var + ".is_valid()) " + count_var + "--;\n";
+                    result += "}\n";
+                    return result;
+                }
+                else if (method == "remove" && call->args.size() == 1)
+                {
+                    // arr.remove(i) -> remove that item's view; the items after it move
+                    // down one slot and rebind, keeping the views they already have
+                    std::string index_expr = call->args[0].value->to_webcc();
+                    std::string parent_var = "_loop_" + std::to_string(info.loop_id) + "_parent";
+                    std::string count_var = "_loop_" + std::to_string(info.loop_id) + "_count";
+                    result = "{\n";
+                    result += "int _at = " + index_expr + ";\n";
+                    result += "if (_at >= 0 && _at < (int)" + arr_name + ".size()) {\n";
+                    result += "    " + arr_name + "[_at]._remove_view();\n";
+                    result += "    " + arr_name + ".remove(_at);\n";
+                    result += "    if (" + parent_var + ".is_valid()) " + count_var + "--;\n";
+                    result += "}\n";
                     result += "}\n";
                     return result;
                 }
@@ -440,9 +474,10 @@ std::string ExpressionStatement::to_webcc()
                     std::string count_var = "_loop_" + std::to_string(info.loop_id) + "_count";
                     if (info.is_only_child)
                     {
-                        // Bulk optimization: unregister handlers only, then clear parent's innerHTML
+                        // Bulk optimization: unregister handlers only, clear parent's innerHTML, re-attach the anchor
                         result = "for (auto& " + var + " : " + arr_name + ") { " + var + "._remove_view(true); }\n";
                         result += "webcc::dom::set_inner_html(" + parent_var + ", \"\");\n";
+                        result += "webcc::dom::append_child(" + parent_var + ", " + info.anchor_var + ");\n";
                     }
                     else
                     {
@@ -458,50 +493,19 @@ std::string ExpressionStatement::to_webcc()
             auto html_loop_it = g_array_loops.find(arr_name);
             if (html_loop_it != g_array_loops.end())
             {
-                const auto &info = html_loop_it->second;
-                std::string var = info.var_name;
-                std::string result;
-
+                // Keyed HTML loop: an appended item is created on its own; any other
+                // mutation reconciles the loop, touching only added/removed/moved items
+                std::string sync = "_sync_loop_" + std::to_string(html_loop_it->second.loop_id);
                 if (method == "push" && call->args.size() == 1)
                 {
                     std::string item_expr = call->args[0].value->to_webcc();
-                    std::string parent_var = info.parent_var;
-                    std::string count_var = "_loop_" + std::to_string(info.loop_id) + "_count";
-                    result = "{\n";
-                    result += arr_name + ".push_back(" + item_expr + ");\n";
-                    result += "if (" + parent_var + ".is_valid()) {\n";
-                    result += "    auto& " + var + " = " + arr_name + "[" + arr_name + ".size() - 1];\n";
-                    result += info.item_creation_code;
-                    if (!info.root_element_var.empty())
-                    {
-                        result += "    " + info.elements_vec_name + ".push_back(" + info.root_element_var + ");\n";
-                    }
-                    result += "    " + count_var + " = (int)" + arr_name + ".size();\n";
-                    result += "}\n";
-                    result += "}\n";
+                    std::string result = arr_name + ".push_back(" + item_expr + ");\n";
+                    result += sync + "_item((int)" + arr_name + ".size() - 1);\n";
                     return result;
                 }
-                else if (method == "pop" && call->args.empty())
+                if (method == "pop" || method == "clear" || method == "remove" || method == "sort")
                 {
-                    std::string count_var = "_loop_" + std::to_string(info.loop_id) + "_count";
-                    result = "if (!" + arr_name + ".empty()) {\n";
-                    result += "    if (!" + info.elements_vec_name + ".empty()) {\n";
-                    result += "        webcc::dom::remove_element(" + info.elements_vec_name + ".back());\n";
-                    result += "        " + info.elements_vec_name + ".pop_back();\n";
-                    result += "    }\n";
-                    result += "    " + arr_name + ".pop_back();\n";
-                    result += "    " + count_var + " = (int)" + arr_name + ".size();\n";
-                    result += "}\n";
-                    return result;
-                }
-                else if (method == "clear" && call->args.empty())
-                {
-                    std::string count_var = "_loop_" + std::to_string(info.loop_id) + "_count";
-                    result = "for (auto& _el : " + info.elements_vec_name + ") { webcc::dom::remove_element(_el); }\n";
-                    result += info.elements_vec_name + ".clear();\n";
-                    result += arr_name + ".clear();\n";
-                    result += count_var + " = 0;\n";
-                    return result;
+                    return call->to_webcc() + ";\n" + sync + "();\n";
                 }
             }
         }
@@ -523,6 +527,31 @@ std::string BlockStatement::to_webcc()
     return code;
 }
 
+std::string BatchStatement::to_webcc()
+{
+    std::string code = "{\n";
+    code += is_sync ? "__coi_sched::Sync _sync;\n" : "__coi_sched::Batch _batch;\n";
+    for (auto &stmt : statements)
+        code += stmt->to_webcc();
+    if (is_sync)
+    {
+        // Writes made in the block join the drain instead of waiting for the method end
+        std::set<std::string> mods;
+        for (auto &stmt : statements)
+            collect_mods_recursive(stmt.get(), mods);
+        std::vector<std::string> calls;
+        for (const auto &mod : mods)
+        {
+            auto it = g_var_updates.find(mod);
+            if (it != g_var_updates.end())
+                calls.insert(calls.end(), it->second.begin(), it->second.end());
+        }
+        code += mark_dirty_updates(calls, "");
+    }
+    code += "}\n";
+    return code;
+}
+
 void BlockStatement::collect_dependencies(std::set<std::string> &deps)
 {
     for (auto &stmt : statements)
@@ -601,15 +630,51 @@ void EmitStatement::collect_dependencies(std::set<std::string> &deps)
     }
 }
 
-void collect_mods_recursive(ASTNode *node, std::set<std::string> &mods)
+void collect_mods_recursive(ASTNode *node, std::set<std::string> &mods, std::set<std::string> *field_mods)
 {
     if (!node)
         return;
 
+    // Root variable, plus the field written when it is only p.field (see field_mods)
+    auto record = [&](const std::string &name, const std::string &field)
+    {
+        mods.insert(name);
+        if (field_mods)
+            field_mods->insert(field.empty() ? name : name + "." + field);
+    };
+
+    // Record the variable behind a written place: pos, pos.x.y (field x),
+    // rows[i].label (an element: the whole of rows)
+    auto record_place = [&](Expression *place, std::string field)
+    {
+        bool element = false;
+        while (true)
+        {
+            if (auto member = dynamic_cast<MemberAccess *>(place))
+            {
+                field = member->member;
+                place = member->object.get();
+            }
+            else if (auto index = dynamic_cast<IndexAccess *>(place))
+            {
+                element = true;
+                place = index->array.get();
+            }
+            else
+            {
+                break;
+            }
+        }
+        if (auto id = dynamic_cast<Identifier *>(place))
+        {
+            record(id->name, element ? "" : field);
+        }
+    };
+
     // Does this node itself mutate a component field?
     if (auto assign = dynamic_cast<Assignment *>(node))
     {
-        mods.insert(assign->name);
+        record(assign->name, "");
     }
     else if (auto idxAssign = dynamic_cast<IndexAssignment *>(node))
     {
@@ -618,38 +683,25 @@ void collect_mods_recursive(ASTNode *node, std::set<std::string> &mods)
             // Swapping components in a component array needs no DOM sync.
             if (g_component_array_loops.find(id->name) == g_component_array_loops.end())
             {
-                mods.insert(id->name);
+                record(id->name, "");
             }
         }
     }
     else if (auto memberAssign = dynamic_cast<MemberAssignment *>(node))
     {
-        // Track the root object being modified (walk out of the member chain).
-        Expression *obj = memberAssign->object.get();
-        while (auto member = dynamic_cast<MemberAccess *>(obj))
-        {
-            obj = member->object.get();
-        }
-        if (auto id = dynamic_cast<Identifier *>(obj))
-        {
-            mods.insert(id->name);
-        }
+        // Track the root object being modified (walk out of the member chain and
+        // element accesses: rows[i].label = ... modifies rows).
+        record_place(memberAssign->object.get(), memberAssign->member);
     }
     else if (auto postfix = dynamic_cast<PostfixOp *>(node))
     {
-        if (auto id = dynamic_cast<Identifier *>(postfix->operand.get()))
-        {
-            mods.insert(id->name);
-        }
+        record_place(postfix->operand.get(), "");
     }
     else if (auto unary = dynamic_cast<UnaryOp *>(node))
     {
         if (unary->op == "++" || unary->op == "--")
         {
-            if (auto id = dynamic_cast<Identifier *>(unary->operand.get()))
-            {
-                mods.insert(id->name);
-            }
+            record_place(unary->operand.get(), "");
         }
     }
     else if (auto call = dynamic_cast<FunctionCall *>(node))
@@ -695,17 +747,22 @@ void collect_mods_recursive(ASTNode *node, std::set<std::string> &mods)
                     split_pos = first_bracket;
                 }
 
-                mods.insert(split_pos != std::string::npos ? obj_expr.substr(0, split_pos) : obj_expr);
+                // "pos.items.push" writes field items of pos
+                std::string root = split_pos != std::string::npos ? obj_expr.substr(0, split_pos) : obj_expr;
+                std::string field;
+                if (split_pos == first_dot && first_dot != std::string::npos)
+                {
+                    field = obj_expr.substr(first_dot + 1);
+                    field = field.substr(0, field.find_first_of(".["));
+                }
+                record(root, field);
             }
         }
     }
 
     // Descend into every child uniformly. A new node type is covered as soon as
-    // it implements get_child_nodes(); this walk never needs to list them.
-    for (auto *child : node->get_child_nodes())
-    {
-        collect_mods_recursive(child, mods);
-    }
+    // it implements for_each_child_node(); this walk never needs to list them.
+    node->for_each_child_node([&](ASTNode *child) { collect_mods_recursive(child, mods, field_mods); });
 
     // After descending: if a foreach's item was mutated (e.g. task.status = ...),
     // mark the iterable too so parent-level reactive updates run.
@@ -715,7 +772,7 @@ void collect_mods_recursive(ASTNode *node, std::set<std::string> &mods)
         {
             if (auto id = dynamic_cast<Identifier *>(forEach->iterable.get()))
             {
-                mods.insert(id->name);
+                record(id->name, "");
             }
         }
     }
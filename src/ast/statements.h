@@ -13,7 +13,7 @@ struct VarDeclaration : Statement {
     bool is_move = false;  // true if initialized with &expr (move semantics)
 
     std::string to_webcc() override;
-    std::vector<ASTNode*> get_child_nodes() override { return {initializer.get()}; }
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override { visit(initializer.get()); }
 };
 
 // Component constructor parameter
@@ -28,7 +28,7 @@ struct ComponentParam : Statement {
     bool is_callback = false;
 
     std::string to_webcc() override;
-    std::vector<ASTNode*> get_child_nodes() override { return {default_value.get()}; }
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override { visit(default_value.get()); }
 };
 
 struct Assignment : Statement {
@@ -39,7 +39,7 @@ struct Assignment : Statement {
 
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
-    std::vector<ASTNode*> get_child_nodes() override { return {value.get()}; }
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override { visit(value.get()); }
 };
 
 struct IndexAssignment : Statement {
@@ -51,7 +51,7 @@ struct IndexAssignment : Statement {
 
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
-    std::vector<ASTNode*> get_child_nodes() override { return {array.get(), index.get(), value.get()}; }
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override { visit(array.get()); visit(index.get()); visit(value.get()); }
 };
 
 struct MemberAssignment : Statement {
@@ -63,7 +63,7 @@ struct MemberAssignment : Statement {
 
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
-    std::vector<ASTNode*> get_child_nodes() override { return {object.get(), value.get()}; }
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override { visit(object.get()); visit(value.get()); }
 };
 
 struct ReturnStatement : Statement {
@@ -71,27 +71,33 @@ struct ReturnStatement : Statement {
 
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
-    std::vector<ASTNode*> get_child_nodes() override { return {value.get()}; }
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override { visit(value.get()); }
 };
 
 struct ExpressionStatement : Statement {
     std::unique_ptr<Expression> expression;
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
-    std::vector<ASTNode*> get_child_nodes() override { return {expression.get()}; }
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override { visit(expression.get()); }
 };
 
 struct BlockStatement : Statement {
     std::vector<std::unique_ptr<Statement>> statements;
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
-    std::vector<ASTNode*> get_child_nodes() override {
-        std::vector<ASTNode*> nodes;
-        for (auto& s : statements) nodes.push_back(s.get());
-        return nodes;
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override {
+        for (auto& s : statements) visit(s.get());
     }
 };
 
+// batch { ... } defers the updaters of everything mutated inside and runs each
+// once when the outermost batch ends. sync { ... } runs pending updaters and
+// flushes DOM commands when it ends, so code after it can read the DOM.
+struct BatchStatement : BlockStatement {
+    bool is_sync = false;
+    std::string to_webcc() override;
+};
+
 struct IfStatement : Statement {
     std::unique_ptr<Expression> condition;
     std::unique_ptr<Statement> then_branch;
@@ -99,7 +105,7 @@ struct IfStatement : Statement {
 
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
-    std::vector<ASTNode*> get_child_nodes() override { return {condition.get(), then_branch.get(), else_branch.get()}; }
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override { visit(condition.get()); visit(then_branch.get()); visit(else_branch.get()); }
 };
 
 struct ForRangeStatement : Statement {
@@ -110,7 +116,7 @@ struct ForRangeStatement : Statement {
 
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
-    std::vector<ASTNode*> get_child_nodes() override { return {start.get(), end.get(), body.get()}; }
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override { visit(start.get()); visit(end.get()); visit(body.get()); }
 };
 
 struct ForEachStatement : Statement {
@@ -120,7 +126,7 @@ struct ForEachStatement : Statement {
 
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
-    std::vector<ASTNode*> get_child_nodes() override { return {iterable.get(), body.get()}; }
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override { visit(iterable.get()); visit(body.get()); }
 };
 
 struct EmitStatement : Statement {
@@ -129,13 +135,13 @@ struct EmitStatement : Statement {
 
     std::string to_webcc() override;
     void collect_dependencies(std::set<std::string>& deps) override;
-    std::vector<ASTNode*> get_child_nodes() override {
-        std::vector<ASTNode*> nodes;
-        for (auto& a : args) nodes.push_back(a.get());
-        return nodes;
+    void for_each_child_node(ChildVisitor<ASTNode> visit) override {
+        for (auto& a : args) visit(a.get());
     }
 };
 
 // Recursively collect the component fields a subtree mutates. Walks any node via
-// get_child_nodes(), so new node types are covered without editing this walk.
-void collect_mods_recursive(ASTNode* node, std::set<std::string>& mods);
+// for_each_child_node(), so new node types are covered without editing this walk.
+// field_mods, when given, also gets "pos.x" for a write to field x of pos only,
+// and "pos" when pos is written as a whole (or through an element, rows[i].x).
+void collect_mods_recursive(ASTNode* node, std::set<std::string>& mods, std::set<std::string>* field_mods = nullptr);
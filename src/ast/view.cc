@@ -1,5 +1,6 @@
 #include "view.h"
 #include "formatter.h"
+#include "codegen_state.h"
 #include "../codegen/codegen_utils.h"
 
 // Global set of components with scoped CSS (populated in main.cc before code generation)
@@ -145,6 +146,45 @@ static std::string build_lambda_capture(const std::string &loop_var_name)
     return "[this, " + loop_var_name + "]";
 }
 
+// Register a loop item's event handler. A reused item registers it again, so
+// the handler captures the item's current value.
+static void emit_loop_handler(ViewCodegenContext &ctx, const std::string &dispatcher,
+                              const std::string &var, const std::string &fn)
+{
+    std::string stmt = dispatcher + ".set(" + var + ", " + fn + ");";
+    ctx.ss << "        " << stmt << "\n";
+    if (ctx.item_patch)
+    {
+        ctx.item_patch->handlers.push_back({dispatcher, var});
+        ctx.item_patch->add(var, stmt);
+    }
+}
+
+static bool calls_method(Expression *expr)
+{
+    auto *call = dynamic_cast<FunctionCall *>(expr);
+    if (call && call->name.find('.') == std::string::npos)
+        return true;
+    bool found = false;
+    expr->for_each_child([&](Expression *child) { found = found || calls_method(child); });
+    return found;
+}
+
+// Note what a loop item's binding reads besides the item itself. A method
+// call can read any state.
+static void note_item_reads(ViewCodegenContext &ctx, ASTNode *node)
+{
+    auto *expr = dynamic_cast<Expression *>(node);
+    if (!ctx.item_patch || !expr)
+        return;
+    std::set<std::string> deps;
+    expr->collect_dependencies(deps);
+    deps.erase(ctx.loop_var_name);
+    ctx.item_patch->state_deps.insert(deps.begin(), deps.end());
+    if (!deps.empty() || calls_method(expr))
+        ctx.item_patch->reads_state = true;
+}
+
 // Collect member reference names from view children (recursive)
 static void collect_member_refs(ASTNode* node, std::vector<std::string>& refs) {
     if (auto comp = dynamic_cast<ComponentInstantiation*>(node)) {
@@ -167,7 +207,39 @@ static void collect_member_refs(ASTNode* node, std::vector<std::string>& refs) {
     }
 }
 
-std::string TextNode::to_webcc() { return "\"" + text + "\""; }
+// Assign every prop of a component instantiation onto `instance_name`
+static void generate_prop_assign_code(std::ostream &ss, std::vector<ComponentProp> &props,
+                                      const std::string &instance_name,
+                                      const std::set<std::string> &method_names)
+{
+    for (auto &prop : props)
+    {
+        std::string val = prop.value->to_webcc();
+        if (prop.is_callback && !prop.callback_param_types.empty())
+        {
+            // Callback with params: generate lambda that forwards args
+            std::string lambda_params = build_lambda_params_from_types(prop.callback_param_types);
+            std::string forward_args = build_forward_args(prop.callback_param_types.size());
+            ss << "        " << instance_name << "." << prop.name << " = [this](" << lambda_params << ") { this->" << val << "(" << forward_args << "); };\n";
+        }
+        else if (method_names.count(val) || prop.is_callback)
+        {
+            // No-param callback or method reference
+            ss << "        " << instance_name << "." << prop.name << " = [this]() { this->" << val << "(); };\n";
+        }
+        else if (prop.is_reference)
+        {
+            // Actual reference: pointer to variable
+            ss << "        " << instance_name << "." << prop.name << " = &(" << val << ");\n";
+        }
+        else
+        {
+            ss << "        " << instance_name << "." << prop.name << " = " << val << ";\n";
+        }
+    }
+}
+
+std::string TextNode::to_webcc() { return to_cpp_string_literal(text); }
 
 std::string ComponentInstantiation::to_webcc() { return ""; }
 
@@ -181,31 +253,7 @@ void ComponentInstantiation::generate_code(ViewCodegenContext& ctx)
         instance_name = member_name;
         
         // Set props on the existing member
-        for (auto &prop : props)
-        {
-            std::string val = prop.value->to_webcc();
-            if (prop.is_callback && !prop.callback_param_types.empty())
-            {
-                // Callback with params: generate lambda that forwards args
-                std::string lambda_params = build_lambda_params_from_types(prop.callback_param_types);
-                std::string forward_args = build_forward_args(prop.callback_param_types.size());
-                ctx.ss << "        " << instance_name << "." << prop.name << " = [this](" << lambda_params << ") { this->" << val << "(" << forward_args << "); };\n";
-            }
-            else if (ctx.method_names.count(val) || prop.is_callback)
-            {
-                // No-param callback or method reference
-                ctx.ss << "        " << instance_name << "." << prop.name << " = [this]() { this->" << val << "(); };\n";
-            }
-            else if (prop.is_reference)
-            {
-                // Actual reference: pointer to variable
-                ctx.ss << "        " << instance_name << "." << prop.name << " = &(" << val << ");\n";
-            }
-            else
-            {
-                ctx.ss << "        " << instance_name << "." << prop.name << " = " << val << ";\n";
-            }
-        }
+        generate_prop_assign_code(ctx.ss, props, instance_name, ctx.method_names);
 
         // Call view on the existing member (component persists, only view is re-rendered)
         if (!ctx.parent.empty())
@@ -236,31 +284,7 @@ void ComponentInstantiation::generate_code(ViewCodegenContext& ctx)
     }
 
     // Set props
-    for (auto &prop : props)
-    {
-        std::string val = prop.value->to_webcc();
-        if (prop.is_callback && !prop.callback_param_types.empty())
-        {
-            // Callback with params: generate lambda that forwards args
-            std::string lambda_params = build_lambda_params_from_types(prop.callback_param_types);
-            std::string forward_args = build_forward_args(prop.callback_param_types.size());
-            ctx.ss << "        " << instance_name << "." << prop.name << " = [this](" << lambda_params << ") { this->" << val << "(" << forward_args << "); };\n";
-        }
-        else if (ctx.method_names.count(val) || prop.is_callback)
-        {
-            // No-param callback or method reference
-            ctx.ss << "        " << instance_name << "." << prop.name << " = [this]() { this->" << val << "(); };\n";
-        }
-        else if (prop.is_reference)
-        {
-            // Actual reference: pointer to variable
-            ctx.ss << "        " << instance_name << "." << prop.name << " = &(" << val << ");\n";
-        }
-        else
-        {
-            ctx.ss << "        " << instance_name << "." << prop.name << " = " << val << ";\n";
-        }
-    }
+    generate_prop_assign_code(ctx.ss, props, instance_name, ctx.method_names);
 
     // For reference props, set up onChange callback
     if (!ctx.in_loop)
@@ -274,7 +298,7 @@ void ComponentInstantiation::generate_code(ViewCodegenContext& ctx)
                 std::set<std::string> prop_deps;
                 prop.value->collect_dependencies(prop_deps);
 
-                std::string update_calls;
+                std::vector<std::string> update_calls;
                 for (const auto &dep : prop_deps)
                 {
                     bool has_dependent_binding = false;
@@ -288,13 +312,13 @@ void ComponentInstantiation::generate_code(ViewCodegenContext& ctx)
                     }
                     if (has_dependent_binding)
                     {
-                        update_calls += "_update_" + dep + "(); ";
+                        update_calls.push_back("_update_" + dep + "();");
                     }
                 }
 
                 if (!update_calls.empty())
                 {
-                    ctx.ss << "        " << instance_name << "." << callback_name << " = [this]() { " << update_calls << "};\n";
+                    ctx.ss << "        " << instance_name << "." << callback_name << " = [this]() {" << schedule_updates_inline(update_calls) << " };\n";
                 }
             }
         }
@@ -324,6 +348,14 @@ std::string HTMLElement::to_webcc() { return ""; }
 // Helper to generate code for a view child node
 static void generate_view_child(ASTNode *child, ViewCodegenContext& ctx)
 {
+    // A reused loop item re-applies its elements' bindings; anything else
+    // (components, conditionals, nested loops) makes it render afresh
+    if (ctx.item_patch && !dynamic_cast<HTMLElement *>(child) && !dynamic_cast<ViewRawElement *>(child) &&
+        !dynamic_cast<TextNode *>(child) && !dynamic_cast<Expression *>(child))
+    {
+        ctx.item_patch->patchable = false;
+    }
+
     if (auto el = dynamic_cast<HTMLElement *>(child))
     {
         el->generate_code(ctx);
@@ -389,6 +421,11 @@ static void generate_view_child(ASTNode *child, ViewCodegenContext& ctx)
             // Use formatter for dynamic content
             std::vector<std::string> parts = {code};
             ctx.ss << "        " << generate_formatter_block(parts, "webcc::dom::create_text_node_deferred(" + text_var + ", ") << "\n";
+            if (ctx.item_patch)
+            {
+                ctx.item_patch->add(text_var, generate_formatter_block(parts, "webcc::dom::set_node_value(" + text_var + ", "));
+                note_item_reads(ctx, expr);
+            }
             
             // Add binding for reactivity (only outside loops)
             if (!ctx.in_loop) {
@@ -399,6 +436,7 @@ static void generate_view_child(ASTNode *child, ViewCodegenContext& ctx)
                 b.expr = expr;
                 expr->collect_dependencies(b.dependencies);
                 expr->collect_member_dependencies(b.member_dependencies);
+                collect_field_dependencies(expr, b.field_dependencies, b.whole_dependencies);
                 ctx.bindings.push_back(b);
             }
         }
@@ -406,6 +444,123 @@ static void generate_view_child(ASTNode *child, ViewCodegenContext& ctx)
     }
 }
 
+static bool is_static_element(HTMLElement *el);
+
+// Whether any element below el has one of these tags
+static bool has_descendant(HTMLElement *el, const std::set<std::string> &tags)
+{
+    for (auto &child : el->children)
+    {
+        auto *child_el = dynamic_cast<HTMLElement *>(child.get());
+        if (child_el && (tags.count(child_el->tag) || has_descendant(child_el, tags)))
+            return true;
+    }
+    return false;
+}
+
+// Whether the browser, parsing el's children as HTML with el as the context,
+// builds another tree than creating them one by one does: rows get a <tbody>
+// wrapped around them, a block closes the <p> it was written in, and a nested
+// <a>, <form> or <button> closes or drops the outer one.
+static bool parser_restructures_children(HTMLElement *el)
+{
+    static const std::set<std::string> table_parents = {"table", "thead", "tbody", "tfoot", "tr", "colgroup"};
+    static const std::set<std::string> closes_p = {
+        "address", "article", "aside", "blockquote", "center", "dd", "details", "dialog", "dir", "div",
+        "dl", "dt", "fieldset", "figcaption", "figure", "footer", "form", "h1", "h2", "h3", "h4", "h5",
+        "h6", "header", "hgroup", "hr", "li", "listing", "main", "menu", "nav", "ol", "p", "plaintext",
+        "pre", "search", "section", "summary", "table", "ul", "xmp"};
+    if (table_parents.count(el->tag))
+        return true;
+    if (el->tag == "p")
+        return has_descendant(el, closes_p);
+    if (el->tag == "a" || el->tag == "form" || el->tag == "button")
+        return has_descendant(el, {el->tag});
+    return false;
+}
+
+static bool is_static_child(ASTNode *child)
+{
+    auto *el = dynamic_cast<HTMLElement *>(child);
+    return dynamic_cast<TextNode *>(child) || (el && is_static_element(el));
+}
+
+// An element is static when nothing about it can change after creation: no ref,
+// no handlers, only plain string attributes and children that are text or static
+// elements themselves. Scripts are left out since inner HTML would not run them,
+// and table parts since the parser drops or moves them outside a table.
+static bool is_static_element(HTMLElement *el)
+{
+    static const std::set<std::string> table_parts = {"table", "caption", "colgroup", "col", "thead",
+                                                      "tbody", "tfoot", "tr", "td", "th"};
+    if (!el->ref_binding.empty() || el->tag == "script" || table_parts.count(el->tag) ||
+        parser_restructures_children(el))
+        return false;
+    for (auto &attr : el->attributes)
+    {
+        auto *str = dynamic_cast<StringLiteral *>(attr.value.get());
+        if (attr.name.rfind("on", 0) == 0 || !str || !str->is_static())
+            return false;
+    }
+    for (auto &child : el->children)
+    {
+        if (!is_static_child(child.get()))
+            return false;
+    }
+    return true;
+}
+
+static bool is_void_element(const std::string &tag)
+{
+    static const std::set<std::string> void_tags = {"area", "base", "br", "col", "embed", "hr", "img",
+                                                    "input", "link", "meta", "source", "track", "wbr"};
+    return void_tags.count(tag) > 0;
+}
+
+static void append_html_escaped(std::string &out, const std::string &text, bool in_attribute)
+{
+    for (char c : text)
+    {
+        if (c == '&') out += "&amp;";
+        else if (c == '<') out += "&lt;";
+        else if (c == '>') out += "&gt;";
+        else if (c == '"' && in_attribute) out += "&quot;";
+        else out += c;
+    }
+}
+
+// Serialize static children as HTML, tagging elements with the component's scope
+// the way create_element_deferred_scoped does.
+static void serialize_static_children(HTMLElement *el, const std::string &scope, std::string &out)
+{
+    for (auto &child : el->children)
+    {
+        if (auto *text = dynamic_cast<TextNode *>(child.get()))
+        {
+            append_html_escaped(out, text->text, false);
+            continue;
+        }
+        auto *child_el = static_cast<HTMLElement *>(child.get());
+        out += "<" + child_el->tag;
+        if (!scope.empty())
+            out += " coi-scope=\"" + scope + "\"";
+        for (auto &attr : child_el->attributes)
+        {
+            std::string value;
+            for (auto &part : static_cast<StringLiteral *>(attr.value.get())->parse())
+                value += part.content;
+            out += " " + attr.name + "=\"";
+            append_html_escaped(out, value, true);
+            out += "\"";
+        }
+        out += ">";
+        if (is_void_element(child_el->tag))
+            continue;
+        serialize_static_children(child_el, scope, out);
+        out += "</" + child_el->tag + ">";
+    }
+}
+
 void HTMLElement::generate_code(ViewCodegenContext& ctx)
 {
     int my_id = ctx.counter++;
@@ -439,6 +594,8 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
     if (!ref_binding.empty())
     {
         ctx.ss << "        " << ref_binding << " = " << var << ";\n";
+        if (ctx.item_patch)
+            ctx.item_patch->patchable = false;
     }
 
     // Attributes
@@ -454,9 +611,9 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
                 std::string capture = build_lambda_capture(ctx.loop_var_name);
                 std::string handler_code = attr.value->to_webcc();
                 if (is_call)
-                    ctx.ss << "        g_dispatcher.set(" << var << ", " << capture << "() { " << handler_code << "; });\n";
+                    emit_loop_handler(ctx, "g_dispatcher", var, capture + "() { " + handler_code + "; }");
                 else
-                    ctx.ss << "        g_dispatcher.set(" << var << ", " << capture << "() { " << handler_code << "(); });\n";
+                    emit_loop_handler(ctx, "g_dispatcher", var, capture + "() { " + handler_code + "(); }");
             }
             else
             {
@@ -472,9 +629,9 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
                 std::string capture = build_lambda_capture(ctx.loop_var_name);
                 std::string handler_code = attr.value->to_webcc();
                 if (is_call)
-                    ctx.ss << "        g_input_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "; });\n";
+                    emit_loop_handler(ctx, "g_input_dispatcher", var, capture + "(const coi::string& _value) { " + handler_code + "; }");
                 else
-                    ctx.ss << "        g_input_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "(_value); });\n";
+                    emit_loop_handler(ctx, "g_input_dispatcher", var, capture + "(const coi::string& _value) { " + handler_code + "(_value); }");
             }
             else
             {
@@ -490,9 +647,9 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
                 std::string capture = build_lambda_capture(ctx.loop_var_name);
                 std::string handler_code = attr.value->to_webcc();
                 if (is_call)
-                    ctx.ss << "        g_change_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "; });\n";
+                    emit_loop_handler(ctx, "g_change_dispatcher", var, capture + "(const coi::string& _value) { " + handler_code + "; }");
                 else
-                    ctx.ss << "        g_change_dispatcher.set(" << var << ", " << capture << "(const coi::string& _value) { " << handler_code << "(_value); });\n";
+                    emit_loop_handler(ctx, "g_change_dispatcher", var, capture + "(const coi::string& _value) { " + handler_code + "(_value); }");
             }
             else
             {
@@ -508,9 +665,9 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
                 std::string capture = build_lambda_capture(ctx.loop_var_name);
                 std::string handler_code = attr.value->to_webcc();
                 if (is_call)
-                    ctx.ss << "        g_keydown_dispatcher.set(" << var << ", " << capture << "(int _keycode) { " << handler_code << "; });\n";
+                    emit_loop_handler(ctx, "g_keydown_dispatcher", var, capture + "(int _keycode) { " + handler_code + "; }");
                 else
-                    ctx.ss << "        g_keydown_dispatcher.set(" << var << ", " << capture << "(int _keycode) { " << handler_code << "(_keycode); });\n";
+                    emit_loop_handler(ctx, "g_keydown_dispatcher", var, capture + "(int _keycode) { " + handler_code + "(_keycode); }");
             }
             else
             {
@@ -520,7 +677,13 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
         else
         {
             std::string val = attr.value->to_webcc();
-            ctx.ss << "        webcc::dom::set_attribute(" << var << ", \"" << attr.name << "\", " << val << ");\n";
+            std::string set = "webcc::dom::set_attribute(" + var + ", \"" + attr.name + "\", " + val + ");";
+            ctx.ss << "        " << set << "\n";
+            if (ctx.item_patch && !attr.value->is_static())
+            {
+                ctx.item_patch->add(var, set);
+                note_item_reads(ctx, attr.value.get());
+            }
 
             if (!attr.value->is_static() && !ctx.in_loop)
             {
@@ -532,6 +695,7 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
                 b.expr = attr.value.get();
                 attr.value->collect_dependencies(b.dependencies);
                 attr.value->collect_member_dependencies(b.member_dependencies);
+                collect_field_dependencies(attr.value.get(), b.field_dependencies, b.whole_dependencies);
                 ctx.bindings.push_back(b);
             }
         }
@@ -554,7 +718,22 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
             has_elements = true;
     }
 
-    if (has_elements)
+    bool static_children = has_elements && !parser_restructures_children(this);
+    for (auto &child : children)
+    {
+        if (!is_static_child(child.get()))
+            static_children = false;
+    }
+
+    if (static_children)
+    {
+        // Markup that never changes is built by the browser in one call instead
+        // of one create/set/append command per node
+        std::string html;
+        serialize_static_children(this, has_scoped_css ? ctx.parent_component_name : "", html);
+        ctx.ss << "        webcc::dom::set_inner_html(" << var << ", " << to_cpp_string_literal(html) << ");\n";
+    }
+    else if (has_elements)
     {
         // Check if there's exactly one child and it's a for-each loop
         if (children.size() == 1) {
@@ -572,6 +751,7 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
     {
         // Text content
         std::string code;
+        std::string fill;  // Formatted text, set in one statement
         bool all_static = true;
         bool generated_inline = false;
 
@@ -593,7 +773,8 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
         {
             generated_inline = true;
             std::vector<std::string> parts = {children[0]->to_webcc()};
-            ctx.ss << "        " << generate_formatter_block(parts, "webcc::dom::set_inner_text(" + var + ", ") << "\n";
+            fill = generate_formatter_block(parts, "webcc::dom::set_inner_text(" + var + ", ");
+            ctx.ss << "        " << fill << "\n";
         }
         else if (children.size() > 1)
         {
@@ -618,7 +799,8 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
                 {
                     parts.push_back(child->to_webcc());
                 }
-                ctx.ss << "        " << generate_formatter_block(parts, "webcc::dom::set_inner_text(" + var + ", ") << "\n";
+                fill = generate_formatter_block(parts, "webcc::dom::set_inner_text(" + var + ", ");
+                ctx.ss << "        " << fill << "\n";
             }
         }
 
@@ -626,6 +808,12 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
         {
             ctx.ss << "        webcc::dom::set_inner_text(" << var << ", " << code << ");\n";
         }
+        if (ctx.item_patch && !fill.empty())
+        {
+            ctx.item_patch->add(var, fill);
+            for (auto &child : children)
+                note_item_reads(ctx, child.get());
+        }
 
         if (!all_static && !ctx.in_loop)
         {
@@ -649,6 +837,7 @@ void HTMLElement::generate_code(ViewCodegenContext& ctx)
             for (auto &child : children) {
                 child->collect_dependencies(b.dependencies);
                 child->collect_member_dependencies(b.member_dependencies);
+                collect_field_dependencies(child.get(), b.field_dependencies, b.whole_dependencies);
             }
             ctx.bindings.push_back(b);
         }
@@ -706,6 +895,40 @@ static void generate_prop_update_code(std::stringstream &ss, ComponentInstantiat
     }
 }
 
+// Generate change-guarded prop updates for a keyed loop item that survived a re-sync.
+// Callback props only forward to `this`, so they are left as assigned at mount.
+static void generate_prop_patch_code(std::stringstream &ss, ComponentInstantiation *comp,
+                                     const std::string &inst_ref,
+                                     const std::set<std::string> &method_names)
+{
+    for (auto &prop : comp->props)
+    {
+        std::string val = prop.value->to_webcc();
+        if (prop.is_callback || method_names.count(val))
+            continue;
+        if (prop.is_reference)
+            val = "&(" + val + ")";
+        std::string field = inst_ref + "." + prop.name;
+        ss << "            if (!__coi_keyed::same(" << field << ", " << val << ")) { "
+           << field << " = " << val << "; " << inst_ref << "._update_" << prop.name << "(); }\n";
+    }
+}
+
+// Handle of the node a top-level child of a kept <if> branch will create, read
+// before the child is generated. The type checker allows only elements and
+// components there.
+static std::string branch_root_handle(ASTNode *child, int counter, std::map<std::string, int> &component_counters)
+{
+    if (auto comp = dynamic_cast<ComponentInstantiation *>(child))
+    {
+        if (comp->is_member_reference)
+            return comp->member_name + "._get_root_element()";
+        std::string qname = qualified_name(comp->module_prefix, comp->component_name);
+        return qname + "_" + std::to_string(component_counters[qname]) + "._get_root_element()";
+    }
+    return "el[" + std::to_string(counter) + "]";
+}
+
 // ViewIfStatement
 void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
 {
@@ -737,6 +960,7 @@ void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
     IfRegion region;
     region.if_id = my_if_id;
     region.condition_code = condition->to_webcc();
+    region.keep = keep;
     condition->collect_dependencies(region.dependencies);
     condition->collect_member_dependencies(region.member_dependencies);
 
@@ -754,6 +978,8 @@ void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
         ctx.loop_regions, ctx.loop_counter, ctx.if_regions, ctx.if_counter, ctx.loop_var_name};
     for (auto &child : then_children)
     {
+        if (keep)
+            region.then_roots.push_back(branch_root_handle(child.get(), ctx.counter, ctx.component_counters));
         generate_view_child(child.get(), then_ctx);
     }
     int counter_after_then = ctx.counter;
@@ -802,6 +1028,8 @@ void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
     {
         for (auto &child : else_children)
         {
+            if (keep)
+                region.else_roots.push_back(branch_root_handle(child.get(), ctx.counter, ctx.component_counters));
             generate_view_child(child.get(), else_ctx);
         }
     }
@@ -860,10 +1088,14 @@ void ViewIfStatement::generate_code(ViewCodegenContext& ctx)
     ctx.ss << "        webcc::dom::create_comment_deferred(_if_" << my_if_id << "_anchor, \"coi-⚓\");\n";
     ctx.ss << "        if (" << strip_outer_parens(region.condition_code) << ") {\n";
     ctx.ss << "        _if_" << my_if_id << "_state = true;\n";
+    if (keep)
+        ctx.ss << "        _if_" << my_if_id << "_then_built = true; _if_" << my_if_id << "_else_built = false;\n";
     // Use original append_child for initial render (before anchor is in DOM)
     ctx.ss << then_ss.str();
     ctx.ss << "        } else {\n";
     ctx.ss << "        _if_" << my_if_id << "_state = false;\n";
+    if (keep)
+        ctx.ss << "        _if_" << my_if_id << "_then_built = false; _if_" << my_if_id << "_else_built = true;\n";
     ctx.ss << else_ss.str();
     ctx.ss << "        }\n";
     // Append anchor after the conditional content
@@ -973,6 +1205,11 @@ void ViewRawElement::generate_code(ViewCodegenContext& ctx)
         ctx.ss << "        webcc::dom::set_inner_html(" << var << ", " << code << ");\n";
     }
 
+    if (!all_static && ctx.item_patch)
+    {
+        ctx.item_patch->patchable = false;
+    }
+
     // Create reactive binding for dynamic content
     if (!all_static && !ctx.in_loop)
     {
@@ -996,6 +1233,7 @@ void ViewRawElement::generate_code(ViewCodegenContext& ctx)
         for (auto &child : children) {
             child->collect_dependencies(b.dependencies);
             child->collect_member_dependencies(b.member_dependencies);
+            collect_field_dependencies(child.get(), b.field_dependencies, b.whole_dependencies);
         }
         ctx.bindings.push_back(b);
     }
@@ -1111,7 +1349,18 @@ void ViewForEachStatement::generate_code(ViewCodegenContext& ctx)
 
     if (ctx.in_loop || !key_expr || !ctx.loop_regions || !ctx.loop_counter)
     {
-        ctx.ss << "        for (auto& " << var_name << " : " << iterable->to_webcc() << ") {\n";
+        if (window_start)
+        {
+            std::string iter = iterable->to_webcc();
+            ctx.ss << "        int _w0, _w1;\n";
+            ctx.ss << "        __coi_keyed::window(" << window_start->to_webcc() << ", " << window_end->to_webcc() << ", (int)" << iter << ".size(), _w0, _w1);\n";
+            ctx.ss << "        for (int _wi = _w0; _wi < _w1; _wi++) {\n";
+            ctx.ss << "        auto& " << var_name << " = " << iter << "[_wi];\n";
+        }
+        else
+        {
+            ctx.ss << "        for (auto& " << var_name << " : " << iterable->to_webcc() << ") {\n";
+        }
         for (auto &child : children)
         {
             auto loop_ctx = ctx.for_loop(ctx.parent, var_name);
@@ -1134,6 +1383,13 @@ void ViewForEachStatement::generate_code(ViewCodegenContext& ctx)
     region.iterable_expr = iterable->to_webcc();
 
     iterable->collect_dependencies(region.dependencies);
+    if (window_start)
+    {
+        region.window_start_expr = window_start->to_webcc();
+        region.window_end_expr = window_end->to_webcc();
+        window_start->collect_dependencies(region.dependencies);
+        window_end->collect_dependencies(region.dependencies);
+    }
 
     ComponentInstantiation *loop_component = nullptr;
     HTMLElement *loop_html_element = nullptr;
@@ -1166,7 +1422,7 @@ void ViewForEachStatement::generate_code(ViewCodegenContext& ctx)
 
     ViewCodegenContext item_ctx{item_ss, loop_parent_var, temp_counter, ctx.event_handlers, ctx.bindings,
         temp_comp_counters, ctx.method_names, ctx.parent_component_name, true,
-        nullptr, nullptr, nullptr, nullptr, var_name};
+        nullptr, nullptr, nullptr, nullptr, var_name, region.is_html_loop ? &region.html_patch : nullptr};
     for (auto &child : children)
     {
         generate_view_child(child.get(), item_ctx);
@@ -1177,6 +1433,28 @@ void ViewForEachStatement::generate_code(ViewCodegenContext& ctx)
     {
         region.root_element_var = "_el_" + std::to_string(root_element_id);
     }
+    // Only an item of one element moves, and is patched, as a unit
+    LoopItemPatch &patch = region.html_patch;
+    patch.single_root = loop_html_element && children.size() == 1;
+    if (!patch.single_root || !patch.patchable)
+    {
+        patch.patchable = false;
+        patch.slots.clear();
+        patch.handlers.clear();
+        patch.code.clear();
+        // Parts that weren't recorded (components, conditionals) may read state too
+        if (loop_html_element)
+        {
+            std::set<std::string> deps;
+            for (auto &child : children)
+                child->collect_dependencies(deps);
+            deps.erase(var_name);
+            patch.state_deps.insert(deps.begin(), deps.end());
+            patch.reads_state = patch.reads_state || !deps.empty();
+        }
+    }
+    // Items follow the state their bindings read, not just the iterable
+    region.dependencies.insert(patch.state_deps.begin(), patch.state_deps.end());
 
     // Generate item update code
     if (loop_component && !region.component_type.empty())
@@ -1186,6 +1464,20 @@ void ViewForEachStatement::generate_code(ViewCodegenContext& ctx)
         region.item_update_code = update_ss.str();
     }
 
+    // A single owned child component per item can be reconciled by key: survivors
+    // are patched and moved, only added/removed keys are mounted/destroyed.
+    if (loop_component && !region.is_member_ref_loop && children.size() == 1)
+    {
+        std::stringstream mount_ss;
+        generate_prop_assign_code(mount_ss, loop_component->props, "_inst", ctx.method_names);
+        mount_ss << "        _inst.view(" << loop_parent_var << ");\n";
+        region.item_mount_code = mount_ss.str();
+
+        std::stringstream patch_ss;
+        generate_prop_patch_code(patch_ss, loop_component, "_inst", ctx.method_names);
+        region.item_patch_code = patch_ss.str();
+    }
+
     region.key_type = "int";
 
     ctx.loop_regions->push_back(region);
@@ -1203,6 +1495,11 @@ void ViewForEachStatement::collect_dependencies(std::set<std::string> &deps)
     iterable->collect_dependencies(deps);
     if (key_expr)
         key_expr->collect_dependencies(deps);
+    if (window_start)
+    {
+        window_start->collect_dependencies(deps);
+        window_end->collect_dependencies(deps);
+    }
     for (auto &child : children)
         child->collect_dependencies(deps);
 }
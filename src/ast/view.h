@@ -2,6 +2,7 @@
 
 #include "node.h"
 #include "expressions.h"
+#include <algorithm>
 #include <map>
 
 struct TextNode : ASTNode {
@@ -29,6 +30,8 @@ struct Binding {
     std::string value_code;
     std::set<std::string> dependencies;
     std::set<MemberDependency> member_dependencies;  // tracks object.member pairs
+    std::map<std::string, std::set<std::string>> field_dependencies;  // var -> fields read (pos.x)
+    std::set<std::string> whole_dependencies;  // vars also read as a whole
     Expression* expr = nullptr;
     int if_region_id = -1;
     bool in_then_branch = true;
@@ -44,6 +47,29 @@ struct ComponentProp {
     std::vector<std::string> callback_param_types;
 };
 
+// What a keyed HTML loop item needs to be reused across syncs, recorded while
+// its creation code is generated. Slots are the element handles an item keeps
+// (stride `slots.size()` in _loop_N_nodes); `code` re-applies everything that
+// depends on the item to those handles. Static structure (element creation,
+// appends, listeners, literal attributes and text) is never repeated.
+struct LoopItemPatch {
+    bool single_root = false;  // Exactly one top-level element, so the item moves as one
+    bool patchable = true;     // Every part is either static or re-appliable
+    std::vector<std::string> slots;
+    std::vector<std::pair<std::string, std::string>> handlers;  // (dispatcher, slot var)
+    std::string code;
+    // Bindings that read more than the item (component state, method calls) can
+    // change while the item doesn't, so a survivor is always patched
+    bool reads_state = false;
+    std::set<std::string> state_deps;
+
+    // A part of the item that `stmt` re-applies to the handle `var`
+    void add(const std::string& var, const std::string& stmt) {
+        if (std::find(slots.begin(), slots.end(), var) == slots.end()) slots.push_back(var);
+        code += stmt + "\n";
+    }
+};
+
 // Struct to track reactive loop regions 
 struct LoopRegion {
     int loop_id;
@@ -60,9 +86,19 @@ struct LoopRegion {
     bool is_keyed = false;
     bool is_member_ref_loop = false;  // True when iterating over component array with <varName/>
     bool is_only_child = false;       // True when loop is the only child of its parent element
+    // Keyed loop over a single child component: props + view() on an existing `_inst`
+    // (mount) and change-guarded prop updates for a surviving `_inst` (patch).
+    // Non-empty mount code enables keyed reconciliation in _sync_loop_X().
+    std::string item_mount_code;
+    std::string item_patch_code;
+    // Keyed loop over one HTML element: the parts a surviving item re-applies
+    LoopItemPatch html_patch;
     std::string key_expr;
     std::string key_type;
     std::string iterable_expr;
+    // <for ... window={start:end}>: only items [start, end) of the iterable are rendered
+    std::string window_start_expr;
+    std::string window_end_expr;
 };
 
 // Struct to track reactive if/else regions
@@ -85,6 +121,11 @@ struct IfRegion {
     std::vector<int> else_if_ids;
     std::vector<std::string> then_member_refs;  // Member component references in then branch
     std::vector<std::string> else_member_refs;  // Member component references in else branch
+    // <if cond keep>: a hidden branch is parked instead of destroyed. The roots are
+    // the handles of each branch's top-level nodes (el[N] or a child's root element).
+    bool keep = false;
+    std::vector<std::string> then_roots;
+    std::vector<std::string> else_roots;
 };
 
 // Context for view code generation - bundles common parameters
@@ -103,12 +144,13 @@ struct ViewCodegenContext {
     std::vector<IfRegion>* if_regions = nullptr;
     int* if_counter = nullptr;
     std::string loop_var_name;
+    LoopItemPatch* item_patch = nullptr;  // Set while generating a keyed HTML loop item
 
     // Create a child context with a new parent element
     ViewCodegenContext with_parent(const std::string& new_parent) const {
         return ViewCodegenContext{ss, new_parent, counter, event_handlers, bindings,
             component_counters, method_names, parent_component_name, in_loop,
-            loop_regions, loop_counter, if_regions, if_counter, loop_var_name};
+            loop_regions, loop_counter, if_regions, if_counter, loop_var_name, item_patch};
     }
 
     // Create a context for loop iteration (in_loop = true, clear region pointers)
@@ -148,6 +190,7 @@ struct ViewIfStatement : ASTNode {
     std::vector<std::unique_ptr<ASTNode>> then_children;
     std::vector<std::unique_ptr<ASTNode>> else_children;
     int if_id = -1;
+    bool keep = false;  // <if cond keep>: park the hidden branch instead of destroying it
 
     void generate_code(ViewCodegenContext& ctx);
     void collect_dependencies(std::set<std::string>& deps) override;
@@ -170,6 +213,8 @@ struct ViewForEachStatement : ASTNode {
     std::string var_name;
     std::unique_ptr<Expression> iterable;
     std::unique_ptr<Expression> key_expr;
+    std::unique_ptr<Expression> window_start;  // Optional window={start:end}
+    std::unique_ptr<Expression> window_end;
     std::vector<std::unique_ptr<ASTNode>> children;
     int loop_id = -1;
     bool is_only_child = false;  // Set by parent HTMLElement if this loop is its only child
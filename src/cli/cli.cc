@@ -203,8 +203,8 @@ int self_upgrade()
     return 0;
 }
 
-// Get the directory where the coi executable is located
-std::filesystem::path get_executable_dir()
+// Get the path of the running coi executable
+std::filesystem::path get_executable_path()
 {
     char path[PATH_MAX];
     
@@ -216,9 +216,9 @@ std::filesystem::path get_executable_dir()
         char real_path[PATH_MAX];
         if (realpath(path, real_path) != nullptr)
         {
-            return fs::path(real_path).parent_path();
+            return fs::path(real_path);
         }
-        return fs::path(path).parent_path();
+        return fs::path(path);
     }
 #else
     // Linux: use /proc/self/exe
@@ -226,13 +226,39 @@ std::filesystem::path get_executable_dir()
     if (len != -1)
     {
         path[len] = '\0';
-        return fs::path(path).parent_path();
+        return fs::path(path);
     }
 #endif
 
     return fs::path();
 }
 
+// Get the directory where the coi executable is located
+std::filesystem::path get_executable_dir()
+{
+    return get_executable_path().parent_path();
+}
+
+// Identify this compiler build: the commit it was built from, plus the size
+// and modification time of the executable, so local rebuilds count as new
+std::string compiler_build_id()
+{
+    std::string id = std::string(GIT_COMMIT_COUNT) + "-" + GIT_COMMIT_HASH;
+    std::error_code ec;
+    fs::path exe = get_executable_path();
+    auto size = fs::file_size(exe, ec);
+    if (!ec)
+    {
+        id += "-" + std::to_string(size);
+    }
+    auto mtime = fs::last_write_time(exe, ec);
+    if (!ec)
+    {
+        id += "-" + std::to_string(mtime.time_since_epoch().count());
+    }
+    return id;
+}
+
 // Get the template directory relative to the executable
 static fs::path get_template_dir(TemplateType template_type)
 {
@@ -705,6 +731,8 @@ void print_help(const char *program_name)
     std::cout << "    " << DIM << "--out, -o <dir>" << RESET << "   Output directory" << std::endl;
     std::cout << "    " << DIM << "--cc-only" << RESET << "         Generate C++ only, skip WASM" << std::endl;
     std::cout << "    " << DIM << "--keep-cc" << RESET << "         Keep generated C++ files" << std::endl;
+    std::cout << "    " << DIM << "--no-cache" << RESET << "        Parse every file, without reading or writing the parse cache" << std::endl;
+    std::cout << "    " << DIM << "-j <n>" << RESET << "            Threads for loading source files (default: all cores)" << std::endl;
     std::cout << "    " << DIM << "--no-watch" << RESET << "        Disable hot reloading (dev only)" << std::endl;
     std::cout << "    " << DIM << "--pkg" << RESET << "             Create a package (init only)" << std::endl;
     std::cout << std::endl;
@@ -53,5 +53,11 @@ void print_version();
 // absolute path when path_only is set. Returns 0 on success, non-zero on error.
 int llms_command(bool path_only);
 
+// Get the path of the running coi executable
+std::filesystem::path get_executable_path();
+
 // Get the directory where the coi executable is located
 std::filesystem::path get_executable_dir();
+
+// Identify the compiler build, for caches that must not outlive it
+std::string compiler_build_id();
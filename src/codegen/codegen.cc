@@ -1,5 +1,6 @@
 #include "codegen.h"
 #include "ast/ast.h"
+#include "ast/codegen_state.h"
 #include "../analysis/feature_detector.h"
 #include "../analysis/dependency_resolver.h"
 #include "json_codegen.h"
@@ -14,6 +15,30 @@ void generate_cpp_code(
     const std::set<std::string> &required_headers,
     const FeatureFlags &features)
 {
+    g_frame_updates = final_app_config.schedule == "frame";
+    // Coalesced WebSocket runs dispatch inside one __coi_sched::Batch
+    g_update_scheduler = g_frame_updates || features.batch || (final_app_config.coalesce && features.websocket);
+
+    g_memo_components.clear();
+    g_memo_slot_counts.clear();
+    for (const auto &name : final_app_config.memo)
+    {
+        bool found = false;
+        for (const auto &comp : all_components)
+        {
+            if (comp.name == name)
+            {
+                g_memo_components.insert(qualified_name(comp.module_name, comp.name));
+                found = true;
+            }
+        }
+        if (!found)
+        {
+            std::cerr << "Error: Memo component '" << name << "' not found." << std::endl;
+            exit(1);
+        }
+    }
+
     // Include required headers
     for (const auto &header : required_headers)
     {
@@ -77,9 +102,17 @@ void generate_cpp_code(
 
     // Client-side route matcher + param parsers (only if a router block is used)
     bool any_router = false;
+    bool any_kept_route = false;
     for (const auto &comp : all_components)
     {
-        if (comp.router) { any_router = true; break; }
+        if (!comp.router)
+            continue;
+        any_router = true;
+        for (const auto &route : comp.router->routes)
+        {
+            if (route.keep > 0)
+                any_kept_route = true;
+        }
     }
     if (any_router)
     {
@@ -120,16 +153,385 @@ void generate_cpp_code(
         out << "    if (s == \"false\") return false;\n";
         out << "    ok = false; return false;\n";
         out << "}\n";
+        if (any_kept_route)
+        {
+            out << "// Pages of a 'keep N' route parked while another route is shown, keyed by\n";
+            out << "// path and ordered from least to most recently used. One page over N is\n";
+            out << "// held until trim(), so parking the old page cannot evict the next one.\n";
+            out << "template<typename T, int N> struct Keep {\n";
+            out << "    T* pages[N + 1] = {};\n";
+            out << "    coi::string paths[N + 1];\n";
+            out << "    int count = 0;\n";
+            out << "    void drop(int i) {\n";
+            out << "        for (; i + 1 < count; i++) { pages[i] = pages[i + 1]; paths[i] = paths[i + 1]; }\n";
+            out << "        count--;\n";
+            out << "    }\n";
+            out << "    // Unpark the page kept for `path`, or nullptr\n";
+            out << "    T* take(const coi::string& path) {\n";
+            out << "        for (int i = 0; i < count; i++) if (paths[i] == path) { T* p = pages[i]; drop(i); return p; }\n";
+            out << "        return nullptr;\n";
+            out << "    }\n";
+            out << "    void put(T* page, const coi::string& path) { pages[count] = page; paths[count] = path; count++; }\n";
+            out << "    // The least recently used page past the cap, or nullptr\n";
+            out << "    T* trim() { if (count <= N) return nullptr; T* p = pages[0]; drop(0); return p; }\n";
+            out << "    T* pop() { return count > 0 ? pages[--count] : nullptr; }\n";
+            out << "};\n";
+        }
+        out << "}\n\n";
+    }
+
+    // Signal listener storage (only if a component declares a signal)
+    bool any_signal = false;
+    for (const auto &comp : all_components)
+    {
+        if (!comp.signals.empty()) { any_signal = true; break; }
+    }
+    if (any_signal)
+    {
+        out << "namespace __coi_signal {\n";
+        out << "// Listeners of one signal, called in subscription order. An id packs the\n";
+        out << "// listener's slot (low 20 bits) with the slot's generation, so removing\n";
+        out << "// through a stale id is a no-op even after the slot was reused. emit() calls\n";
+        out << "// each listener in place. While it runs, add() queues new listeners and\n";
+        out << "// remove() only marks the entry dead; the outermost emit settles both after.\n";
+        out << "template<typename F> struct Listeners {\n";
+        out << "    static constexpr uint32_t DEAD = 0xFFFFFFFFu;\n";
+        out << "    static constexpr uint32_t QUEUED = 0x80000000u;\n";
+        out << "    struct Entry { F fn; uint32_t slot; };\n";
+        out << "    coi::vector<Entry> live;\n";
+        out << "    coi::vector<Entry> queued;\n";
+        out << "    coi::vector<uint32_t> index;  // slot -> position in live, or QUEUED | position in queued\n";
+        out << "    coi::vector<uint32_t> gen;\n";
+        out << "    coi::vector<uint32_t> free_slots;\n";
+        out << "    uint32_t dead = 0;\n";
+        out << "    int depth = 0;\n";
+        out << "    int add(F fn) {\n";
+        out << "        uint32_t s;\n";
+        out << "        if (free_slots.size() > 0) { s = free_slots[free_slots.size() - 1]; free_slots.pop_back(); }\n";
+        out << "        else { s = (uint32_t)gen.size(); gen.push_back(1); index.push_back(0); }\n";
+        out << "        if (depth > 0) { index[s] = QUEUED | (uint32_t)queued.size(); queued.push_back(Entry{coi::move(fn), s}); }\n";
+        out << "        else { index[s] = (uint32_t)live.size(); live.push_back(Entry{coi::move(fn), s}); }\n";
+        out << "        return (int)((gen[s] << 20) | s);\n";
+        out << "    }\n";
+        out << "    void remove(int id) {\n";
+        out << "        uint32_t s = (uint32_t)id & 0xFFFFF;\n";
+        out << "        if (id <= 0 || s >= gen.size() || gen[s] != ((uint32_t)id >> 20)) return;\n";
+        out << "        gen[s] = gen[s] % 2047 + 1;\n";
+        out << "        free_slots.push_back(s);\n";
+        out << "        uint32_t at = index[s];\n";
+        out << "        if (at & QUEUED) queued[at & ~QUEUED].slot = DEAD;\n";
+        out << "        else live[at].slot = DEAD;\n";
+        out << "        dead++;\n";
+        out << "        // Compacting once half the entries are dead keeps removal O(1) amortized\n";
+        out << "        if (depth == 0 && dead * 2 > live.size()) settle();\n";
+        out << "    }\n";
+        out << "    template<typename... A> void emit(const A&... args) {\n";
+        out << "        depth++;\n";
+        out << "        uint32_t n = (uint32_t)live.size();\n";
+        out << "        for (uint32_t i = 0; i < n; i++) {\n";
+        out << "            if (live[i].slot != DEAD) live[i].fn(args...);\n";
+        out << "        }\n";
+        out << "        if (--depth == 0 && (queued.size() > 0 || dead * 2 > live.size())) settle();\n";
+        out << "    }\n";
+        out << "    // Drop dead entries and append the queued ones, keeping order\n";
+        out << "    void settle() {\n";
+        out << "        uint32_t n = 0;\n";
+        out << "        for (uint32_t i = 0; i < live.size(); i++) {\n";
+        out << "            if (live[i].slot == DEAD) continue;\n";
+        out << "            if (n != i) live[n] = coi::move(live[i]);\n";
+        out << "            index[live[n].slot] = n;\n";
+        out << "            n++;\n";
+        out << "        }\n";
+        out << "        while (live.size() > n) live.pop_back();\n";
+        out << "        for (uint32_t i = 0; i < queued.size(); i++) {\n";
+        out << "            if (queued[i].slot == DEAD) continue;\n";
+        out << "            index[queued[i].slot] = (uint32_t)live.size();\n";
+        out << "            live.push_back(coi::move(queued[i]));\n";
+        out << "        }\n";
+        out << "        queued.clear();\n";
+        out << "        dead = 0;\n";
+        out << "    }\n";
+        out << "};\n";
+        out << "}\n\n";
+    }
+
+    // Keyed <for> reconciliation helpers (only if a keyed loop is used)
+    if (features.keyed)
+    {
+        out << "namespace __coi_keyed {\n";
+        out << "// Loop keys are compared as 64-bit identities: integral and enum keys map to\n";
+        out << "// themselves, floats by their bits, strings by FNV-1a.\n";
+        out << "template<typename T> inline uint64_t key(const T& v) { return (uint64_t)(int64_t)v; }\n";
+        out << "inline uint64_t key(double v) { uint64_t b; __builtin_memcpy(&b, &v, sizeof(b)); return b; }\n";
+        out << "inline uint64_t key(float v) { return key((double)v); }\n";
+        out << "inline uint64_t key(const coi::string& s) {\n";
+        out << "    const char* d = s.data(); uint32_t n = s.length();\n";
+        out << "    uint64_t h = 1469598103934665603ULL;\n";
+        out << "    for (uint32_t i = 0; i < n; i++) { h ^= (uint8_t)d[i]; h *= 1099511628211ULL; }\n";
+        out << "    return h;\n";
+        out << "}\n";
+        out << "// True when a surviving item's prop already holds `b` (types without == always patch).\n";
+        out << "template<typename A, typename B> inline bool same(const A& a, const B& b) {\n";
+        out << "    if constexpr (requires { a == b; }) return a == b; else return false;\n";
+        out << "}\n";
+        out << "// Member type without const, for copies of rendered items.\n";
+        out << "template<typename T> struct plain { using type = T; };\n";
+        out << "template<typename T> struct plain<const T> { using type = T; };\n";
+        out << "template<typename T> using plain_t = typename plain<T>::type;\n";
+        out << "// Rendered part [w0, w1) of a window={start:end} loop over n items.\n";
+        out << "inline void window(int start, int end, int n, int& w0, int& w1) {\n";
+        out << "    w0 = start < 0 ? 0 : (start > n ? n : start);\n";
+        out << "    w1 = end < w0 ? w0 : (end > n ? n : end);\n";
+        out << "}\n";
+        out << "inline uint32_t slot_of(uint64_t k, int bits) { return (uint32_t)((k * 0x9E3779B97F4A7C15ULL) >> (64 - bits)); }\n";
+        out << "// Match the new key order `nk` against the rendered order `ok`:\n";
+        out << "//   src[j]  - old index reused by new item j, or -1 when it must be created\n";
+        out << "//   stay[j] - item j lies on the longest increasing run of reused old indices,\n";
+        out << "//             so its node keeps its place; every other survivor is moved\n";
+        out << "//   used[i] - old item i survives; the rest must be destroyed\n";
+        out << "inline void diff(const coi::vector<uint64_t>& ok, const coi::vector<uint64_t>& nk,\n";
+        out << "                 coi::vector<int>& src, coi::vector<uint8_t>& stay, coi::vector<uint8_t>& used) {\n";
+        out << "    int m = (int)ok.size(), n = (int)nk.size();\n";
+        out << "    src.clear(); stay.clear(); used.clear();\n";
+        out << "    src.reserve(n); stay.reserve(n); used.reserve(m);\n";
+        out << "    for (int i = 0; i < m; i++) used.push_back(0);\n";
+        out << "    for (int j = 0; j < n; j++) { src.push_back(-1); stay.push_back(0); }\n";
+        out << "    if (m == 0 || n == 0) return;\n";
+        out << "    // Old key -> index, open addressing at load <= 1/2 (duplicate keys: first wins)\n";
+        out << "    int bits = 2;\n";
+        out << "    while ((1 << bits) < m * 2) bits++;\n";
+        out << "    uint32_t mask = (1u << bits) - 1;\n";
+        out << "    coi::vector<int> slots;\n";
+        out << "    slots.reserve(mask + 1);\n";
+        out << "    for (uint32_t s = 0; s <= mask; s++) slots.push_back(-1);\n";
+        out << "    for (int i = 0; i < m; i++) {\n";
+        out << "        uint32_t s = slot_of(ok[i], bits);\n";
+        out << "        while (slots[s] >= 0 && ok[slots[s]] != ok[i]) s = (s + 1) & mask;\n";
+        out << "        if (slots[s] < 0) slots[s] = i;\n";
+        out << "    }\n";
+        out << "    for (int j = 0; j < n; j++) {\n";
+        out << "        for (uint32_t s = slot_of(nk[j], bits); slots[s] >= 0; s = (s + 1) & mask) {\n";
+        out << "            int i = slots[s];\n";
+        out << "            if (ok[i] != nk[j]) continue;\n";
+        out << "            if (!used[i]) { used[i] = 1; src[j] = i; }\n";
+        out << "            break;\n";
+        out << "        }\n";
+        out << "    }\n";
+        out << "    // Longest increasing subsequence of src (patience sorting with back links)\n";
+        out << "    coi::vector<int> tails, prev;\n";
+        out << "    prev.reserve(n);\n";
+        out << "    for (int j = 0; j < n; j++) {\n";
+        out << "        prev.push_back(-1);\n";
+        out << "        if (src[j] < 0) continue;\n";
+        out << "        int lo = 0, hi = (int)tails.size();\n";
+        out << "        while (lo < hi) { int mid = (lo + hi) >> 1; if (src[tails[mid]] < src[j]) lo = mid + 1; else hi = mid; }\n";
+        out << "        if (lo > 0) prev[j] = tails[lo - 1];\n";
+        out << "        if (lo == (int)tails.size()) tails.push_back(j); else tails[lo] = j;\n";
+        out << "    }\n";
+        out << "    for (int j = tails.empty() ? -1 : tails[tails.size() - 1]; j >= 0; j = prev[j]) stay[j] = 1;\n";
+        out << "}\n";
+        out << "}\n\n";
+    }
+
+    // Deferred updater queue (frame schedule, batch { } and sync { } blocks)
+    if (g_update_scheduler)
+    {
+        out << "namespace __coi_sched {\n";
+        out << "// Components with marked updaters, in the order they were first marked. A\n";
+        out << "// ticket names a queue entry until the drain that runs it (g_base moves past).\n";
+        out << "struct Entry { void* self; void (*run)(void*, uint32_t); };\n";
+        out << "coi::vector<Entry> g_queue;\n";
+        out << "uint32_t g_base = 1;  // Ticket 0: not queued\n";
+        out << "int g_batch = 0;      // Open batch { } blocks\n";
+        out << "inline uint32_t enqueue(void* self, void (*run)(void*, uint32_t)) {\n";
+        out << "    g_queue.push_back({self, run});\n";
+        out << "    return g_base + (uint32_t)g_queue.size() - 1;\n";
+        out << "}\n";
+        out << "inline Entry* find(uint32_t ticket) {\n";
+        out << "    return (ticket >= g_base && ticket - g_base < g_queue.size()) ? &g_queue[ticket - g_base] : nullptr;\n";
+        out << "}\n";
+        out << "inline bool queued(uint32_t ticket, const void* self) { Entry* e = find(ticket); return e && e->self == self; }\n";
+        out << "// A component moved in memory (see _rebind) takes its entry along; a removed one drops it.\n";
+        out << "inline void repoint(uint32_t ticket, void* self) { if (Entry* e = find(ticket)) e->self = self; }\n";
+        out << "inline void cancel(uint32_t ticket, const void* self) { Entry* e = find(ticket); if (e && e->self == self) e->self = nullptr; }\n";
+        out << "inline void drain() {\n";
+        out << "    // Updaters may mark further components; they are appended and run in this pass\n";
+        out << "    for (uint32_t i = 0; i < g_queue.size(); i++) {\n";
+        out << "        Entry e = g_queue[i];\n";
+        out << "        if (e.self) e.run(e.self, g_base + i);\n";
+        out << "    }\n";
+        out << "    g_base += (uint32_t)g_queue.size();\n";
+        out << "    g_queue.clear();\n";
+        out << "}\n";
+        out << "struct Batch {\n";
+        out << "    Batch() { g_batch++; }\n";
+        if (g_frame_updates)
+            out << "    ~Batch() { g_batch--; }  // Drained at the end of the frame\n";
+        else
+            out << "    ~Batch() { if (--g_batch == 0) drain(); }\n";
+        out << "};\n";
+        out << "struct Sync {\n";
+        out << "    ~Sync() { drain(); webcc::flush(); }\n";
+        out << "};\n";
+        out << "}\n\n";
+    }
+
+    // Last-written values of cached bindings (app { memo = [...]; })
+    if (!g_memo_components.empty())
+    {
+        out << "namespace __coi_memo {\n";
+        out << "uint32_t g_written = 0;  // DOM writes made by cached bindings\n";
+        out << "uint32_t g_skipped = 0;  // Writes skipped because the element already shows the value\n";
+        out << "// What one binding last wrote: its element and an FNV-1a hash of the text.\n";
+        out << "// A re-created element has a new handle, so it is always written.\n";
+        out << "struct Slot {\n";
+        out << "    webcc::handle el;\n";
+        out << "    uint64_t hash = 0;\n";
+        out << "    bool same(webcc::handle e, const char* text) {\n";
+        out << "        uint64_t h = 1469598103934665603ULL;\n";
+        out << "        for (const char* p = text; *p; p++) { h ^= (uint8_t)*p; h *= 1099511628211ULL; }\n";
+        out << "        if (el.is_valid() && (int32_t)el == (int32_t)e && hash == h) { g_skipped++; return true; }\n";
+        out << "        el = e; hash = h; g_written++;\n";
+        out << "        return false;\n";
+        out << "    }\n";
+        out << "};\n";
+        out << "}\n\n";
+    }
+
+    // Storage for component arrays (T[] of a component and loop instances).
+    // Items live in chunks that never move: chunk c holds 8 << c items, so a
+    // push never relocates existing items and the `this` their handlers
+    // captured stays valid. Only remove() moves items, and it rebinds them.
+    out << "namespace __coi_stable {\n";
+    out << "template<typename T> struct vector {\n";
+    out << "    static constexpr uint32_t CHUNKS = 27;\n";
+    out << "    T* chunks[CHUNKS] = {};\n";
+    out << "    uint32_t count = 0;\n";
+    out << "    static uint32_t chunk_of(uint32_t i) { return 31 - __builtin_clz((i >> 3) + 1); }\n";
+    out << "    static uint32_t start_of(uint32_t c) { return 8u * ((1u << c) - 1); }\n";
+    out << "    T* slot(uint32_t i) const { uint32_t c = chunk_of(i); return chunks[c] + (i - start_of(c)); }\n";
+    out << "    void alloc(uint32_t c) { if (!chunks[c]) chunks[c] = static_cast<T*>(::operator new(sizeof(T) * (8u << c))); }\n";
+    out << "    T* grow() { alloc(chunk_of(count)); return slot(count); }\n";
+    out << "    void take(vector& o) {\n";
+    out << "        for (uint32_t c = 0; c < CHUNKS; c++) { chunks[c] = o.chunks[c]; o.chunks[c] = nullptr; }\n";
+    out << "        count = o.count; o.count = 0;\n";
+    out << "    }\n";
+    out << "    void release() {\n";
+    out << "        clear();\n";
+    out << "        for (uint32_t c = 0; c < CHUNKS; c++) if (chunks[c]) { ::operator delete(chunks[c]); chunks[c] = nullptr; }\n";
+    out << "    }\n";
+    out << "    vector() = default;\n";
+    out << "    vector(const vector& o) { for (uint32_t i = 0; i < o.count; i++) push_back(o[i]); }\n";
+    out << "    vector(vector&& o) { take(o); }\n";
+    out << "    // Brace init from an array literal, {Row(1), Row(2)}; also backs `arr = {...}`\n";
+    out << "    template<typename... A> requires (sizeof...(A) > 0 && (__is_constructible(T, A&&) && ...))\n";
+    out << "    vector(A&&... items) { reserve(sizeof...(A)); (push_back(T(static_cast<A&&>(items))), ...); }\n";
+    out << "    vector& operator=(const vector& o) { if (this != &o) { clear(); for (uint32_t i = 0; i < o.count; i++) push_back(o[i]); } return *this; }\n";
+    out << "    vector& operator=(vector&& o) { if (this != &o) { release(); take(o); } return *this; }\n";
+    out << "    ~vector() { release(); }\n";
+    out << "    uint32_t size() const { return count; }\n";
+    out << "    bool empty() const { return count == 0; }\n";
+    out << "    T& operator[](uint32_t i) { return *slot(i); }\n";
+    out << "    const T& operator[](uint32_t i) const { return *slot(i); }\n";
+    out << "    T& back() { return *slot(count - 1); }\n";
+    out << "    void reserve(uint32_t n) { for (uint32_t c = 0; c < CHUNKS && start_of(c) < n; c++) alloc(c); }\n";
+    out << "    void push_back(const T& v) { T* p = new (grow()) T(v); count++; p->_tick_attach(); }\n";
+    out << "    void push_back(T&& v) { T* p = new (grow()) T(coi::move(v)); count++; p->_tick_attach(); }\n";
+    out << "    void pop_back() { if (count) slot(--count)->~T(); }\n";
+    out << "    void clear() { while (count) slot(--count)->~T(); }\n";
+    out << "    void remove(int index) {\n";
+    out << "        if (index < 0 || (uint32_t)index >= count) return;\n";
+    out << "        for (uint32_t i = index; i + 1 < count; i++) { *slot(i) = coi::move(*slot(i + 1)); slot(i)->_rebind(); }\n";
+    out << "        pop_back();\n";
+    out << "    }\n";
+    out << "    template<typename V> struct iter {\n";
+    out << "        V* v; uint32_t i;\n";
+    out << "        auto& operator*() const { return (*v)[i]; }\n";
+    out << "        iter& operator++() { i++; return *this; }\n";
+    out << "        bool operator!=(const iter& o) const { return i != o.i; }\n";
+    out << "    };\n";
+    out << "    iter<vector> begin() { return {this, 0}; }\n";
+    out << "    iter<vector> end() { return {this, count}; }\n";
+    out << "    iter<const vector> begin() const { return {this, 0}; }\n";
+    out << "    iter<const vector> end() const { return {this, count}; }\n";
+    out << "};\n";
+    out << "}\n\n";
+
+    // Tick registry: one entry per attached component with a tick block, run
+    // in attach order. A component's Slot names its entry; copies start
+    // unattached, so an entry always belongs to one object at one address.
+    // Detaching leaves a hole that the next run compacts, keeping the order.
+    bool any_user_tick = false;
+    for (const auto &comp : all_components)
+    {
+        for (const auto &m : comp.methods)
+        {
+            if (m.name == "tick")
+                any_user_tick = true;
+        }
+    }
+    if (any_user_tick)
+    {
+        out << "namespace __coi_tick {\n";
+        out << "struct Slot;\n";
+        out << "struct Entry { void* self; void (*run)(void*, double); Slot* slot; bool paused; };\n";
+        out << "coi::vector<Entry> g_entries;\n";
+        out << "bool g_holes = false;\n";
+        out << "struct Slot {\n";
+        out << "    int32_t index = -1;\n";
+        out << "    bool held = false;  // Paused; kept when the component is copied or moved\n";
+        out << "    Slot() = default;\n";
+        out << "    Slot(const Slot& o) : held(o.held) {}\n";
+        out << "    Slot& operator=(const Slot& o) { held = o.held; if (index >= 0) g_entries[index].paused = held; return *this; }\n";
+        out << "    ~Slot() { detach(); }\n";
+        out << "    void attach(void* self, void (*run)(void*, double)) {\n";
+        out << "        if (index >= 0) return;\n";
+        out << "        index = (int32_t)g_entries.size();\n";
+        out << "        g_entries.push_back({self, run, this, held});\n";
+        out << "    }\n";
+        out << "    void detach() {\n";
+        out << "        if (index < 0) return;\n";
+        out << "        g_entries[index].slot = nullptr;\n";
+        out << "        g_holes = true;\n";
+        out << "        index = -1;\n";
+        out << "    }\n";
+        out << "    // Back the pauseTick()/resumeTick() component methods\n";
+        out << "    void pause() { held = true; if (index >= 0) g_entries[index].paused = true; }\n";
+        out << "    void resume() { held = false; if (index >= 0) g_entries[index].paused = false; }\n";
+        out << "};\n";
+        out << "inline void compact() {\n";
+        out << "    uint32_t n = 0;\n";
+        out << "    for (uint32_t i = 0; i < g_entries.size(); i++) {\n";
+        out << "        if (!g_entries[i].slot) continue;\n";
+        out << "        g_entries[n] = g_entries[i];\n";
+        out << "        g_entries[n].slot->index = (int32_t)n;\n";
+        out << "        n++;\n";
+        out << "    }\n";
+        out << "    while (g_entries.size() > n) g_entries.pop_back();\n";
+        out << "    g_holes = false;\n";
+        out << "}\n";
+        out << "// Tick every attached, unpaused component. Entries attached during the\n";
+        out << "// pass start next frame; detached ones are skipped. True if any ran.\n";
+        out << "inline bool run(double dt) {\n";
+        out << "    if (g_holes) compact();\n";
+        out << "    bool ran = false;\n";
+        out << "    uint32_t n = (uint32_t)g_entries.size();\n";
+        out << "    for (uint32_t i = 0; i < n; i++) {\n";
+        out << "        Entry e = g_entries[i];\n";
+        out << "        if (e.slot && !e.paused) { e.run(e.self, dt); ran = true; }\n";
+        out << "    }\n";
+        out << "    return ran;\n";
+        out << "}\n";
         out << "}\n\n";
     }
 
     // Sort components topologically so dependencies come first
     auto sorted_components = topological_sort_components(all_components);
 
-    // Emit JSON runtime helpers inline if Json.parse is used
-    if (features.json)
+    // Emit JSON runtime helpers inline if Json.parse or Json.stringify is used
+    if (features.json || features.json_stringify)
     {
-        emit_json_runtime(out);
+        emit_json_runtime(out, features.json, features.json_stringify);
     }
     out << "\n";
 
@@ -163,40 +565,107 @@ void generate_cpp_code(
     // Generic event dispatcher template (only if needed)
     if (needs_dispatcher(features))
     {
-        out << "template<typename Callback, int MaxListeners = 64>\n";
+        // Open-addressing table keyed by handle id: linear probing, grows at 3/4
+        // load, and removal shifts the rest of the probe run back so no
+        // tombstones build up. While a callback runs nothing it could live in is
+        // moved or destroyed: removing or replacing an entry leaves a tombstone,
+        // growing copies the callbacks and keeps the old arrays, and the table
+        // is compacted once the outermost dispatch returns.
+        out << "template<typename Callback, int InitialCapacity = 64>\n";
         out << "struct Dispatcher {\n";
-        out << "    int32_t handles[MaxListeners];\n";
-        out << "    Callback callbacks[MaxListeners];\n";
+        out << "    static_assert((InitialCapacity & (InitialCapacity - 1)) == 0, \"capacity must be a power of two\");\n";
+        out << "    static constexpr int32_t EMPTY = -1;\n";
+        out << "    static constexpr int32_t REMOVED = -2;  // Tombstone, only while dispatching\n";
+        out << "    int32_t* handles = nullptr;\n";
+        out << "    Callback* callbacks = nullptr;\n";
+        out << "    uint32_t capacity = 0;\n";
+        out << "    uint32_t shift = 32;\n";
         out << "    int count = 0;\n";
-        out << "    void set(webcc::handle h, Callback cb) {\n";
-        out << "        int32_t hid = (int32_t)h;\n";
-        out << "        for (int i = 0; i < count; i++) {\n";
-        out << "            if (handles[i] == hid) { callbacks[i] = cb; return; }\n";
+        out << "    int tombs = 0;\n";
+        out << "    int depth = 0;\n";
+        out << "    int retired = 0;\n";
+        out << "    int32_t* retired_handles[32];\n";
+        out << "    Callback* retired_callbacks[32];\n";
+        out << "#ifndef NDEBUG\n";
+        out << "    uint64_t lookups = 0;\n";
+        out << "    uint64_t probes = 0;     // Slots visited past the home slot, over all lookups\n";
+        out << "    uint32_t max_probe = 0;  // Longest probe run seen\n";
+        out << "#endif\n";
+        out << "    uint32_t home(int32_t hid) const { return ((uint32_t)hid * 2654435761u) >> shift; }\n";
+        out << "    // Slot holding hid, or the empty slot where it would go\n";
+        out << "    uint32_t find(int32_t hid) {\n";
+        out << "        uint32_t mask = capacity - 1, i = home(hid), n = 0;\n";
+        out << "        while (handles[i] != EMPTY && handles[i] != hid) { i = (i + 1) & mask; n++; }\n";
+        out << "#ifndef NDEBUG\n";
+        out << "        lookups++; probes += n; if (n > max_probe) max_probe = n;\n";
+        out << "#endif\n";
+        out << "        return i;\n";
+        out << "    }\n";
+        out << "    void rehash(uint32_t new_capacity) {\n";
+        out << "        uint32_t old_capacity = capacity;\n";
+        out << "        int32_t* old_handles = handles;\n";
+        out << "        Callback* old_callbacks = callbacks;\n";
+        out << "        capacity = new_capacity;\n";
+        out << "        shift = 32 - __builtin_ctz(capacity);\n";
+        out << "        handles = new int32_t[capacity];\n";
+        out << "        callbacks = new Callback[capacity];\n";
+        out << "        for (uint32_t i = 0; i < capacity; i++) handles[i] = EMPTY;\n";
+        out << "        for (uint32_t i = 0; i < old_capacity; i++) {\n";
+        out << "            if (old_handles[i] < 0) continue;\n";
+        out << "            uint32_t j = find(old_handles[i]);\n";
+        out << "            handles[j] = old_handles[i];\n";
+        out << "            if (depth > 0) callbacks[j] = old_callbacks[i];\n";
+        out << "            else callbacks[j] = coi::move(old_callbacks[i]);\n";
         out << "        }\n";
-        out << "        if (count < MaxListeners) {\n";
-        out << "            handles[count] = hid;\n";
-        out << "            callbacks[count] = cb;\n";
-        out << "            count++;\n";
+        out << "        tombs = 0;\n";
+        out << "        if (!old_capacity) return;\n";
+        out << "        if (depth > 0) { retired_handles[retired] = old_handles; retired_callbacks[retired++] = old_callbacks; }\n";
+        out << "        else { delete[] old_handles; delete[] old_callbacks; }\n";
+        out << "    }\n";
+        out << "    void bury(uint32_t i) { handles[i] = REMOVED; tombs++; count--; }\n";
+        out << "    void set(webcc::handle h, Callback cb) {\n";
+        out << "        if ((uint32_t)(count + tombs + 1) * 4 > capacity * 3) rehash(capacity ? capacity * 2 : InitialCapacity);\n";
+        out << "        uint32_t i = find((int32_t)h);\n";
+        out << "        if (handles[i] != EMPTY) {\n";
+        out << "            if (depth == 0) { callbacks[i] = cb; return; }\n";
+        out << "            // The callback being replaced may be the one running\n";
+        out << "            bury(i);\n";
+        out << "            set(h, cb);\n";
+        out << "            return;\n";
         out << "        }\n";
+        out << "        handles[i] = (int32_t)h;\n";
+        out << "        callbacks[i] = cb;\n";
+        out << "        count++;\n";
         out << "    }\n";
         out << "    void remove(webcc::handle h) {\n";
-        out << "        int32_t hid = (int32_t)h;\n";
-        out << "        for (int i = 0; i < count; i++) {\n";
-        out << "            if (handles[i] == hid) {\n";
-        out << "                handles[i] = handles[count-1];\n";
-        out << "                callbacks[i] = callbacks[count-1];\n";
-        out << "                count--;\n";
-        out << "                return;\n";
-        out << "            }\n";
+        out << "        if (!count) return;\n";
+        out << "        uint32_t mask = capacity - 1, i = find((int32_t)h);\n";
+        out << "        if (handles[i] == EMPTY) return;\n";
+        out << "        if (depth > 0) { bury(i); return; }\n";
+        out << "        for (uint32_t j = (i + 1) & mask; handles[j] != EMPTY; j = (j + 1) & mask) {\n";
+        out << "            uint32_t k = home(handles[j]);\n";
+        out << "            // Entry j stays if its home slot lies cyclically in (i, j]\n";
+        out << "            if (i <= j ? (i < k && k <= j) : (i < k || k <= j)) continue;\n";
+        out << "            handles[i] = handles[j];\n";
+        out << "            callbacks[i] = coi::move(callbacks[j]);\n";
+        out << "            i = j;\n";
         out << "        }\n";
+        out << "        handles[i] = EMPTY;\n";
+        out << "        callbacks[i] = Callback();\n";
+        out << "        count--;\n";
         out << "    }\n";
         out << "    template<typename... Args>\n";
         out << "    bool dispatch(webcc::handle h, Args&&... args) {\n";
-        out << "        int32_t hid = (int32_t)h;\n";
-        out << "        for (int i = 0; i < count; i++) {\n";
-        out << "            if (handles[i] == hid) { callbacks[i](args...); return true; }\n";
+        out << "        if (!count) return false;\n";
+        out << "        uint32_t i = find((int32_t)h);\n";
+        out << "        if (handles[i] == EMPTY) return false;\n";
+        out << "        depth++;\n";
+        out << "        callbacks[i](args...);\n";
+        out << "        if (--depth == 0) {\n";
+        out << "            while (retired > 0) { retired--; delete[] retired_handles[retired]; delete[] retired_callbacks[retired]; }\n";
+        out << "            if (tombs) rehash(capacity);\n";
         out << "        }\n";
-        out << "        return false;\n";
+        out << "        return true;\n";
         out << "    }\n";
         out << "};\n\n";
     }
@@ -222,6 +691,7 @@ void generate_cpp_code(
             }
         }
         session.component_info[qualified_name(comp->module_name, comp->name)] = info;
+        ComponentTypeContext::instance().component_types.insert(qualified_name(comp->module_name, comp->name));
     }
 
     // Populate global data type names for module-level type resolution
@@ -334,6 +804,34 @@ void generate_cpp_code(
         out << "\n";
     }
 
+    // Output Json.stringify serializers for every data type and enum
+    if (features.json_stringify)
+    {
+        std::vector<std::string> data_types;
+        std::vector<JsonEnum> enums;
+        for (const auto &data_def : all_global_data)
+        {
+            data_types.push_back(qualified_name(data_def->module_name, data_def->name));
+        }
+        for (const auto &enum_def : all_global_enums)
+        {
+            enums.push_back({qualified_name(enum_def->module_name, enum_def->name), enum_def->values});
+        }
+        for (const auto &comp : all_components)
+        {
+            std::string prefix = qualified_name(comp.module_name, comp.name) + "_";
+            for (const auto &data_def : comp.data)
+            {
+                data_types.push_back(prefix + data_def->name);
+            }
+            for (const auto &enum_def : comp.enums)
+            {
+                enums.push_back({prefix + enum_def->name, enum_def->values});
+            }
+        }
+        out << generate_json_writers(data_types, enums) << "\n";
+    }
+
     // Forward declarations
     for (auto *comp : sorted_components)
     {
@@ -350,6 +848,12 @@ void generate_cpp_code(
         out << comp->to_webcc(session);
     }
 
+    // Skipped and performed writes are counted at runtime (Memo.skipped(), Memo.written())
+    for (const auto &[comp_name, slots] : g_memo_slot_counts)
+    {
+        std::cerr << "Memo: " << comp_name << " caches " << slots << " binding" << (slots == 1 ? "" : "s") << std::endl;
+    }
+
     if (final_app_config.root_component.empty())
     {
         std::cerr << "Error: No root component defined. Use 'app { root = ComponentName }' to define the entry point." << std::endl;
@@ -387,33 +891,142 @@ void generate_cpp_code(
         out << "coi::string g_app_get_route() { return \"\"; }\n";
     }
 
-    out << "void dispatch_events(const webcc::Event* events, uint32_t event_count) {\n";
-    out << "    for (uint32_t i = 0; i < event_count; i++) {\n";
-    out << "        const auto& e = events[i];\n";
+    // Polled events wait in a growable ring. Each frame dispatches from the
+    // front until the time budget runs out; the rest keep their place for the
+    // next frame, with their strings copied because webcc reuses its buffer.
+    bool coalesce_input = final_app_config.coalesce && (features.input || features.change);
+    bool batch_messages = final_app_config.coalesce && features.websocket;
+    out << "namespace __coi_events {\n";
+    out << "uint32_t g_dispatched = 0;  // Events handed to their handlers\n";
+    out << "uint32_t g_coalesced = 0;   // Input/change events replaced by a later one on the same element\n";
+    out << "uint32_t g_deferred = 0;    // Times an event waited a frame because the budget ran out\n";
+    out << "struct Queued { webcc::Event e; coi::string text; bool owned = false; };\n";
+    out << "struct Ring {\n";
+    out << "    Queued* items = nullptr;\n";
+    out << "    uint32_t cap = 0, head = 0, count = 0;\n";
+    out << "    Queued& at(uint32_t i) { return items[(head + i) & (cap - 1)]; }\n";
+    out << "    void grow() {\n";
+    out << "        uint32_t next_cap = cap ? cap * 2 : 64;\n";
+    out << "        Queued* next = new Queued[next_cap];\n";
+    out << "        for (uint32_t i = 0; i < count; i++) next[i] = coi::move(at(i));\n";
+    out << "        delete[] items;\n";
+    out << "        items = next; cap = next_cap; head = 0;\n";
+    out << "    }\n";
+    out << "    void push(const webcc::Event& e) {\n";
+    out << "        if (count == cap) grow();\n";
+    out << "        Queued& q = at(count++);\n";
+    out << "        q.e = e; q.owned = false;\n";
+    out << "    }\n";
+    out << "    void pop() { head = (head + 1) & (cap - 1); count--; }\n";
+    out << "};\n";
+    out << "Ring g_queue;\n";
+    out << "// own: copy the event's string into q.text; then point the event at the copy\n";
+    out << "template<typename S> void keep(S& field, Queued& q, bool own) {\n";
+    out << "    if (own && !q.owned) { q.text = coi::string(field); q.owned = true; }\n";
+    out << "    if (q.owned) field = S(q.text.c_str());\n";
+    out << "}\n";
+    out << "void keep_text(Queued& q, bool own) {\n";
+    emit_feature_event_text(out, features);
+    out << "}\n";
+    if (coalesce_input)
+    {
+        // Back-to-back input (or change) events of one element: only the last value matters
+        out << "bool replaces(const webcc::Event& a, const webcc::Event& b) {\n";
+        out << "    if (a.opcode != b.opcode) return false;\n";
+        if (features.input)
+        {
+            out << "    if (auto x = a.as<webcc::dom::InputEvent>()) return (int32_t)x->handle == (int32_t)b.as<webcc::dom::InputEvent>()->handle;\n";
+        }
+        if (features.change)
+        {
+            out << "    if (auto x = a.as<webcc::dom::ChangeEvent>()) return (int32_t)x->handle == (int32_t)b.as<webcc::dom::ChangeEvent>()->handle;\n";
+        }
+        out << "    return false;\n";
+        out << "}\n";
+    }
+    out << "void push(const webcc::Event& e) {\n";
+    if (coalesce_input)
+    {
+        out << "    if (g_queue.count > 0 && replaces(g_queue.at(g_queue.count - 1).e, e)) {\n";
+        out << "        Queued& last = g_queue.at(g_queue.count - 1);\n";
+        out << "        last.e = e; last.owned = false;\n";
+        out << "        g_coalesced++;\n";
+        out << "        return;\n";
+        out << "    }\n";
+    }
+    out << "    g_queue.push(e);\n";
+    out << "}\n";
+    out << "}\n\n";
+
+    out << "void dispatch_event(__coi_events::Queued& q) {\n";
+    out << "    __coi_events::keep_text(q, false);\n";
+    out << "    __coi_events::g_dispatched++;\n";
+    out << "    const auto& e = q.e;\n";
+    out << "    {\n";
     out << "        if (false) {\n"; // Dummy to allow all handlers to use "} else if"
     emit_feature_event_handlers(out, features);
     out << "        }\n";
     out << "    }\n";
     out << "}\n\n";
 
+    out << "void dispatch_events() {\n";
+    out << "    auto& q = __coi_events::g_queue;\n";
+    out << "    double start = webcc::system::get_time();\n";
+    out << "    uint32_t n = 0;\n";
+    out << "    // Check the clock every 8 events, so a frame always makes progress\n";
+    out << "    auto over_budget = [&]() { return n > 0 && (n & 7) == 0 && webcc::system::get_time() - start > " << final_app_config.event_budget << "; };\n";
+    out << "    while (q.count > 0 && !over_budget()) {\n";
+    if (batch_messages)
+    {
+        // A run of WebSocket messages updates the view once, after the last one
+        // dispatched this frame; a run longer than the budget goes on next frame
+        out << "        if (q.at(0).e.opcode == webcc::websocket::MessageEvent::OPCODE) {\n";
+        out << "            __coi_sched::Batch _batch;\n";
+        out << "            while (q.count > 0 && q.at(0).e.opcode == webcc::websocket::MessageEvent::OPCODE && !over_budget()) {\n";
+        out << "                dispatch_event(q.at(0));\n";
+        out << "                q.pop();\n";
+        out << "                n++;\n";
+        out << "            }\n";
+        out << "            continue;\n";
+        out << "        }\n";
+    }
+    out << "        dispatch_event(q.at(0));\n";
+    out << "        q.pop();\n";
+    out << "        n++;\n";
+    out << "    }\n";
+    out << "    // Out of budget: the rest keep their place for the next frame\n";
+    out << "    for (uint32_t i = 0; i < q.count; i++) __coi_events::keep_text(q.at(i), true);\n";
+    out << "    __coi_events::g_deferred += q.count;\n";
+    out << "}\n\n";
+
     out << "void update_wrapper(double time) {\n";
     out << "    static double last_time = 0;\n";
     out << "    double dt = (time - last_time) / 1000.0;\n";
     out << "    last_time = time;\n";
     out << "    if (dt > 0.1) dt = 0.1; // Cap dt to avoid huge jumps\n";
-    out << "    static webcc::Event events[64];\n";
-    out << "    uint32_t count = 0;\n";
     out << "    webcc::Event e;\n";
-    out << "    while (webcc::poll_event(e) && count < 64) {\n";
-    out << "        events[count++] = e;\n";
-    out << "    }\n";
-    out << "    dispatch_events(events, count);\n";
-    
-    // Only call tick if the root component has a tick method
-    if (session.components_with_tick.count(root_qualified))
+    out << "    while (webcc::poll_event(e)) __coi_events::push(e);\n";
+    // A frame with no events, nothing ticking and no pending route or updates
+    // returns before drain and flush, so an idle app only polls. webcc has no way to wake the module
+    // on an event, so the frame callback itself stays registered.
+    out << "    bool busy = __coi_events::g_queue.count > 0;\n";
+    out << "    if (busy) dispatch_events();\n";
+
+    // Run the tick registry if any component has a tick block. Ticking pauses
+    // while the page is hidden and resumes with a capped dt.
+    if (any_user_tick)
+    {
+        out << "    if (!__coi_tick::g_entries.empty() && !webcc::system::is_hidden() && __coi_tick::run(dt)) busy = true;\n";
+    }
+    if (features.router)
     {
-        out << "    if (app) app->tick(dt);\n";
+        out << "    if (app && app->_route_dirty) busy = true;\n";
     }
+    if (g_frame_updates)
+    {
+        out << "    if (!__coi_sched::g_queue.empty()) busy = true;\n";
+    }
+    out << "    if (!busy) return;\n";
     if (features.router)
     {
         // Apply any route change requested during event dispatch or tick.
@@ -421,6 +1034,11 @@ void generate_cpp_code(
         // the stack when its component gets destroyed (see emit_router.cc).
         out << "    if (app) app->_apply_route();\n";
     }
+    if (g_frame_updates)
+    {
+        // Run every updater marked during this frame's events and tick, once
+        out << "    __coi_sched::drain();\n";
+    }
     out << "    webcc::flush();\n";
     out << "}\n\n";
 
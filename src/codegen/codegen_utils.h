@@ -21,6 +21,20 @@ inline std::string strip_outer_parens(const std::string& expr) {
     return expr;
 }
 
+// Quote text as a C++ string literal. View text and string literals both go
+// through here, so the same characters reach the page on every code path
+inline std::string to_cpp_string_literal(const std::string& s) {
+    std::string out = "\"";
+    for (char c : s) {
+        if (c == '"') out += "\\\"";
+        else if (c == '\\') out += "\\\\";
+        else if (c == '\n') out += "\\n";
+        else if (c == '\t') out += "\\t";
+        else out += c;
+    }
+    return out + "\"";
+}
+
 // Generate a lambda wrapper for a member function reference
 // type: "webcc::function<void(webcc::string)>"
 // method_name: "handleNoopEvent"
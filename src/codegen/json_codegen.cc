@@ -6,6 +6,8 @@
 #include <cstdint>
 #include <sstream>
 #include <cctype>
+#include <map>
+#include <set>
 
 // ============================================================================
 // DataTypeRegistry Implementation
@@ -38,7 +40,7 @@ std::string generate_meta_struct(const std::string& data_type) {
     if (!fields) return "";
     
     std::stringstream ss;
-    ss << "struct " << data_type << "Meta : __coi_json::MetaBase {\n";
+    ss << "struct " << data_type << "Meta : __coi_json::MetaBase<" << fields->size() << "> {\n";
     
     // Generate has_fieldName() methods for each field
     uint32_t i = 0;
@@ -63,33 +65,6 @@ std::string generate_meta_struct(const std::string& data_type) {
 // JSON Parse Code Generation
 // ============================================================================
 
-// Map Coi types to extraction calls
-static std::string get_extractor(const std::string& type, const std::string& pos_var) {
-    if (type == "string") {
-        return "__coi_json::ext_str(_s, " + pos_var + ", _len)";
-    }
-    if (type == "int") {
-        return "__coi_json::ext_int(_s, " + pos_var + ", _len, _ok)";
-    }
-    if (type == "float") {
-        return "__coi_json::ext_float(_s, " + pos_var + ", _len, _ok)";
-    }
-    if (type == "bool") {
-        return "__coi_json::ext_bool(_s, " + pos_var + ", _len, _ok)";
-    }
-    // Nested data type - will need recursive parsing
-    if (!type.empty() && std::isupper(type[0])) {
-        return "__json_parse_" + type + "(_s + " + pos_var + ", _len - " + pos_var + ")";
-    }
-    // Array types handled separately
-    return "";
-}
-
-// Check if type needs the _ok variable
-static bool needs_ok_var(const std::string& type) {
-    return type == "int" || type == "float" || type == "bool";
-}
-
 // Check if type is an array
 static bool is_array_type(const std::string& type) {
     return type.size() > 2 && type.substr(type.size() - 2) == "[]";
@@ -100,6 +75,16 @@ static std::string get_array_element_type(const std::string& type) {
     return type.substr(0, type.size() - 2);
 }
 
+// Check if type is a registered data type (parsed as a nested object)
+static bool is_data_type(const std::string& type) {
+    return !type.empty() && std::isupper(type[0]) && DataTypeRegistry::instance().lookup(type);
+}
+
+// Check if type is read by one of the runtime's get_* scalar readers
+static bool is_scalar_type(const std::string& type) {
+    return type == "string" || type == "int" || type == "float" || type == "bool";
+}
+
 // Convert type names like App_User[] to valid C++ identifier suffixes.
 static std::string sanitize_type_for_symbol(const std::string& type) {
     std::string symbol;
@@ -131,180 +116,170 @@ std::string generate_field_token_constants(const std::string& data_type) {
     return ss.str();
 }
 
-// Forward declaration. `depth` suffixes the emitted locals (_nv0, _fp1, ...) so
-// nested objects don't reuse an enclosing scope's names. Without it, three-deep
-// nesting emits `auto _nv = isolate(_nv.data(), ...)`, which won't compile.
-static void generate_object_fields_parse(std::stringstream& ss,
-                                          const std::string& data_type,
-                                          const std::string& result_var,
-                                          const std::string& meta_var,
-                                          const std::string& src_var,
-                                          const std::string& len_var,
-                                          const std::string& ok_var,
-                                          const std::string& indent,
-                                          int depth);
-
-// Generate inline parsing code for a single primitive field
-static void generate_primitive_field_parse(std::stringstream& ss,
-                                            const std::string& field_type,
-                                            const std::string& field_name,
-                                            uint32_t field_idx,
-                                            const std::string& result_var,
-                                            const std::string& meta_var,
-                                            const std::string& src_var,
-                                            const std::string& pos_var,
-                                            const std::string& len_var,
-                                            const std::string& ok_var,
-                                            const std::string& indent) {
-    ss << indent << "if (!__coi_json::is_null(" << src_var << ", " << pos_var << ", " << len_var << ")) {\n";
-    if (field_type == "string") {
-        ss << indent << "    " << result_var << "." << field_name << " = __coi_json::ext_str(" << src_var << ", " << pos_var << ", " << len_var << ");\n";
-        ss << indent << "    " << meta_var << ".set(" << field_idx << ");\n";
-    } else {
-        ss << indent << "    " << result_var << "." << field_name << " = __coi_json::ext_" << field_type << "(" << src_var << ", " << pos_var << ", " << len_var << ", " << ok_var << ");\n";
-        ss << indent << "    if (" << ok_var << ") " << meta_var << ".set(" << field_idx << ");\n";
-    }
-    ss << indent << "}\n";
-}
+// The generated parser walks the document once with a single cursor `_p`
+// (runtime helpers take it by reference and leave it past what they read).
+// Malformed structure sets `_bad`, which stops every enclosing walk; a value
+// of the wrong type is skipped and its field left unset in the meta.
 
-// Generate inline parsing code for an array field
-static void generate_array_field_parse(std::stringstream& ss,
-                                        const std::string& elem_type,
-                                        const std::string& field_name,
-                                        uint32_t field_idx,
-                                        const std::string& result_var,
-                                        const std::string& meta_var,
-                                        const std::string& src_var,
-                                        const std::string& pos_var,
-                                        const std::string& len_var,
-                                        const std::string& indent,
-                                        int depth) {
-    std::string d = std::to_string(depth);
-    std::string arr_view = "_arr_view" + d;
-    std::string aes = "_aes" + d, aep = "_aep" + d, aelen = "_aelen" + d;
-    std::string aok = "_aok" + d;
-    std::string ae_view = "_ae_view" + d, ae = "_ae" + d, ae_meta = "_ae_meta" + d, ae_ok = "_ae_ok" + d;
-
-    ss << indent << "auto " << arr_view << " = __coi_json::isolate(" << src_var << ", " << pos_var << ", " << len_var << ");\n";
-    ss << indent << "if (" << arr_view << ".length() > 0) {\n";
-    ss << indent << "    __coi_json::for_each(" << arr_view << ".data(), 0, " << arr_view << ".length(), [&](const char* " << aes << ", uint32_t " << aep << ", uint32_t " << aelen << ") {\n";
-
-    if (elem_type == "string") {
-        ss << indent << "        " << result_var << "." << field_name << ".push_back(__coi_json::ext_str(" << aes << ", " << aep << ", " << aelen << "));\n";
-    } else if (elem_type == "int" || elem_type == "float" || elem_type == "bool") {
-        ss << indent << "        bool " << aok << ";\n";
-        ss << indent << "        " << result_var << "." << field_name << ".push_back(__coi_json::ext_" << elem_type << "(" << aes << ", " << aep << ", " << aelen << ", " << aok << "));\n";
-    } else if (!elem_type.empty() && std::isupper(elem_type[0]) && DataTypeRegistry::instance().lookup(elem_type)) {
-        // Nested data type array
-        ss << indent << "        auto " << ae_view << " = __coi_json::isolate(" << aes << ", " << aep << ", " << aelen << ");\n";
-        ss << indent << "        if (" << ae_view << ".length() > 0) {\n";
-        ss << indent << "            " << elem_type << " " << ae << "{};\n";
-        ss << indent << "            " << elem_type << "Meta " << ae_meta << "{};\n";
-        ss << indent << "            bool " << ae_ok << ";\n";
-        generate_object_fields_parse(ss, elem_type, ae, ae_meta,
-                                     ae_view + ".data()", ae_view + ".length()", ae_ok,
-                                     indent + "            ", depth + 1);
-        ss << indent << "            " << result_var << "." << field_name << ".push_back(" << ae << ");\n";
-        ss << indent << "        }\n";
-    }
-
-    ss << indent << "    });\n";
-    ss << indent << "    " << meta_var << ".set(" << field_idx << ");\n";
-    ss << indent << "}\n";
+// Forward declaration. `depth` suffixes the emitted locals (_k0, _kl1, ...) so
+// nested objects don't reuse an enclosing scope's names.
+static void generate_object_parse(std::stringstream& ss,
+                                  const std::string& data_type,
+                                  const std::string& result_var,
+                                  const std::string& meta_var,
+                                  const std::string& indent,
+                                  int depth);
+
+// Code run when a value can't be read as the expected type: null is left
+// unset, anything else is skipped whole.
+static std::string skip_mismatch() {
+    return "if (!__coi_json::null(_s, _p, _len) && !__coi_json::skip(_s, _p, _len)) _bad = true;";
 }
 
-// Generate inline parsing code for a nested object field
-static void generate_nested_field_parse(std::stringstream& ss,
-                                         const std::string& nested_type,
-                                         const std::string& field_name,
-                                         uint32_t field_idx,
-                                         const std::string& result_var,
-                                         const std::string& meta_var,
-                                         const std::string& src_var,
-                                         const std::string& pos_var,
-                                         const std::string& len_var,
-                                         const std::string& indent,
-                                         int depth) {
+// Read the value at _p into `target` (a field or an array element variable)
+static void generate_value_parse(std::stringstream& ss,
+                                 const std::string& type,
+                                 const std::string& target,
+                                 const std::string& meta_var,
+                                 const std::string& on_success,
+                                 const std::string& indent,
+                                 int depth) {
     std::string d = std::to_string(depth);
-    std::string nv = "_nv" + d;
-    std::string n_ok = "_n_ok" + d;
-
-    ss << indent << "auto " << nv << " = __coi_json::isolate(" << src_var << ", " << pos_var << ", " << len_var << ");\n";
-    ss << indent << "if (" << nv << ".length() > 0) {\n";
-    ss << indent << "    bool " << n_ok << ";\n";
-    generate_object_fields_parse(ss, nested_type,
-                                 result_var + "." + field_name,
-                                 meta_var + "." + field_name,
-                                 nv + ".data()", nv + ".length()", n_ok,
-                                 indent + "    ", depth + 1);
-    ss << indent << "    " << meta_var << ".set(" << field_idx << ");\n";
-    ss << indent << "}\n";
+    if (is_scalar_type(type)) {
+        std::string reader = type == "string" ? "str" : type;
+        ss << indent << target << " = __coi_json::get_" << reader << "(_s, _p, _len, _ok);\n";
+        ss << indent << "if (_ok) { " << on_success << " } else " << skip_mismatch() << "\n";
+    } else if (is_array_type(type)) {
+        std::string elem_type = get_array_element_type(type);
+        std::string first = "_af" + d;
+        ss << indent << "if (__coi_json::open(_s, _p, _len, '[')) {\n";
+        ss << indent << "    bool " << first << " = true;\n";
+        ss << indent << "    while (!_bad && __coi_json::element(_s, _p, _len, " << first << ", _bad)) {\n";
+        if (is_scalar_type(elem_type)) {
+            // A mismatched element keeps its slot (default value) so indices line up
+            std::string reader = elem_type == "string" ? "str" : elem_type;
+            ss << indent << "        " << target << ".push_back(__coi_json::get_" << reader << "(_s, _p, _len, _ok));\n";
+            ss << indent << "        if (!_ok) " << skip_mismatch() << "\n";
+        } else if (is_data_type(elem_type)) {
+            std::string ae = "_ae" + d, ae_meta = "_ae_meta" + d;
+            ss << indent << "        if (__coi_json::peek(_s, _p, _len) == '{') {\n";
+            ss << indent << "            " << elem_type << " " << ae << "{};\n";
+            ss << indent << "            " << elem_type << "Meta " << ae_meta << "{};\n";
+            generate_object_parse(ss, elem_type, ae, ae_meta, indent + "            ", depth + 1);
+            ss << indent << "            " << target << ".push_back(coi::move(" << ae << "));\n";
+            ss << indent << "        } else " << skip_mismatch() << "\n";
+        } else {
+            ss << indent << "        if (!__coi_json::skip(_s, _p, _len)) _bad = true;\n";
+        }
+        ss << indent << "    }\n";
+        ss << indent << "    " << on_success << "\n";
+        ss << indent << "} else " << skip_mismatch() << "\n";
+    } else if (is_data_type(type)) {
+        ss << indent << "if (__coi_json::peek(_s, _p, _len) == '{') {\n";
+        generate_object_parse(ss, type, target, meta_var, indent + "    ", depth + 1);
+        ss << indent << "    " << on_success << "\n";
+        ss << indent << "} else " << skip_mismatch() << "\n";
+    } else {
+        // No reader for this type (e.g. an enum): leave it unset
+        ss << indent << "if (!__coi_json::skip(_s, _p, _len)) _bad = true;\n";
+    }
 }
 
-// Generate inline parsing code for all fields of a data type
-static void generate_object_fields_parse(std::stringstream& ss,
-                                          const std::string& data_type,
-                                          const std::string& result_var,
-                                          const std::string& meta_var,
-                                          const std::string& src_var,
-                                          const std::string& len_var,
-                                          const std::string& ok_var,
-                                          const std::string& indent,
-                                          int depth) {
+// Walk the object at _p once, dispatching each key to its field. Keys are
+// bucketed by length with a switch; inside a bucket, the first byte position
+// where the keys all differ picks the candidate, and key_is() confirms it.
+// A matched field ends with `continue`, so leaving the switch means the key is
+// unknown and its value is skipped.
+static void generate_object_parse(std::stringstream& ss,
+                                  const std::string& data_type,
+                                  const std::string& result_var,
+                                  const std::string& meta_var,
+                                  const std::string& indent,
+                                  int depth) {
     auto* fields = DataTypeRegistry::instance().lookup(data_type);
     if (!fields) return;
 
-    std::string fp = "_fp" + std::to_string(depth);
+    std::string d = std::to_string(depth);
+    std::string first = "_of" + d, k = "_k" + d, kl = "_kl" + d;
 
+    std::map<size_t, std::vector<uint32_t>> by_length;
     for (uint32_t i = 0; i < fields->size(); i++) {
+        by_length[(*fields)[i].name.size()].push_back(i);
+    }
+
+    auto emit_field = [&](uint32_t i, const std::string& in) {
         const auto& field = (*fields)[i];
-        ss << indent << "if (uint32_t " << fp << " = __coi_json::find_key(" << src_var << ", " << len_var << ", \""
-           << field.name << "\", " << field.name.length() << ")) {\n";
-        ss << indent << "    " << fp << " = __coi_json::skip_ws(" << src_var << ", " << fp << ", " << len_var << ");\n";
-
-        if (is_array_type(field.type)) {
-            generate_array_field_parse(ss, get_array_element_type(field.type), field.name, i,
-                                       result_var, meta_var, src_var, fp, len_var, indent + "    ", depth);
-        } else if (!field.type.empty() && std::isupper(field.type[0]) &&
-                   DataTypeRegistry::instance().lookup(field.type)) {
-            generate_nested_field_parse(ss, field.type, field.name, i,
-                                        result_var, meta_var, src_var, fp, len_var, indent + "    ", depth);
+        ss << in << "if (__coi_json::key_is(" << k << ", \"" << field.name << "\", " << field.name.size() << ")) {\n";
+        std::string nested_meta = is_data_type(field.type) ? meta_var + "." + field.name : meta_var;
+        generate_value_parse(ss, field.type, result_var + "." + field.name, nested_meta,
+                             meta_var + ".set(" + std::to_string(i) + ");", in + "    ", depth);
+        ss << in << "    continue;\n";
+        ss << in << "}\n";
+    };
+
+    ss << indent << "if (__coi_json::open(_s, _p, _len, '{')) {\n";
+    ss << indent << "    bool " << first << " = true;\n";
+    ss << indent << "    uint32_t " << kl << " = 0;\n";
+    ss << indent << "    const char* " << k << " = nullptr;\n";
+    ss << indent << "    while (!_bad && __coi_json::member(_s, _p, _len, " << first << ", " << k << ", " << kl << ", _bad)) {\n";
+    ss << indent << "        switch (" << kl << ") {\n";
+    for (const auto& [length, idxs] : by_length) {
+        ss << indent << "        case " << length << ":\n";
+        int pick = -1;
+        if (idxs.size() > 1) {
+            for (size_t c = 0; c < length && pick < 0; c++) {
+                std::set<char> seen;
+                for (uint32_t i : idxs) seen.insert((*fields)[i].name[c]);
+                if (seen.size() == idxs.size()) pick = static_cast<int>(c);
+            }
+        }
+        if (pick >= 0) {
+            ss << indent << "            switch (" << k << "[" << pick << "]) {\n";
+            for (uint32_t i : idxs) {
+                ss << indent << "            case '" << (*fields)[i].name[pick] << "':\n";
+                emit_field(i, indent + "                ");
+                ss << indent << "                break;\n";
+            }
+            ss << indent << "            }\n";
         } else {
-            generate_primitive_field_parse(ss, field.type, field.name, i,
-                                           result_var, meta_var, src_var, fp, len_var, ok_var, indent + "    ");
+            for (uint32_t i : idxs) {
+                emit_field(i, indent + "            ");
+            }
         }
-
-        ss << indent << "}\n";
+        ss << indent << "            break;\n";
     }
+    ss << indent << "        }\n";
+    ss << indent << "        if (!__coi_json::skip(_s, _p, _len)) _bad = true;\n";
+    ss << indent << "    }\n";
+    ss << indent << "}\n";
 }
 
-// Generate JSON parse code for root-level arrays (e.g., Json.parse(User[], ...))
-static std::string generate_json_parse_array(
-    const std::string& array_type,
-    const std::string& json_expr)
-{
-    std::string elem_type = get_array_element_type(array_type);
-    if (!DataTypeRegistry::instance().lookup(elem_type)) {
-        return "/* Error: Unknown element type '" + elem_type + "' for Json.parse */";
-    }
-    
-    std::stringstream ss;
+// Opening of the immediately-invoked lambda shared by both parse forms
+static void generate_parse_prologue(std::stringstream& ss, const std::string& json_expr) {
     ss << "[&]() {\n";
     ss << "            coi::string_view _json = " << json_expr << ";\n";
     ss << "            const char* _s = _json.data();\n";
     ss << "            uint32_t _len = _json.length();\n";
+    ss << "            uint32_t _p = 0;\n";
+    ss << "            bool _bad = false;\n";
+    ss << "            bool _ok;\n";
+}
+
+// The result lives in its payloads only: the decoder writes into
+// success._0/_1 directly and match arms bind them by reference, so decoded
+// values are never copied.
+static void generate_result_struct(std::stringstream& ss,
+                                   const std::string& value_type,
+                                   const std::string& meta_type) {
     ss << "            struct __JsonParseResult {\n";
     ss << "                struct __SuccessPayload {\n";
-    ss << "                    coi::vector<" << elem_type << "> _0;\n";
-    ss << "                    coi::vector<" << elem_type << "Meta> _1;\n";
+    ss << "                    " << value_type << " _0;\n";
+    ss << "                    " << meta_type << " _1;\n";
     ss << "                };\n";
     ss << "                struct __ErrorPayload {\n";
     ss << "                    coi::string _0;\n";
     ss << "                };\n";
     ss << "                bool ok;\n";
-    ss << "                coi::vector<" << elem_type << "> value;\n";
-    ss << "                coi::vector<" << elem_type << "Meta> meta;\n";
-    ss << "                coi::string error;\n";
     ss << "                __SuccessPayload success;\n";
     ss << "                __ErrorPayload error_payload;\n";
     ss << "                bool is_Success() const { return ok; }\n";
@@ -312,29 +287,51 @@ static std::string generate_json_parse_array(
     ss << "                const __SuccessPayload& as_Success() const { return success; }\n";
     ss << "                const __ErrorPayload& as_Error() const { return error_payload; }\n";
     ss << "            } _r{};\n";
-    ss << "            uint32_t _p = __coi_json::skip_ws(_s, 0, _len);\n";
-    ss << "            if (_p >= _len || _s[_p] != '[') {\n";
+}
+
+static void generate_parse_epilogue(std::stringstream& ss) {
+    ss << "            if (__coi_json::peek(_s, _p, _len) != '\\0') _bad = true;\n";
+    ss << "            if (_bad) {\n";
     ss << "                _r.ok = false;\n";
-    ss << "                _r.error = \"Expected JSON array\";\n";
-    ss << "                _r.error_payload._0 = _r.error;\n";
+    ss << "                _r.error_payload._0 = \"Invalid JSON\";\n";
     ss << "                return _r;\n";
     ss << "            }\n";
     ss << "            _r.ok = true;\n";
-    ss << "            __coi_json::for_each(_s, _p, _len, [&](const char* _es, uint32_t _ep, uint32_t _elen) {\n";
-    ss << "                auto _ev = __coi_json::isolate(_es, _ep, _elen);\n";
-    ss << "                if (_ev.length() > 0) {\n";
-    ss << "                    " << elem_type << " _elem{};\n";
-    ss << "                    " << elem_type << "Meta _elem_meta{};\n";
-    ss << "                    bool _ok;\n";
-    generate_object_fields_parse(ss, elem_type, "_elem", "_elem_meta", "_ev.data()", "_ev.length()", "_ok", "                    ", 0);
-    ss << "                    _r.value.push_back(coi::move(_elem));\n";
-    ss << "                    _r.meta.push_back(coi::move(_elem_meta));\n";
-    ss << "                }\n";
-    ss << "            });\n";
-    ss << "            _r.success._0 = _r.value;\n";
-    ss << "            _r.success._1 = _r.meta;\n";
     ss << "            return _r;\n";
     ss << "        }()";
+}
+
+// Generate JSON parse code for root-level arrays (e.g., Json.parse(User[], ...))
+static std::string generate_json_parse_array(
+    const std::string& array_type,
+    const std::string& json_expr)
+{
+    std::string elem_type = get_array_element_type(array_type);
+    if (!DataTypeRegistry::instance().lookup(elem_type)) {
+        return "/* Error: Unknown element type '" + elem_type + "' for Json.parse */";
+    }
+    
+    std::stringstream ss;
+    generate_parse_prologue(ss, json_expr);
+    generate_result_struct(ss, "coi::vector<" + elem_type + ">", "coi::vector<" + elem_type + "Meta>");
+    ss << "            if (!__coi_json::open(_s, _p, _len, '[')) {\n";
+    ss << "                _r.ok = false;\n";
+    ss << "                _r.error_payload._0 = \"Expected JSON array\";\n";
+    ss << "                return _r;\n";
+    ss << "            }\n";
+    ss << "            bool _first = true;\n";
+    ss << "            while (!_bad && __coi_json::element(_s, _p, _len, _first, _bad)) {\n";
+    ss << "                if (__coi_json::peek(_s, _p, _len) != '{') {\n";
+    ss << "                    if (!__coi_json::skip(_s, _p, _len)) _bad = true;\n";
+    ss << "                    continue;\n";
+    ss << "                }\n";
+    ss << "                " << elem_type << " _elem{};\n";
+    ss << "                " << elem_type << "Meta _elem_meta{};\n";
+    generate_object_parse(ss, elem_type, "_elem", "_elem_meta", "                ", 0);
+    ss << "                _r.success._0.push_back(coi::move(_elem));\n";
+    ss << "                _r.success._1.push_back(coi::move(_elem_meta));\n";
+    ss << "            }\n";
+    generate_parse_epilogue(ss);
     return ss.str();
 }
 
@@ -351,196 +348,763 @@ std::string generate_json_parse(
         return "/* Error: Unknown data type '" + data_type + "' for Json.parse */";
     }
     
+    std::stringstream ss;
+    generate_parse_prologue(ss, json_expr);
+    generate_result_struct(ss, data_type, data_type + "Meta");
+    ss << "            if (__coi_json::peek(_s, _p, _len) != '{') _bad = true;\n";
+    generate_object_parse(ss, data_type, "_r.success._0", "_r.success._1", "            ", 0);
+    generate_parse_epilogue(ss);
+    return ss.str();
+}
+
+// Generate Json.feed(User[], stream, chunk): the elements the chunk completes
+// are decoded one at a time, each from its own slice, with the same object
+// walk as Json.parse. A malformed element fails the stream for good (until
+// reset), since the framing can't tell where the next one would start.
+std::string generate_json_feed(
+    const std::string& array_type,
+    const std::string& stream_expr,
+    const std::string& json_expr)
+{
+    std::string elem_type = get_array_element_type(array_type);
+    if (!DataTypeRegistry::instance().lookup(elem_type)) {
+        return "/* Error: Unknown element type '" + elem_type + "' for Json.feed */";
+    }
+
     std::stringstream ss;
     ss << "[&]() {\n";
     ss << "            coi::string_view _json = " << json_expr << ";\n";
-    ss << "            const char* _s = _json.data();\n";
-    ss << "            uint32_t _len = _json.length();\n";
-    ss << "            struct __JsonParseResult {\n";
-    ss << "                struct __SuccessPayload {\n";
-    ss << "                    " << data_type << " _0;\n";
-    ss << "                    " << data_type << "Meta _1;\n";
-    ss << "                };\n";
-    ss << "                struct __ErrorPayload {\n";
-    ss << "                    coi::string _0;\n";
-    ss << "                };\n";
-    ss << "                bool ok;\n";
-    ss << "                " << data_type << " value;\n";
-    ss << "                " << data_type << "Meta meta;\n";
-    ss << "                coi::string error;\n";
-    ss << "                __SuccessPayload success;\n";
-    ss << "                __ErrorPayload error_payload;\n";
-    ss << "                bool is_Success() const { return ok; }\n";
-    ss << "                bool is_Error() const { return !ok; }\n";
-    ss << "                const __SuccessPayload& as_Success() const { return success; }\n";
-    ss << "                const __ErrorPayload& as_Error() const { return error_payload; }\n";
-    ss << "            } _r{};\n";
-    ss << "            if (!__coi_json::is_valid(_s, _len)) {\n";
+    ss << "            __coi_json::Stream& _st = " << stream_expr << ";\n";
+    generate_result_struct(ss, "coi::vector<" + elem_type + ">", "coi::vector<" + elem_type + "Meta>");
+    ss << "            const char* _s;\n";
+    ss << "            uint32_t _len;\n";
+    ss << "            _st.begin(_json.data(), _json.length());\n";
+    ss << "            while (_st.next(_s, _len)) {\n";
+    ss << "                uint32_t _p = 0;\n";
+    ss << "                bool _bad = false;\n";
+    ss << "                bool _ok;\n";
+    ss << "                if (__coi_json::peek(_s, _p, _len) != '{') {\n";
+    ss << "                    if (!__coi_json::skip(_s, _p, _len) || __coi_json::peek(_s, _p, _len) != '\\0') { _st.fail(); break; }\n";
+    ss << "                    continue;\n";
+    ss << "                }\n";
+    ss << "                " << elem_type << " _elem{};\n";
+    ss << "                " << elem_type << "Meta _elem_meta{};\n";
+    generate_object_parse(ss, elem_type, "_elem", "_elem_meta", "                ", 0);
+    ss << "                if (_bad || __coi_json::peek(_s, _p, _len) != '\\0') { _st.fail(); break; }\n";
+    ss << "                _r.success._0.push_back(coi::move(_elem));\n";
+    ss << "                _r.success._1.push_back(coi::move(_elem_meta));\n";
+    ss << "            }\n";
+    ss << "            if (_st.failed()) {\n";
     ss << "                _r.ok = false;\n";
-    ss << "                _r.error = \"Invalid JSON\";\n";
-    ss << "                _r.error_payload._0 = _r.error;\n";
+    ss << "                _r.error_payload._0 = \"Invalid JSON\";\n";
     ss << "                return _r;\n";
     ss << "            }\n";
     ss << "            _r.ok = true;\n";
-    ss << "            bool _ok;\n";
-    generate_object_fields_parse(ss, data_type, "_r.value", "_r.meta", "_s", "_len", "_ok", "            ", 0);
-    ss << "            _r.success._0 = _r.value;\n";
-    ss << "            _r.success._1 = _r.meta;\n";
     ss << "            return _r;\n";
     ss << "        }()";
     return ss.str();
 }
 
+// ============================================================================
+// JSON Stringify Code Generation
+// ============================================================================
+
+// C++ string literal for raw JSON text (keys and enum names are identifiers,
+// so only the quotes need escaping)
+static std::string json_literal(const std::string& text) {
+    std::string literal = "\"";
+    for (char c : text) {
+        if (c == '"') literal += '\\';
+        literal += c;
+    }
+    return literal + "\"";
+}
+
+std::string generate_json_writers(const std::vector<std::string>& data_types,
+                                  const std::vector<JsonEnum>& enums) {
+    std::stringstream ss;
+    ss << "namespace __coi_json {\n";
+
+    // Enums are written by name
+    for (const auto& e : enums) {
+        if (e.values.empty()) {
+            ss << "inline uint32_t size(" << e.name << ") { return 4; }\n";
+            ss << "inline void write(char*& o, " << e.name << ") { put(o, \"null\", 4); }\n";
+            continue;
+        }
+        ss << "inline uint32_t size(" << e.name << " v) {\n";
+        ss << "    static const uint8_t sizes[] = {";
+        for (size_t i = 0; i < e.values.size(); i++) {
+            ss << (i ? ", " : "") << e.values[i].size() + 2;
+        }
+        ss << "};\n";
+        ss << "    return (uint32_t)v < " << e.values.size() << " ? sizes[(uint32_t)v] : 4;\n";
+        ss << "}\n";
+        ss << "inline void write(char*& o, " << e.name << " v) {\n";
+        ss << "    switch (v) {\n";
+        for (const auto& value : e.values) {
+            ss << "        case " << e.name << "::" << value << ": put(o, " << json_literal("\"" + value + "\"")
+               << ", " << value.size() + 2 << "); return;\n";
+        }
+        ss << "        default: put(o, \"null\", 4); return;\n";
+        ss << "    }\n";
+        ss << "}\n";
+    }
+
+    // Pods may nest each other and arrays of each other in any order
+    for (const auto& type : data_types) {
+        ss << "uint32_t size(const " << type << "& v);\n";
+        ss << "void write(char*& o, const " << type << "& v);\n";
+    }
+
+    ss << "template<typename T> inline uint32_t size(const coi::vector<T>& v) {\n";
+    ss << "    uint32_t r = v.size() > 0 ? v.size() + 1 : 2;\n";
+    ss << "    for (uint32_t i = 0; i < v.size(); i++) r += size(v[i]);\n";
+    ss << "    return r;\n";
+    ss << "}\n";
+    ss << "template<typename T> inline void write(char*& o, const coi::vector<T>& v) {\n";
+    ss << "    *o++ = '[';\n";
+    ss << "    for (uint32_t i = 0; i < v.size(); i++) { if (i) *o++ = ','; write(o, v[i]); }\n";
+    ss << "    *o++ = ']';\n";
+    ss << "}\n";
+    ss << "template<typename T, size_t N> inline uint32_t size(const coi::array<T, N>& v) {\n";
+    ss << "    uint32_t r = N > 0 ? N + 1 : 2;\n";
+    ss << "    for (uint32_t i = 0; i < N; i++) r += size(v[i]);\n";
+    ss << "    return r;\n";
+    ss << "}\n";
+    ss << "template<typename T, size_t N> inline void write(char*& o, const coi::array<T, N>& v) {\n";
+    ss << "    *o++ = '[';\n";
+    ss << "    for (uint32_t i = 0; i < N; i++) { if (i) *o++ = ','; write(o, v[i]); }\n";
+    ss << "    *o++ = ']';\n";
+    ss << "}\n";
+
+    // Only the returned string is allocated; the scratch buffer is on the
+    // stack unless the output is large.
+    ss << "template<typename T> inline coi::string stringify(const T& v) {\n";
+    ss << "    uint32_t n = size(v);\n";
+    ss << "    char stack[1024];\n";
+    ss << "    char* buf = n <= sizeof(stack) ? stack : new char[n];\n";
+    ss << "    char* o = buf;\n";
+    ss << "    write(o, v);\n";
+    ss << "    coi::string out(buf, n);\n";
+    ss << "    if (buf != stack) delete[] buf;\n";
+    ss << "    return out;\n";
+    ss << "}\n";
+
+    // Each pod: the keys and punctuation are one constant run between values
+    for (const auto& type : data_types) {
+        auto* fields = DataTypeRegistry::instance().lookup(type);
+        if (!fields) continue;
+
+        size_t fixed = 2;
+        for (size_t i = 0; i < fields->size(); i++) {
+            fixed += (i ? 1 : 0) + (*fields)[i].name.size() + 3;
+        }
+        ss << "uint32_t size(const " << type << "& v) {\n";
+        ss << "    return " << fixed;
+        for (const auto& field : *fields) {
+            ss << " + size(v." << field.name << ")";
+        }
+        ss << ";\n";
+        ss << "}\n";
+
+        ss << "void write(char*& o, const " << type << "& v) {\n";
+        std::string run = "{";
+        for (size_t i = 0; i < fields->size(); i++) {
+            run += (i ? "," : "") + std::string("\"") + (*fields)[i].name + "\":";
+            ss << "    put(o, " << json_literal(run) << ", " << run.size() << ");\n";
+            ss << "    write(o, v." << (*fields)[i].name << ");\n";
+            run.clear();
+        }
+        run += "}";
+        ss << "    put(o, " << json_literal(run) << ", " << run.size() << ");\n";
+        ss << "}\n";
+    }
+
+    ss << "} // namespace __coi_json\n";
+    return ss.str();
+}
+
 // ============================================================================
 // Emit JSON Runtime Helpers (inline into generated code)
 // ============================================================================
 
-void emit_json_runtime(std::ostream& out) {
+void emit_json_runtime(std::ostream& out, bool parse, bool stringify) {
     out << R"(
 // ============================================================================
 // JSON Runtime Helpers (auto-generated by Coi compiler)
 // ============================================================================
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
 namespace __coi_json {
 
+// Scanners look at 8 bytes per step (16 with wasm-simd128). match8 sets bit 7
+// of each byte of w equal to c; bytes above the first match may be flagged
+// falsely, which is harmless because only the lowest flag is used. Words are
+// little-endian on every target we emit for.
+constexpr uint64_t ONES = 0x0101010101010101ull;
+constexpr uint64_t HIGHS = 0x8080808080808080ull;
+
+inline uint64_t load8(const char* s) { uint64_t w; __builtin_memcpy(&w, s, 8); return w; }
+
+inline uint64_t match8(uint64_t w, uint8_t c) {
+    uint64_t x = w ^ (ONES * c);
+    return (x - ONES) & ~x & HIGHS;
+}
+
+inline uint32_t first8(uint64_t m) { return (uint32_t)__builtin_ctzll(m) >> 3; }
+)";
+    if (parse) {
+        out << R"(
+// Presence bits of an N-field pod, one per field
+template<uint32_t N>
 struct MetaBase {
-    uint32_t bits = 0;
-    bool has(uint32_t i) const { return (bits >> i) & 1; }
-    void set(uint32_t i) { bits |= (1u << i); }
+    uint32_t bits[N > 0 ? (N + 31) / 32 : 1] = {};
+    bool has(uint32_t i) const { return (bits[i >> 5] >> (i & 31)) & 1; }
+    void set(uint32_t i) { bits[i >> 5] |= (1u << (i & 31)); }
 };
 
+// First '"' or '\\' at or after p, or len
+inline uint32_t scan_str(const char* s, uint32_t p, uint32_t len) {
+#ifdef __wasm_simd128__
+    for (; p + 16 <= len; p += 16) {
+        v128_t v = wasm_v128_load(s + p);
+        uint32_t m = wasm_i8x16_bitmask(wasm_v128_or(wasm_i8x16_eq(v, wasm_i8x16_splat('"')),
+                                                     wasm_i8x16_eq(v, wasm_i8x16_splat('\\'))));
+        if (m) return p + __builtin_ctz(m);
+    }
+#endif
+    for (; p + 8 <= len; p += 8) {
+        uint64_t w = load8(s + p);
+        uint64_t m = match8(w, '"') | match8(w, '\\');
+        if (m) return p + first8(m);
+    }
+    while (p < len && s[p] != '"' && s[p] != '\\') p++;
+    return p;
+}
+
+// First '"', '{', '}', '[' or ']' at or after p, or len. Setting bit 5 folds
+// '[' onto '{' and ']' onto '}', and no other byte lands on either.
+inline uint32_t scan_structural(const char* s, uint32_t p, uint32_t len) {
+#ifdef __wasm_simd128__
+    for (; p + 16 <= len; p += 16) {
+        v128_t v = wasm_v128_load(s + p);
+        v128_t f = wasm_v128_or(v, wasm_i8x16_splat(0x20));
+        uint32_t m = wasm_i8x16_bitmask(wasm_v128_or(wasm_i8x16_eq(v, wasm_i8x16_splat('"')),
+                                        wasm_v128_or(wasm_i8x16_eq(f, wasm_i8x16_splat('{')),
+                                                     wasm_i8x16_eq(f, wasm_i8x16_splat('}')))));
+        if (m) return p + __builtin_ctz(m);
+    }
+#endif
+    for (; p + 8 <= len; p += 8) {
+        uint64_t w = load8(s + p);
+        uint64_t f = w | (ONES * 0x20);
+        uint64_t m = match8(w, '"') | match8(f, '{') | match8(f, '}');
+        if (m) return p + first8(m);
+    }
+    while (p < len && s[p] != '"' && (s[p] | 0x20) != '{' && (s[p] | 0x20) != '}') p++;
+    return p;
+}
+
+// Readers take the cursor p by reference. On success they leave it just past
+// what they consumed; on failure (ok = false) it is left unchanged.
+
 inline uint32_t skip_ws(const char* s, uint32_t p, uint32_t len) {
     while (p < len && (s[p] == ' ' || s[p] == '\t' || s[p] == '\n' || s[p] == '\r')) p++;
     return p;
 }
 
-inline uint32_t find_key(const char* s, uint32_t len, const char* key, uint32_t klen) {
-    int depth = 0;
-    uint32_t p = skip_ws(s, 0, len);
-    if (p >= len || s[p] != '{') return 0;
+inline char peek(const char* s, uint32_t& p, uint32_t len) {
+    p = skip_ws(s, p, len);
+    return p < len ? s[p] : '\0';
+}
+
+inline bool open(const char* s, uint32_t& p, uint32_t len, char c) {
+    if (peek(s, p, len) != c) return false;
     p++;
-    while (p < len) {
-        p = skip_ws(s, p, len);
-        if (p >= len) return 0;
-        char c = s[p];
-        if (c == '{' || c == '[') { depth++; p++; continue; }
-        if (c == '}' || c == ']') { if (depth == 0) return 0; depth--; p++; continue; }
-        if (depth > 0) {
-            if (c == '"') { p++; while (p < len && s[p] != '"') { if (s[p] == '\\') p++; p++; } p++; }
-            else p++;
-            continue;
-        }
-        if (c == '"') {
-            uint32_t ks = p + 1; p++;
-            while (p < len && s[p] != '"') { if (s[p] == '\\') p++; p++; }
-            uint32_t ke = p; p++;
-            if (ke - ks == klen) {
-                bool match = true;
-                for (uint32_t i = 0; i < klen && match; i++) if (s[ks + i] != key[i]) match = false;
-                if (match) { p = skip_ws(s, p, len); if (p < len && s[p] == ':') return skip_ws(s, p + 1, len); }
-            }
-            continue;
-        }
-        p++;
+    return true;
+}
+
+// Past the closing quote of the string starting at p (s[p] == '"')
+inline bool skip_str(const char* s, uint32_t& p, uint32_t len) {
+    uint32_t q = p + 1;
+    for (;;) {
+        q = scan_str(s, q, len);
+        if (q >= len) return false;
+        if (s[q] == '"') { p = q + 1; return true; }
+        q += 2;
     }
-    return 0;
 }
 
-inline coi::string_view isolate(const char* s, uint32_t p, uint32_t len) {
-    if (p >= len) return {};
-    char open = s[p];
-    if (open != '{' && open != '[') return {};
-    char close = (open == '{') ? '}' : ']';
-    uint32_t start = p;
-    int depth = 1; p++;
-    while (p < len && depth > 0) {
-        char c = s[p];
-        if (c == '"') { p++; while (p < len && s[p] != '"') { if (s[p] == '\\') p++; p++; } p++; }
-        else { if (c == open) depth++; else if (c == close) depth--; p++; }
+// Past any value; false if it is malformed or truncated
+inline bool skip(const char* s, uint32_t& p, uint32_t len) {
+    char c = peek(s, p, len);
+    if (c == '"') return skip_str(s, p, len);
+    if (c == '{' || c == '[') {
+        uint32_t q = p;
+        int depth = 0;
+        for (;;) {
+            q = scan_structural(s, q, len);
+            if (q >= len) return false;
+            char k = s[q];
+            if (k == '"') { if (!skip_str(s, q, len)) return false; continue; }
+            if (k == '{' || k == '[') depth++;
+            else if (--depth == 0) { p = q + 1; return true; }
+            q++;
+        }
     }
-    return depth == 0 ? coi::string_view(s + start, p - start) : coi::string_view();
+    uint32_t q = p;
+    while (q < len && s[q] != ',' && s[q] != '}' && s[q] != ']' && s[q] != ' ' && s[q] != '\t' && s[q] != '\n' && s[q] != '\r') q++;
+    if (q == p) return false;
+    p = q;
+    return true;
 }
 
-inline coi::string ext_str(const char* s, uint32_t p, uint32_t len) {
-    if (p >= len || s[p] != '"') return {};
+// Object walk: call with first = true after open('{'). Returns true with p at
+// the next member's value and its key in [k, k + kl); false once the closing
+// brace is consumed or on malformed input (bad set).
+inline bool member(const char* s, uint32_t& p, uint32_t len, bool& first, const char*& k, uint32_t& kl, bool& bad) {
+    char c = peek(s, p, len);
+    if (first) {
+        first = false;
+        if (c == '}') { p++; return false; }
+    } else {
+        if (c == '}') { p++; return false; }
+        if (c != ',') { bad = true; return false; }
+        c = peek(s, ++p, len);
+    }
+    uint32_t ks = p + 1;
+    if (c != '"' || !skip_str(s, p, len)) { bad = true; return false; }
+    k = s + ks;
+    kl = p - 1 - ks;
+    if (peek(s, p, len) != ':') { bad = true; return false; }
     p++;
+    if (peek(s, p, len) == '\0') { bad = true; return false; }
+    return true;
+}
+
+// Array walk, same protocol as member(): p at the next element
+inline bool element(const char* s, uint32_t& p, uint32_t len, bool& first, bool& bad) {
+    char c = peek(s, p, len);
+    if (first) {
+        first = false;
+        if (c == ']') { p++; return false; }
+    } else {
+        if (c == ']') { p++; return false; }
+        if (c != ',') { bad = true; return false; }
+        c = peek(s, ++p, len);
+    }
+    if (c == '\0') { bad = true; return false; }
+    return true;
+}
+
+inline bool key_is(const char* k, const char* name, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) if (k[i] != name[i]) return false;
+    return true;
+}
+
+inline bool null(const char* s, uint32_t& p, uint32_t len) {
+    if (p + 4 <= len && s[p] == 'n' && s[p+1] == 'u' && s[p+2] == 'l' && s[p+3] == 'l') { p += 4; return true; }
+    return false;
+}
+
+inline bool hex4(const char* s, uint32_t p, uint32_t len, uint32_t& v) {
+    if (p + 4 > len) return false;
+    v = 0;
+    for (uint32_t i = p; i < p + 4; i++) {
+        char c = s[i];
+        uint32_t d = c >= '0' && c <= '9' ? c - '0' : (c | 0x20) >= 'a' && (c | 0x20) <= 'f' ? (c | 0x20) - 'a' + 10 : 16;
+        if (d > 15) return false;
+        v = v * 16 + d;
+    }
+    return true;
+}
+
+inline uint32_t put_utf8(char* o, uint32_t cp) {
+    if (cp < 0x80) { o[0] = (char)cp; return 1; }
+    if (cp < 0x800) { o[0] = (char)(0xC0 | cp >> 6); o[1] = (char)(0x80 | (cp & 63)); return 2; }
+    if (cp < 0x10000) {
+        o[0] = (char)(0xE0 | cp >> 12); o[1] = (char)(0x80 | (cp >> 6 & 63)); o[2] = (char)(0x80 | (cp & 63));
+        return 3;
+    }
+    o[0] = (char)(0xF0 | cp >> 18); o[1] = (char)(0x80 | (cp >> 12 & 63));
+    o[2] = (char)(0x80 | (cp >> 6 & 63)); o[3] = (char)(0x80 | (cp & 63));
+    return 4;
+}
+
+// Decodes the escaped string whose contents start at a into a stack buffer,
+// spilling into r only when it fills. Kept out of line so the escape-free
+// path of get_str stays small.
+[[gnu::noinline]] inline coi::string get_escaped_str(const char* s, uint32_t& p, uint32_t len, uint32_t a, bool& ok) {
     coi::string r;
-    while (p < len && s[p] != '"') {
-        if (s[p] == '\\' && p + 1 < len) {
-            p++;
-            switch (s[p]) {
-                case '"': r += '"'; break; case '\\': r += '\\'; break;
-                case 'n': r += '\n'; break; case 'r': r += '\r'; break;
-                case 't': r += '\t'; break; default: r += s[p]; break;
+    char buf[256];
+    uint32_t n = 0;
+    uint32_t q = a;
+    for (;;) {
+        uint32_t e = scan_str(s, q, len);
+        if (e >= len) return {};
+        while (q < e) {
+            if (n == sizeof(buf)) { r += coi::string(buf, n); n = 0; }
+            uint32_t k = e - q < sizeof(buf) - n ? e - q : sizeof(buf) - n;
+            __builtin_memcpy(buf + n, s + q, k);
+            n += k;
+            q += k;
+        }
+        if (s[e] == '"') { p = e + 1; break; }
+        if (e + 1 >= len) return {};
+        if (n + 4 > sizeof(buf)) { r += coi::string(buf, n); n = 0; }
+        char c = s[e + 1];
+        q = e + 2;
+        switch (c) {
+            case 'n': buf[n++] = '\n'; break;
+            case 'r': buf[n++] = '\r'; break;
+            case 't': buf[n++] = '\t'; break;
+            case 'b': buf[n++] = '\b'; break;
+            case 'f': buf[n++] = '\f'; break;
+            case 'u': {
+                uint32_t cp, lo;
+                if (!hex4(s, q, len, cp)) return {};
+                q += 4;
+                // A surrogate pair spells one code point
+                if (cp >= 0xD800 && cp < 0xDC00 && q + 1 < len && s[q] == '\\' && s[q + 1] == 'u' &&
+                    hex4(s, q + 2, len, lo) && lo >= 0xDC00 && lo < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+                    q += 6;
+                }
+                n += put_utf8(buf + n, cp);
+                break;
             }
-        } else r += s[p];
-        p++;
+            default: buf[n++] = c; break;
+        }
     }
+    ok = true;
+    if (r.empty()) return coi::string(buf, n);
+    r += coi::string(buf, n);
     return r;
 }
 
-inline int32_t ext_int(const char* s, uint32_t p, uint32_t len, bool& ok) {
+inline coi::string get_str(const char* s, uint32_t& p, uint32_t len, bool& ok) {
     ok = false;
-    if (p >= len) return 0;
-    bool neg = s[p] == '-'; if (neg) p++;
-    if (p >= len || s[p] < '0' || s[p] > '9') return 0;
-    int32_t r = 0;
-    while (p < len && s[p] >= '0' && s[p] <= '9') { r = r * 10 + (s[p] - '0'); p++; }
+    if (p >= len || s[p] != '"') return {};
+    uint32_t q = scan_str(s, p + 1, len);
+    if (q >= len) return {};
+    if (s[q] == '\\') return get_escaped_str(s, p, len, p + 1, ok);
+    // No escapes: one copy of the whole span
+    coi::string r(s + p + 1, q - p - 1);
+    p = q + 1;
     ok = true;
-    return neg ? -r : r;
+    return r;
+}
+
+inline int32_t get_int(const char* s, uint32_t& p, uint32_t len, bool& ok) {
+    ok = false;
+    uint32_t q = p;
+    if (q >= len) return 0;
+    bool neg = s[q] == '-'; if (neg) q++;
+    if (q >= len || s[q] < '0' || s[q] > '9') return 0;
+    uint64_t r = 0;
+    while (q < len && s[q] >= '0' && s[q] <= '9') {
+        r = r * 10 + (s[q] - '0');
+        if (r > 2147483648ull) return 0;  // out of range
+        q++;
+    }
+    if (!neg && r > 2147483647ull) return 0;
+    // A fraction or exponent is not an int: reject rather than stop mid-number
+    if (q < len && (s[q] == '.' || s[q] == 'e' || s[q] == 'E')) return 0;
+    p = q;
+    ok = true;
+    return neg ? (int32_t)(0 - (uint32_t)r) : (int32_t)r;
 }
 
-inline double ext_float(const char* s, uint32_t p, uint32_t len, bool& ok) {
+inline double get_float(const char* s, uint32_t& p, uint32_t len, bool& ok) {
     ok = false;
-    if (p >= len) return 0;
-    bool neg = s[p] == '-'; if (neg) p++;
-    if (p >= len || s[p] < '0' || s[p] > '9') return 0;
+    uint32_t q = p;
+    if (q >= len) return 0;
+    bool neg = s[q] == '-'; if (neg) q++;
+    if (q >= len || s[q] < '0' || s[q] > '9') return 0;
     double r = 0;
-    while (p < len && s[p] >= '0' && s[p] <= '9') { r = r * 10 + (s[p] - '0'); p++; }
-    if (p < len && s[p] == '.') { p++; double d = 10; while (p < len && s[p] >= '0' && s[p] <= '9') { r += (s[p] - '0') / d; d *= 10; p++; } }
+    while (q < len && s[q] >= '0' && s[q] <= '9') { r = r * 10 + (s[q] - '0'); q++; }
+    if (q < len && s[q] == '.') { q++; double d = 10; while (q < len && s[q] >= '0' && s[q] <= '9') { r += (s[q] - '0') / d; d *= 10; q++; } }
+    if (q < len && (s[q] == 'e' || s[q] == 'E')) {
+        q++;
+        bool eneg = q < len && s[q] == '-';
+        if (q < len && (s[q] == '-' || s[q] == '+')) q++;
+        int e = 0;
+        while (q < len && s[q] >= '0' && s[q] <= '9') { e = e * 10 + (s[q] - '0'); q++; }
+        while (e-- > 0) r = eneg ? r / 10 : r * 10;
+    }
+    p = q;
     ok = true;
     return neg ? -r : r;
 }
 
-inline bool ext_bool(const char* s, uint32_t p, uint32_t len, bool& ok) {
+inline bool get_bool(const char* s, uint32_t& p, uint32_t len, bool& ok) {
     ok = false;
-    if (p + 4 <= len && s[p] == 't' && s[p+1] == 'r' && s[p+2] == 'u' && s[p+3] == 'e') { ok = true; return true; }
-    if (p + 5 <= len && s[p] == 'f' && s[p+1] == 'a' && s[p+2] == 'l' && s[p+3] == 's' && s[p+4] == 'e') { ok = true; return false; }
+    if (p + 4 <= len && s[p] == 't' && s[p+1] == 'r' && s[p+2] == 'u' && s[p+3] == 'e') { p += 4; ok = true; return true; }
+    if (p + 5 <= len && s[p] == 'f' && s[p+1] == 'a' && s[p+2] == 'l' && s[p+3] == 's' && s[p+4] == 'e') { p += 5; ok = true; return false; }
     return false;
 }
 
-inline bool is_null(const char* s, uint32_t p, uint32_t len) {
-    return p + 4 <= len && s[p] == 'n' && s[p+1] == 'u' && s[p+2] == 'l' && s[p+3] == 'l';
+// Json.feed: frames the elements of a top-level array that arrives in chunks
+// split anywhere. next() hands out each element once its last byte is in; an
+// element inside one chunk is read in place, and only one that straddles a
+// boundary is gathered into tail. Framing only matches brackets and strings:
+// the element itself is checked when it is decoded.
+struct Stream {
+    enum : uint8_t { OPEN, FIRST, NEXT, VALUE, IN, DONE, FAILED };
+    uint8_t state = OPEN;
+    bool scalar = false;
+    bool in_str = false;
+    bool esc = false;
+    uint32_t depth = 0;
+    char* tail = nullptr;
+    uint32_t tail_len = 0;
+    uint32_t tail_cap = 0;
+    const char* c = nullptr;  // chunk being framed
+    uint32_t cn = 0;
+    uint32_t cp = 0;
+
+    Stream() = default;
+    Stream(const Stream& o) { *this = o; }
+    Stream& operator=(const Stream& o) {
+        if (this == &o) return *this;
+        state = o.state; scalar = o.scalar; in_str = o.in_str; esc = o.esc; depth = o.depth;
+        tail_len = 0;
+        append(o.tail, o.tail_len);
+        return *this;
+    }
+    ~Stream() { delete[] tail; }
+
+    bool done() const { return state == DONE; }
+    bool failed() const { return state == FAILED; }
+    void fail() { state = FAILED; }
+    void reset() { state = OPEN; tail_len = 0; }
+
+    void append(const char* s, uint32_t n) {
+        if (tail_len + n > tail_cap) {
+            uint32_t cap = tail_cap * 2 > tail_len + n ? tail_cap * 2 : tail_len + n + 64;
+            char* t = new char[cap];
+            if (tail_len) __builtin_memcpy(t, tail, tail_len);
+            delete[] tail;
+            tail = t;
+            tail_cap = cap;
+        }
+        if (n) __builtin_memcpy(tail + tail_len, s, n);
+        tail_len += n;
+    }
+
+    // Scan on through the pending element; true with p just past its end
+    bool scan(const char* s, uint32_t& p, uint32_t n) {
+        if (scalar) {
+            while (p < n && s[p] != ',' && s[p] != ']' && s[p] != '}' &&
+                   s[p] != ' ' && s[p] != '\t' && s[p] != '\n' && s[p] != '\r') p++;
+            return p < n;
+        }
+        for (;;) {
+            if (esc) {
+                if (p >= n) return false;
+                p++;
+                esc = false;
+            }
+            if (in_str) {
+                p = scan_str(s, p, n);
+                if (p >= n) return false;
+                if (s[p++] == '\\') { esc = true; continue; }
+                in_str = false;
+                if (depth == 0) return true;
+                continue;
+            }
+            p = scan_structural(s, p, n);
+            if (p >= n) return false;
+            char k = s[p++];
+            if (k == '"') in_str = true;
+            else if (k == '{' || k == '[') depth++;
+            else if (--depth == 0) return true;
+        }
+    }
+
+    void begin(const char* s, uint32_t n) { c = s; cn = n; cp = 0; }
+
+    // The next complete element of the chunk given to begin(), as [e, e + en).
+    // False once the chunk is used up or the framing is broken (failed()).
+    bool next(const char*& e, uint32_t& en) {
+        if (state == IN) {
+            uint32_t p = cp;
+            bool end = scan(c, p, cn);
+            append(c + cp, p - cp);
+            cp = p;
+            if (!end) return false;
+            state = NEXT;
+            e = tail;
+            en = tail_len;
+            return true;
+        }
+        for (;;) {
+            cp = skip_ws(c, cp, cn);
+            if (cp >= cn || state == FAILED) return false;
+            char ch = c[cp];
+            if (state == OPEN) {
+                if (ch != '[') { state = FAILED; return false; }
+                state = FIRST;
+                cp++;
+                continue;
+            }
+            if (state == NEXT && (ch == ',' || ch == ']')) {
+                state = ch == ',' ? VALUE : DONE;
+                cp++;
+                continue;
+            }
+            if (state == FIRST && ch == ']') {
+                state = DONE;
+                cp++;
+                continue;
+            }
+            if (state != FIRST && state != VALUE) { state = FAILED; return false; }
+            if (ch == ',' || ch == ']' || ch == '}' || ch == ':') { state = FAILED; return false; }
+            break;
+        }
+        // An element starts at cp
+        uint32_t start = cp;
+        scalar = c[cp] != '"' && c[cp] != '{' && c[cp] != '[';
+        in_str = c[cp] == '"';
+        esc = false;
+        depth = 0;
+        if (in_str) cp++;
+        if (scan(c, cp, cn)) {
+            state = NEXT;
+            e = c + start;
+            en = cp - start;
+            return true;
+        }
+        state = IN;
+        tail_len = 0;
+        append(c + start, cn - start);
+        cp = cn;
+        return false;
+    }
+};
+
+)";
+    }
+    if (stringify) {
+        out << R"(
+// Json.stringify: size() is the exact encoded length of a value and write()
+// encodes it at o, advancing o. stringify() (emitted with the per-type
+// overloads) sizes the output first, so the encoding is built in one pass
+// into a buffer of the right length.
+
+inline void put(char*& o, const char* s, uint32_t n) { __builtin_memcpy(o, s, n); o += n; }
+
+inline uint32_t size(bool v) { return v ? 4 : 5; }
+inline void write(char*& o, bool v) { if (v) put(o, "true", 4); else put(o, "false", 5); }
+
+inline uint32_t digits(uint64_t u) { uint32_t n = 1; while (u >= 10) { u /= 10; n++; } return n; }
+
+inline void write_digits(char*& o, uint64_t u) {
+    char* e = o + digits(u);
+    o = e;
+    do { *--e = (char)('0' + u % 10); u /= 10; } while (u);
 }
 
-inline bool is_valid(const char* s, uint32_t len) {
-    uint32_t p = skip_ws(s, 0, len);
-    if (p >= len || s[p] != '{') return false;
-    int d = 0; bool in_str = false;
-    for (uint32_t i = p; i < len; i++) {
-        char c = s[i];
-        if (in_str) { if (c == '\\' && i + 1 < len) { i++; continue; } if (c == '"') in_str = false; }
-        else { if (c == '"') in_str = true; else if (c == '{' || c == '[') d++; else if (c == '}' || c == ']') d--; }
+inline uint64_t magnitude(int64_t v) { return v < 0 ? 0 - (uint64_t)v : (uint64_t)v; }
+
+inline uint32_t size(int32_t v) { return (v < 0) + digits(magnitude(v)); }
+inline uint32_t size(int64_t v) { return (v < 0) + digits(magnitude(v)); }
+inline uint32_t size(uint32_t v) { return digits(v); }
+inline uint32_t size(uint64_t v) { return digits(v); }
+inline void write(char*& o, int32_t v) { if (v < 0) *o++ = '-'; write_digits(o, magnitude(v)); }
+inline void write(char*& o, int64_t v) { if (v < 0) *o++ = '-'; write_digits(o, magnitude(v)); }
+inline void write(char*& o, uint32_t v) { write_digits(o, v); }
+inline void write(char*& o, uint64_t v) { write_digits(o, v); }
+
+// Floats are formatted as everywhere else in Coi; NaN and infinities have no
+// JSON form and are written as null.
+inline uint32_t size(double v) {
+    if (v != v || v - v != 0) return 4;
+    webcc::formatter<32> f;
+    f << v;
+    uint32_t n = 0;
+    for (const char* c = f.c_str(); *c; c++) n++;
+    return n;
+}
+
+inline void write(char*& o, double v) {
+    if (v != v || v - v != 0) { put(o, "null", 4); return; }
+    webcc::formatter<32> f;
+    f << v;
+    for (const char* c = f.c_str(); *c; c++) *o++ = *c;
+}
+
+// First byte at or after p that must be escaped ('"', '\\' or a control
+// character), or n. Bytes of multi-byte UTF-8 sequences are copied as-is.
+inline uint32_t scan_escape(const char* s, uint32_t p, uint32_t n) {
+#ifdef __wasm_simd128__
+    for (; p + 16 <= n; p += 16) {
+        v128_t v = wasm_v128_load(s + p);
+        uint32_t m = wasm_i8x16_bitmask(wasm_v128_or(wasm_v128_or(wasm_i8x16_eq(v, wasm_i8x16_splat('"')),
+                                                                  wasm_i8x16_eq(v, wasm_i8x16_splat('\\'))),
+                                                     wasm_u8x16_lt(v, wasm_i8x16_splat(0x20))));
+        if (m) return p + __builtin_ctz(m);
     }
-    return d == 0 && !in_str;
+#endif
+    for (; p + 8 <= n; p += 8) {
+        uint64_t w = load8(s + p);
+        uint64_t m = match8(w, '"') | match8(w, '\\') | ((w - ONES * 0x20) & ~w & HIGHS);
+        if (m) return p + first8(m);
+    }
+    while (p < n && s[p] != '"' && s[p] != '\\' && (uint8_t)s[p] >= 0x20) p++;
+    return p;
 }
 
-template<typename F>
-inline void for_each(const char* s, uint32_t p, uint32_t len, F fn) {
-    p = skip_ws(s, p, len);
-    if (p >= len || s[p] != '[') return;
-    p++; p = skip_ws(s, p, len);
-    while (p < len && s[p] != ']') {
-        fn(s, p, len);
-        char c = s[p];
-        if (c == '{' || c == '[') { auto v = isolate(s, p, len); p += v.length(); }
-        else if (c == '"') { p++; while (p < len && s[p] != '"') { if (s[p] == '\\') p++; p++; } p++; }
-        else { while (p < len && s[p] != ',' && s[p] != ']') p++; }
-        p = skip_ws(s, p, len);
-        if (p < len && s[p] == ',') { p++; p = skip_ws(s, p, len); }
+inline uint32_t escape_size(char c) {
+    return c == '"' || c == '\\' || c == '\n' || c == '\r' || c == '\t' || c == '\b' || c == '\f' ? 2 : 6;
+}
+
+inline void write_escape(char*& o, char c) {
+    *o++ = '\\';
+    switch (c) {
+        case '"': *o++ = '"'; return;
+        case '\\': *o++ = '\\'; return;
+        case '\n': *o++ = 'n'; return;
+        case '\r': *o++ = 'r'; return;
+        case '\t': *o++ = 't'; return;
+        case '\b': *o++ = 'b'; return;
+        case '\f': *o++ = 'f'; return;
+    }
+    put(o, "u00", 3);
+    *o++ = "0123456789abcdef"[(uint8_t)c >> 4];
+    *o++ = "0123456789abcdef"[c & 15];
+}
+
+inline uint32_t size(const coi::string& v) {
+    const char* s = v.data();
+    uint32_t n = v.length();
+    uint32_t r = n + 2;
+    for (uint32_t p = scan_escape(s, 0, n); p < n; p = scan_escape(s, p + 1, n)) r += escape_size(s[p]) - 1;
+    return r;
+}
+
+inline void write(char*& o, const coi::string& v) {
+    const char* s = v.data();
+    uint32_t n = v.length();
+    *o++ = '"';
+    for (uint32_t q = 0;;) {
+        uint32_t p = scan_escape(s, q, n);
+        put(o, s + q, p - q);
+        if (p >= n) break;
+        write_escape(o, s[p]);
+        q = p + 1;
     }
+    *o++ = '"';
 }
 
-} // namespace __coi_json
+)";
+    }
+    out << R"(} // namespace __coi_json
 
 )";
+    if (parse) {
+        out << "using JsonStream = __coi_json::Stream;\n\n";
+    }
 }
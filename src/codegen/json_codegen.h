@@ -1,7 +1,8 @@
 // =============================================================================
 // JSON Code Generation for Coi
 // 
-// Generates C++ code for Json.parse() intrinsic calls.
+// Generates C++ code for the Json.parse(), Json.feed() and Json.stringify()
+// intrinsics.
 // Uses static schema mapping - no runtime parser, just hardcoded field extraction.
 // =============================================================================
 
@@ -39,15 +40,35 @@ std::string generate_json_parse(
     const std::string& json_expr             // e.g., "jsonString"
 );
 
+// Generate Json.feed for a root-level array type (e.g., "User[]"): decodes the
+// elements that `json_expr` completes in the __coi_json::Stream `stream_expr`
+std::string generate_json_feed(
+    const std::string& array_type,
+    const std::string& stream_expr,
+    const std::string& json_expr
+);
+
 // Field token helpers used by Meta.has(Type.field)
 std::string field_token_symbol_name(const std::string& data_type, const std::string& field_name);
 std::string generate_field_token_constants(const std::string& data_type);
 
 // Generate the Meta struct definition for a data type
-// Returns the struct code (e.g., "struct UserMeta : json::MetaBase { ... }")
+// Returns the struct code (e.g., "struct UserMeta : __coi_json::MetaBase<N> { ... }")
 std::string generate_meta_struct(const std::string& data_type);
 
+// An enum written by Json.stringify, with its values in declaration order
+struct JsonEnum {
+    std::string name;                 // C++ type name (e.g., "App_Level")
+    std::vector<std::string> values;
+};
+
+// Generate the Json.stringify serializers: size()/write() overloads for every
+// listed data type (which must be registered) and enum, plus stringify()
+std::string generate_json_writers(const std::vector<std::string>& data_types,
+                                  const std::vector<JsonEnum>& enums);
+
 // Emit the JSON runtime helpers directly into the output stream
-// This is called once at the top of app.cc when Json.parse is used
-void emit_json_runtime(std::ostream& out);
+// This is called once at the top of app.cc when Json.parse or Json.stringify
+// is used; each flag adds the helpers of that direction
+void emit_json_runtime(std::ostream& out, bool parse, bool stringify);
 
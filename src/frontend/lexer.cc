@@ -3,7 +3,7 @@
 #include <unordered_map>
 #include "../cli/error.h"
 
-Lexer::Lexer(const std::string& src) : source(src){}
+Lexer::Lexer(std::string_view src) : source(src){}
 
 char Lexer::current(){
     return pos < source.size() ? source[pos] : '\0';
@@ -16,9 +16,6 @@ char Lexer::peek(int offset){
 void Lexer::advance(){
     if(current() == '\n'){
         line++;
-        column = 1;
-    }else{
-        column++;
     }
     pos++;
 }
@@ -29,46 +26,42 @@ void Lexer::skip_whitespace(){
 
 void Lexer::skip_comment(){
     if(current() == '/' && peek() == '/'){
-        while(current() != '\n' && current() != '\0') advance();
+        while(current() != '\n' && current() != '\0') pos++;
     }
 }
 
-Token Lexer::make_token(TokenType type, const std::string& value){
-    return Token{type, value, line, column};
+// Columns are only needed for error messages, so they are not tracked
+int Lexer::column_at(size_t offset){
+    size_t line_start = source.rfind('\n', offset == 0 ? 0 : offset - 1);
+    return static_cast<int>(line_start == std::string_view::npos ? offset + 1 : offset - line_start);
+}
+
+Token Lexer::make_token(TokenType type, uint32_t length){
+    return Token{type, static_cast<uint32_t>(pos), length, line};
 }
 
 Token Lexer::read_number(){
-    int start_line = line;
-    int start_column = column;
-    std::string num;
+    size_t start = pos;
     bool is_float = false;
 
     // Check for hexadecimal (0x prefix)
     if(current() == '0' && (peek() == 'x' || peek() == 'X')){
-        num += current(); advance(); // '0'
-        num += current(); advance(); // 'x' or 'X'
+        pos += 2;
         
         // Read hexadecimal digits
-        while(std::isxdigit(current())){
-            num += current();
-            advance();
-        }
+        while(std::isxdigit(current())) pos++;
         
-        return Token{TokenType::INT_LITERAL, num, start_line, start_column};
+        return Token{TokenType::INT_LITERAL, static_cast<uint32_t>(start), static_cast<uint32_t>(pos - start), line};
     }
 
     // Check for binary (0b prefix)
     if(current() == '0' && (peek() == 'b' || peek() == 'B')){
-        num += current(); advance(); // '0'
-        num += current(); advance(); // 'b' or 'B'
+        pos += 2;
         
         // Read binary digits
-        while(current() == '0' || current() == '1'){
-            num += current();
-            advance();
-        }
+        while(current() == '0' || current() == '1') pos++;
         
-        return Token{TokenType::INT_LITERAL, num, start_line, start_column};
+        return Token{TokenType::INT_LITERAL, static_cast<uint32_t>(start), static_cast<uint32_t>(pos - start), line};
     }
 
     // Regular decimal number
@@ -77,79 +70,93 @@ Token Lexer::read_number(){
             if(is_float) break;
             is_float = true;
         }
-        num += current();
-        advance();
+        pos++;
     }
 
-    return Token{is_float ? TokenType::FLOAT_LITERAL : TokenType::INT_LITERAL, num, start_line, start_column};
+    return Token{is_float ? TokenType::FLOAT_LITERAL : TokenType::INT_LITERAL,
+                 static_cast<uint32_t>(start), static_cast<uint32_t>(pos - start), line};
 }
 
+// String and template literals are only delimited here; literal_value()
+// decodes them when the parser needs the text.
 Token Lexer::read_string(){
     int start_line = line;
-    int start_column = column;
-    std::string str;
+    size_t start = pos;
     advance(); // skip opening quote
 
     while(current() != '"' && current() != '\0'){
-        if(current() == '\\'){
-            advance();
-            switch (current()) {
-                case 'n' : str += '\n'; break;
-                case 't' : str += '\t'; break;
-                case '\\' : str += '\\'; break;
-                case '"' : str += '"'; break;
-                case '$' : str += "\\$"; break;  // Escape $ for ${} interpolation
-                default: str += current();
-            }
-        }else{
-            str += current();
-        }
+        if(current() == '\\') advance();
         advance();
     }
 
     if (current() == '\0') {
-        ErrorHandler::compiler_error("Unterminated string literal at line " + std::to_string(start_line) + ", column " + std::to_string(start_column), start_line);
+        ErrorHandler::compiler_error("Unterminated string literal at line " + std::to_string(start_line) + ", column " + std::to_string(column_at(start)), start_line);
     }
 
     advance(); // skip closing quote
-    return Token{TokenType::STRING_LITERAL, str, start_line, start_column};
+    return Token{TokenType::STRING_LITERAL, static_cast<uint32_t>(start), static_cast<uint32_t>(pos - start), start_line};
 }
 
 Token Lexer::read_template_string(){
     int start_line = line;
-    int start_column = column;
-    std::string str;
+    size_t start = pos;
     advance(); // skip opening backtick
 
     while(current() != '`' && current() != '\0'){
         // Template strings support raw content - no escape sequences except for backtick
-        if(current() == '\\' && peek() == '`'){
-            advance(); // skip backslash
-            str += '`'; // add literal backtick
-            advance();
-        }else{
-            str += current();
-            advance();
-        }
+        if(current() == '\\' && peek() == '`') advance();
+        advance();
+    }
+
+    if (current() == '\0') {
+        ErrorHandler::compiler_error("Unterminated template string at line " + std::to_string(start_line) + ", column " + std::to_string(column_at(start)), start_line);
     }
 
     advance(); // skip closing backtick
-    return Token{TokenType::TEMPLATE_STRING, str, start_line, start_column};
+    return Token{TokenType::TEMPLATE_STRING, static_cast<uint32_t>(start), static_cast<uint32_t>(pos - start), start_line};
 }
 
-Token Lexer::read_identifier(){
-    int start_line = line;
-    int start_column = column;
-    std::string id;
-    id.reserve(32);  // Pre-allocate for typical identifier lengths
+std::string Lexer::literal_value(std::string_view source, const Token& tok){
+    std::string_view body = source.substr(tok.offset + 1, tok.length - 2);
+    if(body.find('\\') == std::string_view::npos) return std::string(body);
 
-    while(std::isalnum(current()) || current() == '_'){
-        id += current();
-        advance();
+    std::string str;
+    str.reserve(body.size());
+    for(size_t i = 0; i < body.size(); i++){
+        char c = body[i];
+        if(tok.type == TokenType::TEMPLATE_STRING){
+            // Only \` is an escape in template strings
+            if(c == '\\' && i + 1 < body.size() && body[i + 1] == '`') c = body[++i];
+            str += c;
+            continue;
+        }
+        if(c != '\\' || i + 1 == body.size()){
+            str += c;
+            continue;
+        }
+        char next = body[++i];
+        switch (next) {
+            case 'n' : str += '\n'; break;
+            case 't' : str += '\t'; break;
+            case '\\' : str += '\\'; break;
+            case '"' : str += '"'; break;
+            case '$' : str += "\\$"; break;  // Escape $ for ${} interpolation
+            default: str += next;
+        }
     }
+    return str;
+}
+
+Token Lexer::read_identifier(){
+    size_t start = pos;
+
+    while(std::isalnum(current()) || current() == '_') pos++;
+
+    std::string_view id = source.substr(start, pos - start);
+    Token tok{TokenType::IDENTIFIER, static_cast<uint32_t>(start), static_cast<uint32_t>(pos - start), line};
 
     // Check for keywords
-    static const std::unordered_map<std::string, TokenType> keywords = {
+    static const std::unordered_map<std::string_view, TokenType> keywords = {
         {"component", TokenType::COMPONENT},
         {"def", TokenType::DEF},
         {"return", TokenType::RETURN},
@@ -187,10 +194,9 @@ Token Lexer::read_identifier(){
 
     auto it = keywords.find(id);
     if(it != keywords.end()){
-        return Token{it->second, id, start_line, start_column};
+        tok.type = it->second;
     }
-
-    return Token{TokenType::IDENTIFIER, id, start_line, start_column};
+    return tok;
 }
 
 std::vector<Token> Lexer::tokenize(){
@@ -236,155 +242,155 @@ std::vector<Token> Lexer::tokenize(){
 
         // Two-character operators
         if(current() == '=' && peek() == '='){
-            tokens.push_back(make_token(TokenType::EQ, "=="));
+            tokens.push_back(make_token(TokenType::EQ, 2));
             advance(); advance();
             continue;
         }
         if (current() == '!' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::NEQ, "!="));
+            tokens.push_back(make_token(TokenType::NEQ, 2));
             advance(); advance();
             continue;
         }
         if (current() == '<' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::LTE, "<="));
+            tokens.push_back(make_token(TokenType::LTE, 2));
             advance(); advance();
             continue;
         }
         if (current() == '>' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::GTE, ">="));
+            tokens.push_back(make_token(TokenType::GTE, 2));
             advance(); advance();
             continue;
         }
         if (current() == '+' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::PLUS_ASSIGN, "+="));
+            tokens.push_back(make_token(TokenType::PLUS_ASSIGN, 2));
             advance(); advance();
             continue;
         }
         if (current() == '-' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::MINUS_ASSIGN, "-="));
+            tokens.push_back(make_token(TokenType::MINUS_ASSIGN, 2));
             advance(); advance();
             continue;
         }
         if (current() == '+' && peek() == '+') {
-            tokens.push_back(make_token(TokenType::PLUS_PLUS, "++"));
+            tokens.push_back(make_token(TokenType::PLUS_PLUS, 2));
             advance(); advance();
             continue;
         }
         if (current() == '-' && peek() == '-') {
-            tokens.push_back(make_token(TokenType::MINUS_MINUS, "--"));
+            tokens.push_back(make_token(TokenType::MINUS_MINUS, 2));
             advance(); advance();
             continue;
         }
         if (current() == '*' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::STAR_ASSIGN, "*="));
+            tokens.push_back(make_token(TokenType::STAR_ASSIGN, 2));
             advance(); advance();
             continue;
         }
         if (current() == '/' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::SLASH_ASSIGN, "/="));
+            tokens.push_back(make_token(TokenType::SLASH_ASSIGN, 2));
             advance(); advance();
             continue;
         }
         if (current() == '%' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::PERCENT_ASSIGN, "%="));
+            tokens.push_back(make_token(TokenType::PERCENT_ASSIGN, 2));
             advance(); advance();
             continue;
         }
         if (current() == '&' && peek() == '&') {
-            tokens.push_back(make_token(TokenType::AND, "&&"));
+            tokens.push_back(make_token(TokenType::AND, 2));
             advance(); advance();
             continue;
         }
         if (current() == '|' && peek() == '|') {
-            tokens.push_back(make_token(TokenType::OR, "||"));
+            tokens.push_back(make_token(TokenType::OR, 2));
             advance(); advance();
             continue;
         }
         if (current() == '=' && peek() == '>') {
-            tokens.push_back(make_token(TokenType::ARROW, "=>"));
+            tokens.push_back(make_token(TokenType::ARROW, 2));
             advance(); advance();
             continue;
         }
         if (current() == ':' && peek() == ':') {
-            tokens.push_back(make_token(TokenType::DOUBLE_COLON, "::"));
+            tokens.push_back(make_token(TokenType::DOUBLE_COLON, 2));
             advance(); advance();
             continue;
         }
         if (current() == ':' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::MOVE_ASSIGN, ":="));
+            tokens.push_back(make_token(TokenType::MOVE_ASSIGN, 2));
             advance(); advance();
             continue;
         }
         // Bitwise shift operators (check before single < or >)
         if (current() == '<' && peek() == '<') {
             if (peek(2) == '=') {
-                tokens.push_back(make_token(TokenType::LSHIFT_ASSIGN, "<<="));
+                tokens.push_back(make_token(TokenType::LSHIFT_ASSIGN, 3));
                 advance(); advance(); advance();
             } else {
-                tokens.push_back(make_token(TokenType::LSHIFT, "<<"));
+                tokens.push_back(make_token(TokenType::LSHIFT, 2));
                 advance(); advance();
             }
             continue;
         }
         if (current() == '>' && peek() == '>') {
             if (peek(2) == '=') {
-                tokens.push_back(make_token(TokenType::RSHIFT_ASSIGN, ">>="));
+                tokens.push_back(make_token(TokenType::RSHIFT_ASSIGN, 3));
                 advance(); advance(); advance();
             } else {
-                tokens.push_back(make_token(TokenType::RSHIFT, ">>"));
+                tokens.push_back(make_token(TokenType::RSHIFT, 2));
                 advance(); advance();
             }
             continue;
         }
         // Bitwise compound assignment
         if (current() == '&' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::AMPERSAND_ASSIGN, "&="));
+            tokens.push_back(make_token(TokenType::AMPERSAND_ASSIGN, 2));
             advance(); advance();
             continue;
         }
         if (current() == '|' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::PIPE_ASSIGN, "|="));
+            tokens.push_back(make_token(TokenType::PIPE_ASSIGN, 2));
             advance(); advance();
             continue;
         }
         if (current() == '^' && peek() == '=') {
-            tokens.push_back(make_token(TokenType::CARET_ASSIGN, "^="));
+            tokens.push_back(make_token(TokenType::CARET_ASSIGN, 2));
             advance(); advance();
             continue;
         }
 
         // Single-character tokens
         switch (current()) {
-            case '+': tokens.push_back(make_token(TokenType::PLUS, "+")); break;
-            case '-': tokens.push_back(make_token(TokenType::MINUS, "-")); break;
-            case '*': tokens.push_back(make_token(TokenType::STAR, "*")); break;
-            case '/': tokens.push_back(make_token(TokenType::SLASH, "/")); break;
-            case '%': tokens.push_back(make_token(TokenType::PERCENT, "%")); break;
-            case '=': tokens.push_back(make_token(TokenType::ASSIGN, "=")); break;
-            case '<': tokens.push_back(make_token(TokenType::LT, "<")); break;
-            case '>': tokens.push_back(make_token(TokenType::GT, ">")); break;
-            case '!': tokens.push_back(make_token(TokenType::NOT, "!")); break;
-            case '?': tokens.push_back(make_token(TokenType::QUESTION, "?")); break;
-            case '(': tokens.push_back(make_token(TokenType::LPAREN, "(")); break;
-            case ')': tokens.push_back(make_token(TokenType::RPAREN, ")")); break;
-            case '{': tokens.push_back(make_token(TokenType::LBRACE, "{")); break;
-            case '}': tokens.push_back(make_token(TokenType::RBRACE, "}")); break;
-            case '[': tokens.push_back(make_token(TokenType::LBRACKET, "[")); break;
-            case ']': tokens.push_back(make_token(TokenType::RBRACKET, "]")); break;
-            case ';': tokens.push_back(make_token(TokenType::SEMICOLON, ";")); break;
-            case ',': tokens.push_back(make_token(TokenType::COMMA, ",")); break;
-            case '.': tokens.push_back(make_token(TokenType::DOT, ".")); break;
-            case ':': tokens.push_back(make_token(TokenType::COLON, ":")); break;
-            case '&': tokens.push_back(make_token(TokenType::AMPERSAND, "&")); break;
-            case '|': tokens.push_back(make_token(TokenType::PIPE, "|")); break;
-            case '^': tokens.push_back(make_token(TokenType::CARET, "^")); break;
-            case '~': tokens.push_back(make_token(TokenType::TILDE, "~")); break;
+            case '+': tokens.push_back(make_token(TokenType::PLUS)); break;
+            case '-': tokens.push_back(make_token(TokenType::MINUS)); break;
+            case '*': tokens.push_back(make_token(TokenType::STAR)); break;
+            case '/': tokens.push_back(make_token(TokenType::SLASH)); break;
+            case '%': tokens.push_back(make_token(TokenType::PERCENT)); break;
+            case '=': tokens.push_back(make_token(TokenType::ASSIGN)); break;
+            case '<': tokens.push_back(make_token(TokenType::LT)); break;
+            case '>': tokens.push_back(make_token(TokenType::GT)); break;
+            case '!': tokens.push_back(make_token(TokenType::NOT)); break;
+            case '?': tokens.push_back(make_token(TokenType::QUESTION)); break;
+            case '(': tokens.push_back(make_token(TokenType::LPAREN)); break;
+            case ')': tokens.push_back(make_token(TokenType::RPAREN)); break;
+            case '{': tokens.push_back(make_token(TokenType::LBRACE)); break;
+            case '}': tokens.push_back(make_token(TokenType::RBRACE)); break;
+            case '[': tokens.push_back(make_token(TokenType::LBRACKET)); break;
+            case ']': tokens.push_back(make_token(TokenType::RBRACKET)); break;
+            case ';': tokens.push_back(make_token(TokenType::SEMICOLON)); break;
+            case ',': tokens.push_back(make_token(TokenType::COMMA)); break;
+            case '.': tokens.push_back(make_token(TokenType::DOT)); break;
+            case ':': tokens.push_back(make_token(TokenType::COLON)); break;
+            case '&': tokens.push_back(make_token(TokenType::AMPERSAND)); break;
+            case '|': tokens.push_back(make_token(TokenType::PIPE)); break;
+            case '^': tokens.push_back(make_token(TokenType::CARET)); break;
+            case '~': tokens.push_back(make_token(TokenType::TILDE)); break;
             default:
-                tokens.push_back(make_token(TokenType::UNKNOWN, std::string(1, current())));
+                tokens.push_back(make_token(TokenType::UNKNOWN));
         }
         advance();
     }
 
-    tokens.push_back(make_token(TokenType::END_OF_FILE, ""));
+    tokens.push_back(make_token(TokenType::END_OF_FILE, 0));
     return tokens;
 }
@@ -2,26 +2,32 @@
 
 #include "token.h"
 #include <string>
+#include <string_view>
 #include <vector>
 
 class Lexer {
     private:
-        std::string source;
+        std::string_view source;
         size_t pos = 0;
         int line = 1;
-        int column = 1;
 
         char current();
         char peek(int offset = 1);
         void advance();
         void skip_whitespace();
         void skip_comment();
-        Token make_token(TokenType type, const std::string& value = "");
+        int column_at(size_t offset);
+        Token make_token(TokenType type, uint32_t length = 1);
         Token read_number();
         Token read_string();
         Token read_template_string();
         Token read_identifier();
     public:
-        Lexer(const std::string& src);
+        // The source is not copied: it must outlive the tokens
+        Lexer(std::string_view src);
         std::vector<Token> tokenize();
+
+        // Contents of a string or template literal token without its quotes,
+        // with escapes decoded
+        static std::string literal_value(std::string_view source, const Token& tok);
 };
@@ -0,0 +1,195 @@
+#include "loader.h"
+#include "lexer.h"
+#include "parse_cache.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+
+// Resolve an import of the file in dir to a canonical path:
+//   @scope/pkg-name -> .coi/pkgs/scope/pkg-name/Mod.coi
+//   @scope/pkg-name/path -> .coi/pkgs/scope/pkg-name/path.coi
+//   anything else -> relative to dir
+static LoadedFile::Import resolve_import(const ImportDecl& decl, const fs::path& dir, const fs::path& project_root){
+    LoadedFile::Import import;
+    import.is_public = decl.is_public;
+
+    fs::path import_path;
+    const std::string& import_str = decl.path;
+    if(!import_str.empty() && import_str[0] == '@'){
+        std::string pkg_path = import_str.substr(1);
+        size_t slash_count = static_cast<size_t>(std::count(pkg_path.begin(), pkg_path.end(), '/'));
+        if(slash_count == 0){
+            import.error = "package import must use scoped format @scope/name: " + import_str;
+            return import;
+        }
+        bool has_extension = pkg_path.size() >= 4 && pkg_path.substr(pkg_path.size() - 4) == ".coi";
+        if(slash_count == 1 && !has_extension) pkg_path += "/Mod.coi";
+        else if(!has_extension) pkg_path += ".coi";
+        import_path = project_root / ".coi" / "pkgs" / pkg_path;
+    } else {
+        import_path = dir / import_str;
+    }
+
+    try {
+        import.path = fs::canonical(import_path).string();
+    } catch(const std::exception& e){
+        import.error = "resolving import path " + decl.path + ": " + e.what();
+    }
+    return import;
+}
+
+namespace {
+
+// Work-stealing pool over file paths. Each worker pops the newest file from
+// its own queue, so a file's imports are parsed by the thread that found
+// them, and steals the oldest file from another queue when its own is empty.
+class LoadPool {
+    public:
+        LoadPool(const fs::path& project_root, SourceManager& sources, ParseCache* cache, int jobs)
+            : project_root(project_root), sources(sources), cache(cache){
+            for(int i = 0; i < jobs; i++) workers.push_back(std::make_unique<Worker>());
+        }
+
+        // Queue path on worker w unless some worker already saw it
+        void schedule(size_t w, const std::string& path){
+            {
+                std::lock_guard<std::mutex> guard(visited_lock);
+                if(!visited.insert(path).second) return;
+            }
+            pending++;
+            {
+                std::lock_guard<std::mutex> guard(workers[w]->lock);
+                workers[w]->tasks.push_back(path);
+            }
+            queued++;
+            std::lock_guard<std::mutex> guard(wait_lock);
+            wake.notify_one();
+        }
+
+        // Run worker w until every scheduled file is loaded
+        void work(size_t w){
+            std::string path;
+            while(true){
+                if(take(w, path)){
+                    load(w, path);
+                    if(--pending == 0){
+                        std::lock_guard<std::mutex> guard(wait_lock);
+                        wake.notify_all();
+                    }
+                    continue;
+                }
+                std::unique_lock<std::mutex> guard(wait_lock);
+                wake.wait(guard, [&]{ return pending == 0 || queued > 0; });
+                if(pending == 0) return;
+            }
+        }
+
+        std::map<std::string, LoadedFile> results;
+
+    private:
+        struct Worker {
+            std::mutex lock;
+            std::deque<std::string> tasks;
+        };
+
+        bool take(size_t w, std::string& path){
+            for(size_t i = 0; i < workers.size(); i++){
+                Worker& worker = *workers[(w + i) % workers.size()];
+                std::lock_guard<std::mutex> guard(worker.lock);
+                if(worker.tasks.empty()) continue;
+                if(i == 0){
+                    path = std::move(worker.tasks.back());
+                    worker.tasks.pop_back();
+                } else {
+                    path = std::move(worker.tasks.front());
+                    worker.tasks.pop_front();
+                }
+                queued--;
+                return true;
+            }
+            return false;
+        }
+
+        void load(size_t w, const std::string& path){
+            LoadedFile file;
+            std::string_view source;
+            file.opened = sources.load(path, source);
+            if(file.opened){
+                try {
+                    ParsedFile parsed;
+                    if(!cache || !cache->load(source, parsed)){
+                        Lexer lexer(source);
+                        Parser parser(source, lexer.tokenize());
+                        parser.parse_file();
+                        parsed.components = std::move(parser.components);
+                        parsed.global_data = std::move(parser.global_data);
+                        parsed.global_enums = std::move(parser.global_enums);
+                        parsed.imports = std::move(parser.imports);
+                        parsed.app_config = std::move(parser.app_config);
+                        if(cache) cache->store(source, parsed);
+                    }
+                    file.components = std::move(parsed.components);
+                    file.global_data = std::move(parsed.global_data);
+                    file.global_enums = std::move(parsed.global_enums);
+                    file.app_config = std::move(parsed.app_config);
+
+                    fs::path dir = fs::path(path).parent_path();
+                    for(const auto& decl : parsed.imports){
+                        file.imports.push_back(resolve_import(decl, dir, project_root));
+                    }
+                } catch(...){
+                    file.error = std::current_exception();
+                }
+            }
+
+            for(const auto& import : file.imports){
+                if(import.error.empty()) schedule(w, import.path);
+            }
+
+            std::lock_guard<std::mutex> guard(results_lock);
+            results.emplace(path, std::move(file));
+        }
+
+        const fs::path& project_root;
+        SourceManager& sources;
+        ParseCache* cache;
+        std::vector<std::unique_ptr<Worker>> workers;
+
+        std::mutex visited_lock;
+        std::unordered_set<std::string> visited;
+        std::mutex results_lock;
+
+        // Files scheduled but not yet loaded, and those of them still queued
+        std::atomic<size_t> pending{0};
+        std::atomic<size_t> queued{0};
+        std::mutex wait_lock;
+        std::condition_variable wake;
+};
+
+}
+
+std::map<std::string, LoadedFile> load_files(const std::string& entry, const fs::path& project_root,
+                                             int jobs, SourceManager& sources, std::deque<AstArena>& worker_arenas,
+                                             ParseCache* cache){
+    jobs = std::max(jobs, 1);
+    LoadPool pool(project_root, sources, cache, jobs);
+    pool.schedule(0, entry);
+
+    // Worker 0 is this thread, allocating from the caller's arena
+    std::vector<std::thread> threads;
+    for(int w = 1; w < jobs; w++){
+        AstArena& arena = worker_arenas.emplace_back();
+        threads.emplace_back([&pool, &arena, w]{
+            AstArena::Scope scope(arena);
+            pool.work(w);
+        });
+    }
+    pool.work(0);
+    for(auto& thread : threads) thread.join();
+    return std::move(pool.results);
+}
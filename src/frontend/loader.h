@@ -0,0 +1,41 @@
+#pragma once
+
+#include "source.h"
+#include "parser/parser.h"
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+class ParseCache;
+
+// A source file parsed by load_files, with its imports resolved
+struct LoadedFile {
+    struct Import {
+        std::string path;       // Canonical path of the imported file
+        bool is_public = false;
+        std::string error;      // Set instead of path when the import can't be resolved
+    };
+
+    bool opened = false;        // False if the file couldn't be read
+    std::exception_ptr error;   // Lexing or parsing failure, rethrown when the file is merged
+    std::vector<Component> components;
+    std::vector<std::unique_ptr<DataDef>> global_data;
+    std::vector<std::unique_ptr<EnumDef>> global_enums;
+    std::vector<Import> imports;  // In source order
+    AppConfig app_config;
+};
+
+// Lex and parse entry and every file it imports, directly or not, on up to
+// jobs threads. A parsed file schedules its unseen imports right away, and
+// idle threads steal queued files from busy ones. Results are keyed by
+// canonical path; callers merge them in import order so the outcome doesn't
+// depend on scheduling. Nodes parsed on extra threads are allocated from
+// arenas appended to worker_arenas, which must outlive the results. With a
+// cache, files parsed before are read from it, and files it misses are
+// stored in it once parsed.
+std::map<std::string, LoadedFile> load_files(const std::string& entry, const std::filesystem::path& project_root,
+                                             int jobs, SourceManager& sources, std::deque<AstArena>& worker_arenas,
+                                             ParseCache* cache = nullptr);
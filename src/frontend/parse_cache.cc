@@ -0,0 +1,621 @@
+#include "parse_cache.h"
+#include "defs/def_parser.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <typeinfo>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+// Layout of a cache file:
+//   Header, then the ParsedFile written by transfer() below
+// Values are stored in host byte order, since cache files never leave the
+// machine. Ints are varints, doubles are raw, strings and containers are
+// prefixed with a varint count, an optional value with a bool, and a
+// polymorphic node with a NodeKind byte (None for an empty slot) followed by
+// its line and fields.
+struct Header {
+    char magic[4];
+    uint32_t format_version;
+    uint64_t key;           // ParseCache::key of the compilation that wrote it
+    uint64_t source_hash;   // hash_bytes of the source
+    uint64_t source_size;
+    uint64_t payload_size;  // Bytes after the header
+};
+
+static constexpr char MAGIC[4] = {'C', 'O', 'I', 'P'};
+static constexpr time_t SECONDS_PER_DAY = 24 * 60 * 60;
+
+// Hash of bytes, eight at a time: FNV-1a's xor and multiply over 64-bit words,
+// with a shift that folds the high bits of each product back into the low ones
+static uint64_t hash_bytes(std::string_view bytes, uint64_t h = 1469598103934665603ULL){
+    constexpr uint64_t MULTIPLIER = 0x9e3779b97f4a7c15ULL;
+    size_t i = 0;
+    for(; i + 8 <= bytes.size(); i += 8){
+        uint64_t word;
+        std::memcpy(&word, bytes.data() + i, 8);
+        h = (h ^ word) * MULTIPLIER;
+        h ^= h >> 29;
+    }
+    for(; i < bytes.size(); i++){
+        h = (h ^ static_cast<unsigned char>(bytes[i])) * MULTIPLIER;
+        h ^= h >> 29;
+    }
+    return h;
+}
+
+// Every node type the parser creates, with constructor arguments for an
+// empty one. The position in this list is the node's kind in cache files
+#define PARSE_CACHE_NODES(X) \
+    X(IntLiteral, (0)) \
+    X(FloatLiteral, (0.0)) \
+    X(BoolLiteral, (false)) \
+    X(StringLiteral, ("")) \
+    X(Identifier, ("")) \
+    X(TypeLiteral, ("")) \
+    X(BinaryOp, (nullptr, "", nullptr)) \
+    X(FunctionCall, ("")) \
+    X(MemberAccess, (nullptr, "")) \
+    X(PostfixOp, (nullptr, "")) \
+    X(UnaryOp, ("", nullptr)) \
+    X(ReferenceExpression, (nullptr)) \
+    X(MoveExpression, (nullptr)) \
+    X(TernaryOp, (nullptr, nullptr, nullptr)) \
+    X(ArrayLiteral, ()) \
+    X(ArrayRepeatLiteral, ()) \
+    X(IndexAccess, (nullptr, nullptr)) \
+    X(EnumAccess, ("", "")) \
+    X(ComponentConstruction, ("")) \
+    X(MatchExpr, ()) \
+    X(BlockExpr, ()) \
+    X(VarDeclaration, ()) \
+    X(ComponentParam, ()) \
+    X(Assignment, ()) \
+    X(IndexAssignment, ()) \
+    X(MemberAssignment, ()) \
+    X(ReturnStatement, ()) \
+    X(ExpressionStatement, ()) \
+    X(BlockStatement, ()) \
+    X(BatchStatement, ()) \
+    X(IfStatement, ()) \
+    X(ForRangeStatement, ()) \
+    X(ForEachStatement, ()) \
+    X(EmitStatement, ()) \
+    X(TextNode, ("")) \
+    X(ComponentInstantiation, ()) \
+    X(HTMLElement, ()) \
+    X(ViewIfStatement, ()) \
+    X(ViewForRangeStatement, ()) \
+    X(ViewForEachStatement, ()) \
+    X(ViewRawElement, ()) \
+    X(RoutePlaceholder, ())
+
+enum class NodeKind : uint8_t {
+    None,
+#define NODE_KIND(T, ARGS) T,
+    PARSE_CACHE_NODES(NODE_KIND)
+#undef NODE_KIND
+    Count
+};
+
+// Slots of these types may hold any node, so they are written with a kind
+template<typename T>
+constexpr bool is_node_slot = std::is_same_v<T, ASTNode> || std::is_same_v<T, Expression> || std::is_same_v<T, Statement>;
+
+// The fields of each type, in file order, for both reading and writing. The
+// line of an ASTNode is handled by the IO class; nodes that shadow it with a
+// line of their own transfer that one here
+template<typename IO> static void transfer(IO& io, IntLiteral& n){ io(n.value); }
+template<typename IO> static void transfer(IO& io, FloatLiteral& n){ io(n.value); }
+template<typename IO> static void transfer(IO& io, BoolLiteral& n){ io(n.value); }
+template<typename IO> static void transfer(IO& io, StringLiteral& n){ io(n.value); io(n.is_template); }
+template<typename IO> static void transfer(IO& io, Identifier& n){ io(n.name); }
+template<typename IO> static void transfer(IO& io, TypeLiteral& n){ io(n.type_name); }
+template<typename IO> static void transfer(IO& io, BinaryOp& n){ io(n.left); io(n.op); io(n.right); }
+template<typename IO> static void transfer(IO& io, CallArg& a){ io(a.name); io(a.value); io(a.is_reference); io(a.is_move); }
+template<typename IO> static void transfer(IO& io, FunctionCall& n){ io(n.name); io(n.args); io(n.line); }
+template<typename IO> static void transfer(IO& io, MemberAccess& n){ io(n.object); io(n.member); }
+template<typename IO> static void transfer(IO& io, PostfixOp& n){ io(n.operand); io(n.op); }
+template<typename IO> static void transfer(IO& io, UnaryOp& n){ io(n.op); io(n.operand); }
+template<typename IO> static void transfer(IO& io, ReferenceExpression& n){ io(n.operand); }
+template<typename IO> static void transfer(IO& io, MoveExpression& n){ io(n.operand); }
+template<typename IO> static void transfer(IO& io, TernaryOp& n){ io(n.condition); io(n.true_expr); io(n.false_expr); }
+template<typename IO> static void transfer(IO& io, ArrayLiteral& n){ io(n.elements); io(n.element_type); }
+template<typename IO> static void transfer(IO& io, ArrayRepeatLiteral& n){ io(n.value); io(n.count); }
+template<typename IO> static void transfer(IO& io, IndexAccess& n){ io(n.array); io(n.index); }
+template<typename IO> static void transfer(IO& io, EnumAccess& n){ io(n.enum_name); io(n.value_name); io(n.component_name); }
+template<typename IO> static void transfer(IO& io, ComponentConstruction& n){ io(n.component_name); io(n.args); }
+template<typename IO> static void transfer(IO& io, MatchPattern::FieldPattern& f){ io(f.name); io(f.value); }
+template<typename IO> static void transfer(IO& io, MatchPattern::VariantBinding& b){ io(b.type); io(b.name); }
+template<typename IO> static void transfer(IO& io, MatchPattern& p){
+    io(p.kind); io(p.type_name); io(p.enum_value); io(p.literal_value); io(p.fields); io(p.variant_bindings);
+}
+template<typename IO> static void transfer(IO& io, MatchArm& a){ io(a.pattern); io(a.body); io(a.line); }
+template<typename IO> static void transfer(IO& io, MatchExpr& n){ io(n.subject); io(n.arms); io(n.line); }
+template<typename IO> static void transfer(IO& io, BlockExpr& n){ io(n.statements); }
+
+template<typename IO> static void transfer(IO& io, VarDeclaration& n){
+    io(n.type); io(n.name); io(n.initializer); io(n.is_mutable); io(n.is_reference); io(n.is_public); io(n.is_move);
+}
+template<typename IO> static void transfer(IO& io, ComponentParam& n){
+    io(n.type); io(n.name); io(n.default_value); io(n.is_mutable); io(n.is_reference); io(n.is_public);
+    io(n.callback_param_types); io(n.is_callback);
+}
+template<typename IO> static void transfer(IO& io, Assignment& n){ io(n.name); io(n.value); io(n.target_type); io(n.is_move); }
+template<typename IO> static void transfer(IO& io, IndexAssignment& n){
+    io(n.array); io(n.index); io(n.value); io(n.compound_op); io(n.is_move);
+}
+template<typename IO> static void transfer(IO& io, MemberAssignment& n){
+    io(n.object); io(n.member); io(n.value); io(n.compound_op); io(n.is_move);
+}
+template<typename IO> static void transfer(IO& io, ReturnStatement& n){ io(n.value); }
+template<typename IO> static void transfer(IO& io, ExpressionStatement& n){ io(n.expression); }
+template<typename IO> static void transfer(IO& io, BlockStatement& n){ io(n.statements); }
+template<typename IO> static void transfer(IO& io, BatchStatement& n){ transfer(io, static_cast<BlockStatement&>(n)); io(n.is_sync); }
+template<typename IO> static void transfer(IO& io, IfStatement& n){ io(n.condition); io(n.then_branch); io(n.else_branch); }
+template<typename IO> static void transfer(IO& io, ForRangeStatement& n){ io(n.var_name); io(n.start); io(n.end); io(n.body); }
+template<typename IO> static void transfer(IO& io, ForEachStatement& n){ io(n.var_name); io(n.iterable); io(n.body); }
+template<typename IO> static void transfer(IO& io, EmitStatement& n){ io(n.signal_name); io(n.args); }
+
+template<typename IO> static void transfer(IO& io, TextNode& n){ io(n.text); }
+template<typename IO> static void transfer(IO& io, HTMLAttribute& a){ io(a.name); io(a.value); }
+template<typename IO> static void transfer(IO& io, ComponentProp& p){
+    io(p.name); io(p.value); io(p.is_reference); io(p.is_move); io(p.is_mutable_def); io(p.is_callback); io(p.callback_param_types);
+}
+template<typename IO> static void transfer(IO& io, ComponentInstantiation& n){
+    io(n.component_name); io(n.module_prefix); io(n.props); io(n.is_member_reference); io(n.member_name);
+}
+template<typename IO> static void transfer(IO& io, HTMLElement& n){ io(n.tag); io(n.attributes); io(n.children); io(n.ref_binding); }
+template<typename IO> static void transfer(IO& io, ViewIfStatement& n){
+    io(n.condition); io(n.then_children); io(n.else_children); io(n.if_id); io(n.keep);
+}
+template<typename IO> static void transfer(IO& io, ViewForRangeStatement& n){
+    io(n.var_name); io(n.start); io(n.end); io(n.children); io(n.loop_id);
+}
+template<typename IO> static void transfer(IO& io, ViewForEachStatement& n){
+    io(n.var_name); io(n.iterable); io(n.key_expr); io(n.window_start); io(n.window_end); io(n.children);
+    io(n.loop_id); io(n.is_only_child);
+}
+template<typename IO> static void transfer(IO& io, ViewRawElement& n){ io(n.children); io(n.raw_id); }
+template<typename IO> static void transfer(IO& io, RoutePlaceholder& n){ io(n.line); }
+
+template<typename IO> static void transfer(IO& io, FunctionDef::Param& p){ io(p.type); io(p.name); io(p.is_mutable); io(p.is_reference); }
+template<typename IO> static void transfer(IO& io, FunctionDef& f){
+    io(f.name); io(f.return_type); io(f.is_public); io(f.type_params); io(f.params); io(f.body);
+}
+template<typename IO> static void transfer(IO& io, DataField& f){ io(f.type); io(f.name); }
+template<typename IO> static void transfer(IO& io, DataDef& d){
+    io(d.name); io(d.module_name); io(d.source_file); io(d.is_public); io(d.type_params); io(d.fields);
+}
+template<typename IO> static void transfer(IO& io, EnumDef& e){
+    io(e.name); io(e.module_name); io(e.source_file); io(e.is_public); io(e.values); io(e.is_shared); io(e.owner_component);
+}
+
+template<typename IO> static void transfer(IO& io, RouteParam& p){ io(p.name); io(p.type); }
+template<typename IO> static void transfer(IO& io, RouteCtorSlot& s){ io(s.is_path_param); io(s.index); }
+template<typename IO> static void transfer(IO& io, RouteEntry& r){
+    io(r.path); io(r.component_name); io(r.module_name); io(r.args); io(r.path_params); io(r.ctor_order);
+    io(r.is_default); io(r.keep); io(r.line);
+}
+template<typename IO> static void transfer(IO& io, RouterDef& r){ io(r.routes); io(r.has_route_placeholder); io(r.line); }
+template<typename IO> static void transfer(IO& io, SignalParam& p){ io(p.type); io(p.name); }
+template<typename IO> static void transfer(IO& io, SignalDef& s){ io(s.name); io(s.params); io(s.is_public); io(s.line); }
+template<typename IO> static void transfer(IO& io, ListenEntry& l){
+    io(l.target_name); io(l.signal_name); io(l.handler_method_name); io(l.param_types); io(l.target_is_reference); io(l.line);
+}
+template<typename IO> static void transfer(IO& io, Component& c){
+    io(c.name); io(c.module_name); io(c.source_file); io(c.is_public); io(c.css); io(c.global_css);
+    io(c.data); io(c.enums); io(c.state); io(c.params); io(c.signals); io(c.listen_entries); io(c.methods);
+    io(c.render_roots); io(c.router);
+}
+template<typename IO> static void transfer(IO& io, AppConfig& a){
+    io(a.root_component); io(a.routes); io(a.title); io(a.description); io(a.lang); io(a.base); io(a.schedule);
+    io(a.memo); io(a.coalesce); io(a.event_budget);
+}
+template<typename IO> static void transfer(IO& io, ImportDecl& d){ io(d.path); io(d.is_public); }
+template<typename IO> static void transfer(IO& io, ParsedFile& f){
+    io(f.components); io(f.global_data); io(f.global_enums); io(f.imports); io(f.app_config);
+}
+
+// Transfer the fields of n, whose dynamic type is kind
+template<typename IO> static void transfer_node(IO& io, NodeKind kind, ASTNode& n){
+    switch(kind){
+#define TRANSFER_NODE(T, ARGS) case NodeKind::T: io(static_cast<T&>(n)); break;
+        PARSE_CACHE_NODES(TRANSFER_NODE)
+#undef TRANSFER_NODE
+        default: break;
+    }
+}
+
+static NodeKind kind_of(const ASTNode& n){
+    static const std::type_info* const types[] = {
+        nullptr,
+#define TYPE_OF(T, ARGS) &typeid(T),
+        PARSE_CACHE_NODES(TYPE_OF)
+#undef TYPE_OF
+    };
+    // Within one program each type has a single type_info, so comparing
+    // addresses finds the kind without comparing type names
+    const std::type_info& type = typeid(n);
+    for(size_t k = 1; k < std::size(types); k++){
+        if(types[k] == &type) return static_cast<NodeKind>(k);
+    }
+    for(size_t k = 1; k < std::size(types); k++){
+        if(*types[k] == type) return static_cast<NodeKind>(k);
+    }
+    return NodeKind::Count;
+}
+
+static std::unique_ptr<ASTNode> make_node(NodeKind kind){
+    switch(kind){
+#define MAKE_NODE(T, ARGS) case NodeKind::T: return std::make_unique<T> ARGS;
+        PARSE_CACHE_NODES(MAKE_NODE)
+#undef MAKE_NODE
+        default: return nullptr;
+    }
+}
+
+// Ints are written as varints of their zigzag encoding, so small negative
+// values like the -1 of unset ids stay one byte
+static uint64_t zigzag(int v){ return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31); }
+static int unzigzag(uint64_t v){ return static_cast<int>(static_cast<uint32_t>(v >> 1) ^ -static_cast<uint32_t>(v & 1)); }
+
+// A value for the reader to fill in
+template<typename T> static T blank(){ return T(); }
+template<> ImportDecl blank<ImportDecl>(){ return ImportDecl(""); }
+
+namespace {
+
+// Appends what transfer() hands it to out; it only reads through the
+// references it gets
+class Writer {
+    public:
+        std::string out;
+        bool ok = true;  // False if a node of a type unknown to the cache was met
+
+        void operator()(bool& v){ out.push_back(v ? 1 : 0); }
+        void operator()(int& v){ put_varint(zigzag(v)); }
+        void operator()(double& v){ put(v); }
+        void operator()(std::string& s){ put_string(s); }
+
+        template<typename E> requires std::is_enum_v<E>
+        void operator()(E& v){ out.push_back(static_cast<char>(v)); }
+
+        void operator()(std::set<std::string>& s){
+            put_varint(s.size());
+            for(const auto& v : s) put_string(v);
+        }
+
+        void operator()(std::map<std::string, std::string>& m){
+            put_varint(m.size());
+            for(const auto& [k, v] : m){
+                put_string(k);
+                put_string(v);
+            }
+        }
+
+        template<typename T> void operator()(std::vector<T>& v){
+            put_varint(v.size());
+            for(auto& x : v) (*this)(x);
+        }
+
+        template<typename T> void operator()(std::unique_ptr<T>& p){
+            if constexpr(is_node_slot<T>){
+                NodeKind kind = p ? kind_of(*p) : NodeKind::None;
+                if(kind == NodeKind::Count){
+                    ok = false;
+                    return;
+                }
+                out.push_back(static_cast<char>(kind));
+                if(p) transfer_node(*this, kind, *p);
+            } else {
+                out.push_back(p ? 1 : 0);
+                if(p) (*this)(*p);
+            }
+        }
+
+        template<typename T> requires std::is_class_v<T>
+        void operator()(T& v){
+            if constexpr(std::is_base_of_v<ASTNode, T>) (*this)(static_cast<ASTNode&>(v).line);
+            transfer(*this, v);
+        }
+
+    private:
+        template<typename V> void put(const V& v){ out.append(reinterpret_cast<const char*>(&v), sizeof(v)); }
+
+        void put_varint(uint64_t v){
+            for(; v >= 0x80; v >>= 7) out.push_back(static_cast<char>(v | 0x80));
+            out.push_back(static_cast<char>(v));
+        }
+
+        void put_string(const std::string& s){
+            put_varint(s.size());
+            out.append(s);
+        }
+};
+
+// Reads what Writer wrote from [pos, end). Bounds are checked on every read;
+// past the first failure, reads yield empty values and ok stays false
+class Reader {
+    public:
+        Reader(const char* pos, const char* end) : pos(pos), end(end){}
+
+        bool ok = true;
+        bool at_end() const { return pos == end; }
+
+        void operator()(bool& v){
+            uint8_t b = 0;
+            get(b);
+            v = b != 0;
+        }
+        void operator()(int& v){ v = unzigzag(get_varint()); }
+        void operator()(double& v){ get(v); }
+        void operator()(std::string& s){
+            size_t size = count();
+            s.assign(pos, size);
+            pos += size;
+        }
+
+        template<typename E> requires std::is_enum_v<E>
+        void operator()(E& v){
+            uint8_t b = 0;
+            get(b);
+            v = static_cast<E>(b);
+        }
+
+        void operator()(std::set<std::string>& s){
+            for(size_t n = count(); n > 0 && ok; n--){
+                std::string v;
+                (*this)(v);
+                s.insert(std::move(v));
+            }
+        }
+
+        void operator()(std::map<std::string, std::string>& m){
+            for(size_t n = count(); n > 0 && ok; n--){
+                std::string k, v;
+                (*this)(k);
+                (*this)(v);
+                m[std::move(k)] = std::move(v);
+            }
+        }
+
+        template<typename T> void operator()(std::vector<T>& v){
+            for(size_t n = count(); n > 0 && ok; n--){
+                v.push_back(blank<T>());
+                (*this)(v.back());
+            }
+        }
+
+        template<typename T> void operator()(std::unique_ptr<T>& p){
+            if constexpr(is_node_slot<T>){
+                uint8_t b = 0;
+                get(b);
+                NodeKind kind = static_cast<NodeKind>(b);
+                if(kind == NodeKind::None) return;
+                std::unique_ptr<ASTNode> node = make_node(kind);
+                if(!node || !dynamic_cast<T*>(node.get())){
+                    ok = false;
+                    return;
+                }
+                transfer_node(*this, kind, *node);
+                p.reset(dynamic_cast<T*>(node.release()));
+            } else {
+                bool present = false;
+                (*this)(present);
+                if(!present) return;
+                p = std::make_unique<T>();
+                (*this)(*p);
+            }
+        }
+
+        template<typename T> requires std::is_class_v<T>
+        void operator()(T& v){
+            if constexpr(std::is_base_of_v<ASTNode, T>) (*this)(static_cast<ASTNode&>(v).line);
+            transfer(*this, v);
+        }
+
+    private:
+        template<typename V> void get(V& v){
+            if(!ok || static_cast<size_t>(end - pos) < sizeof(v)){
+                ok = false;
+                v = V();
+                return;
+            }
+            std::memcpy(&v, pos, sizeof(v));
+            pos += sizeof(v);
+        }
+
+        // A count of elements, each at least a byte long
+        uint64_t get_varint(){
+            uint64_t v = 0;
+            for(int shift = 0; shift < 64 && ok; shift += 7){
+                uint8_t b = 0;
+                get(b);
+                v |= static_cast<uint64_t>(b & 0x7f) << shift;
+                if(!(b & 0x80)) return v;
+            }
+            ok = false;
+            return 0;
+        }
+
+        size_t count(){
+            uint64_t n = get_varint();
+            if(n > static_cast<size_t>(end - pos)){
+                ok = false;
+                return 0;
+            }
+            return n;
+        }
+
+        const char* pos;
+        const char* end;
+};
+
+}
+
+// Decode the cache file at path into file if it was written under key for a
+// source of this size and hash
+static bool read_entry(const fs::path& path, uint64_t key, size_t source_size, uint64_t source_hash, ParsedFile& file){
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)){
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(data == MAP_FAILED){
+        close(fd);
+        return false;
+    }
+
+    const char* bytes = static_cast<const char*>(data);
+    Header header;
+    std::memcpy(&header, bytes, sizeof(header));
+    bool ok = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0
+        && header.format_version == ParseCache::FORMAT_VERSION
+        && header.key == key
+        && header.source_size == source_size
+        && header.source_hash == source_hash
+        && header.payload_size == size - sizeof(Header);
+    if(ok){
+        Reader reader(bytes + sizeof(Header), bytes + size);
+        reader(file);
+        ok = reader.ok && reader.at_end();
+        if(!ok) file = ParsedFile();
+    }
+    munmap(data, size);
+
+    // Mark the entry used for prune(), at most once a day
+    if(ok && st.st_mtime < time(nullptr) - SECONDS_PER_DAY) futimens(fd, nullptr);
+    close(fd);
+    return ok;
+}
+
+ParseCache::ParseCache(const fs::path& dir, const std::string& compiler_id) : dir(dir){
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    enabled = !ec;
+
+    // Names that are handle types can't be used for components, so a file
+    // parses differently against other defs
+    const DefSchema& schema = DefSchema::instance();
+    std::vector<std::string> handles;
+    for(const auto& [name, type] : schema.types()){
+        if(schema.is_handle(name)) handles.push_back(name);
+    }
+    std::sort(handles.begin(), handles.end());
+
+    key = hash_bytes(std::to_string(FORMAT_VERSION) + "\n" + compiler_id + "\n");
+    for(const auto& name : handles) key = hash_bytes(name + "\n", key);
+}
+
+fs::path ParseCache::entry_path(uint64_t source_hash) const {
+    uint64_t name_hash = hash_bytes(std::string_view(reinterpret_cast<const char*>(&source_hash), sizeof(source_hash)), key);
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.parse", static_cast<unsigned long long>(name_hash));
+    return dir / name;
+}
+
+bool ParseCache::load(std::string_view source, ParsedFile& file){
+    uint64_t source_hash = hash_bytes(source);
+    if(enabled && read_entry(entry_path(source_hash), key, source.size(), source_hash, file)){
+        hit_count++;
+        return true;
+    }
+    miss_count++;
+    return false;
+}
+
+void ParseCache::store(std::string_view source, const ParsedFile& file){
+    if(!enabled) return;
+
+    Writer writer;
+    writer.out.resize(sizeof(Header));
+    writer(const_cast<ParsedFile&>(file));
+    if(!writer.ok) return;
+
+    Header header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.format_version = FORMAT_VERSION;
+    header.key = key;
+    header.source_hash = hash_bytes(source);
+    header.source_size = source.size();
+    header.payload_size = writer.out.size() - sizeof(Header);
+    std::memcpy(writer.out.data(), &header, sizeof(header));
+
+    // Write under a name unique to this process and thread, then move it in
+    fs::path path = entry_path(header.source_hash);
+    fs::path temp = path;
+    temp += ".tmp" + std::to_string(getpid()) + "-" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    std::ofstream out(temp, std::ios::binary);
+    out.write(writer.out.data(), static_cast<std::streamsize>(writer.out.size()));
+    out.close();
+
+    std::error_code ec;
+    if(out) fs::rename(temp, path, ec);
+    if(!out || ec) fs::remove(temp, ec);
+}
+
+void ParseCache::prune(uint64_t max_bytes){
+    if(!enabled) return;
+
+    struct Entry {
+        time_t used;
+        uint64_t size;
+        fs::path path;
+    };
+    std::vector<Entry> kept;
+    uint64_t total = 0;
+    time_t now = time(nullptr);
+
+    std::error_code ec;
+    for(fs::directory_iterator it(dir, ec), end; !ec && it != end; it.increment(ec)){
+        const fs::path& path = it->path();
+        struct stat st;
+        if(stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)) continue;
+
+        // A temporary file is written and renamed within moments, unless
+        // its compilation died first
+        bool stale;
+        if(path.extension() != ".parse") stale = path.filename().string().find(".tmp") != std::string::npos && st.st_mtime < now - 60 * 60;
+        else if(st.st_mtime < now - MAX_AGE_DAYS * SECONDS_PER_DAY) stale = true;
+        else {
+            Header header{};
+            int fd = open(path.c_str(), O_RDONLY);
+            bool read_ok = fd >= 0 && read(fd, &header, sizeof(header)) == static_cast<ssize_t>(sizeof(header));
+            if(fd >= 0) close(fd);
+            stale = !read_ok
+                || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+                || header.format_version != FORMAT_VERSION
+                || header.key != key;
+        }
+
+        if(stale){
+            std::error_code remove_ec;
+            fs::remove(path, remove_ec);
+        } else if(path.extension() == ".parse"){
+            kept.push_back({st.st_mtime, static_cast<uint64_t>(st.st_size), path});
+            total += static_cast<uint64_t>(st.st_size);
+        }
+    }
+
+    if(total <= max_bytes) return;
+    std::sort(kept.begin(), kept.end(), [](const Entry& a, const Entry& b){ return a.used < b.used; });
+    for(const Entry& entry : kept){
+        if(total <= max_bytes) break;
+        std::error_code remove_ec;
+        if(fs::remove(entry.path, remove_ec)) total -= entry.size;
+    }
+}
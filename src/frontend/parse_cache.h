@@ -0,0 +1,66 @@
+#pragma once
+
+#include "parser/parser.h"
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// What parsing one source file produces. Imports are kept as written, so the
+// result doesn't depend on where the file is imported from
+struct ParsedFile {
+    std::vector<Component> components;
+    std::vector<std::unique_ptr<DataDef>> global_data;
+    std::vector<std::unique_ptr<EnumDef>> global_enums;
+    std::vector<ImportDecl> imports;
+    AppConfig app_config;
+};
+
+// Parse results persisted across compilations, one file per source content.
+// A cache file is named after a hash of the source text and of everything
+// else parsing depends on: the cache format, the compiler build and the
+// handle types of the loaded defs. It holds a fixed header followed by the
+// serialized ParsedFile, and is decoded in place from a read-only mapping.
+// Files are written under a temporary name and renamed, so concurrent
+// compilations never see a partial file. Safe to use from several threads.
+// Entries under another key are never read again, so prune() deletes them,
+// along with entries unused for MAX_AGE_DAYS and, past MAX_BYTES, the least
+// recently used ones.
+class ParseCache {
+    public:
+        // Bumped whenever the layout of a cache file or of any node changes
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        // Limits kept by prune(). A hit counts as a use at a day's resolution
+        static constexpr int MAX_AGE_DAYS = 30;
+        static constexpr uint64_t MAX_BYTES = 64ull << 20;
+
+        // Cache files live in dir, created if missing; compiler_id identifies
+        // the compiler build. Without a usable dir every lookup misses
+        ParseCache(const std::filesystem::path& dir, const std::string& compiler_id);
+
+        // Fill file from the cache entry for source; false on a miss
+        bool load(std::string_view source, ParsedFile& file);
+
+        // Save file as the parse result of source. Failures are ignored
+        void store(std::string_view source, const ParsedFile& file);
+
+        // Delete entries of other keys, leftover temporary files, entries
+        // older than MAX_AGE_DAYS, then the oldest entries until at most
+        // max_bytes remain. Not to be run alongside load or store
+        void prune(uint64_t max_bytes = MAX_BYTES);
+
+        size_t hits() const { return hit_count; }
+        size_t misses() const { return miss_count; }
+
+    private:
+        std::filesystem::path entry_path(uint64_t source_hash) const;
+
+        std::filesystem::path dir;
+        bool enabled = false;
+        uint64_t key = 0;  // Hash of what besides the source parsing depends on
+        std::atomic<size_t> hit_count{0};
+        std::atomic<size_t> miss_count{0};
+};
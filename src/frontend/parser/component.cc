@@ -7,7 +7,7 @@
 std::unique_ptr<DataDef> Parser::parse_data()
 {
     expect(TokenType::POD, "Expected 'pod'");
-    std::string name = current().value;
+    std::string name = value(current());
     int name_line = current().line;
     expect(TokenType::IDENTIFIER, "Expected pod name");
 
@@ -26,7 +26,7 @@ std::unique_ptr<DataDef> Parser::parse_data()
         advance(); // skip '<'
         while (current().type != TokenType::GT && current().type != TokenType::END_OF_FILE)
         {
-            std::string type_param = current().value;
+            std::string type_param = value(current());
             expect(TokenType::IDENTIFIER, "Expected type parameter name");
             
             // Type parameter names must start with uppercase
@@ -53,7 +53,7 @@ std::unique_ptr<DataDef> Parser::parse_data()
 
     while (current().type != TokenType::RBRACE && current().type != TokenType::END_OF_FILE)
     {
-        std::string type = current().value;
+        std::string type = value(current());
         // Handle types (excluding VOID - not valid for data fields)
         if (current().type == TokenType::INT || current().type == TokenType::STRING ||
             current().type == TokenType::FLOAT || current().type == TokenType::FLOAT32 ||
@@ -77,7 +77,7 @@ std::unique_ptr<DataDef> Parser::parse_data()
                 if (!first) type += ", ";
                 first = false;
                 
-                std::string arg_type = current().value;
+                std::string arg_type = value(current());
                 if (current().type == TokenType::INT || current().type == TokenType::STRING ||
                     current().type == TokenType::FLOAT || current().type == TokenType::FLOAT32 ||
                     current().type == TokenType::BOOL || current().type == TokenType::IDENTIFIER)
@@ -117,7 +117,7 @@ std::unique_ptr<DataDef> Parser::parse_data()
             type += parse_type_bracket_suffix();
         }
 
-        std::string fieldName = current().value;
+        std::string fieldName = value(current());
         expect(TokenType::IDENTIFIER, "Expected field name");
         expect(TokenType::SEMICOLON, "Expected ';'");
 
@@ -130,7 +130,7 @@ std::unique_ptr<DataDef> Parser::parse_data()
 std::unique_ptr<EnumDef> Parser::parse_enum()
 {
     expect(TokenType::ENUM, "Expected 'enum'");
-    std::string name = current().value;
+    std::string name = value(current());
     int name_line = current().line;
     expect(TokenType::IDENTIFIER, "Expected enum name");
 
@@ -147,7 +147,7 @@ std::unique_ptr<EnumDef> Parser::parse_enum()
 
     while (current().type != TokenType::RBRACE && current().type != TokenType::END_OF_FILE)
     {
-        std::string valueName = current().value;
+        std::string valueName = value(current());
         expect(TokenType::IDENTIFIER, "Expected enum value name");
         def->values.push_back(valueName);
 
@@ -188,7 +188,7 @@ std::unique_ptr<RouterDef> Parser::parse_router()
             {
                 throw std::runtime_error("Expected route path string or 'else' at line " + std::to_string(current().line));
             }
-            entry.path = current().value;
+            entry.path = value(current());
 
             // Extract dynamic ':' segments (e.g. "/users/:id" -> param "id").
             // Names are bound to the target component by the type checker.
@@ -227,7 +227,7 @@ std::unique_ptr<RouterDef> Parser::parse_router()
         {
             throw std::runtime_error("Expected component name after '=>' at line " + std::to_string(current().line));
         }
-        entry.component_name = current().value;
+        entry.component_name = value(current());
         advance();
 
         // Optional: parse component arguments (ComponentName(arg1, arg2))
@@ -239,6 +239,23 @@ std::unique_ptr<RouterDef> Parser::parse_router()
             expect(TokenType::RPAREN, "Expected ')' after component arguments");
         }
 
+        // Optional: 'keep' or 'keep N' parks the page instead of destroying it when
+        // navigating away; up to N pages (one per path) are kept, default 1
+        if (current().type == TokenType::IDENTIFIER && text(current()) == "keep")
+        {
+            advance();
+            entry.keep = 1;
+            if (current().type == TokenType::INT_LITERAL)
+            {
+                entry.keep = std::stoi(value(current()));
+                if (entry.keep < 1)
+                {
+                    throw std::runtime_error("Route 'keep' count must be at least 1 at line " + std::to_string(current().line));
+                }
+                advance();
+            }
+        }
+
         router->routes.push_back(std::move(entry));
 
         // Require semicolon after each route entry
@@ -263,7 +280,7 @@ SignalDef Parser::parse_signal(bool is_public)
 
     expect(TokenType::SIGNAL, "Expected 'signal'");
 
-    signal.name = current().value;
+    signal.name = value(current());
     int signal_name_line = current().line;
     expect(TokenType::IDENTIFIER, "Expected signal name");
 
@@ -280,7 +297,7 @@ SignalDef Parser::parse_signal(bool is_public)
     while (current().type != TokenType::RPAREN && current().type != TokenType::END_OF_FILE)
     {
         SignalParam param;
-        param.type = current().value;
+        param.type = value(current());
 
         if (is_type_token())
         {
@@ -299,7 +316,7 @@ SignalDef Parser::parse_signal(bool is_public)
 
         if (is_identifier_token())
         {
-            param.name = current().value;
+            param.name = value(current());
             advance();
         }
         else
@@ -340,7 +357,7 @@ void Parser::parse_listen_block(Component &comp)
             throw std::runtime_error("Expected component instance name in listen entry at line " + std::to_string(current().line));
         }
 
-        entry.target_name = current().value;
+        entry.target_name = value(current());
         advance();
 
         for (const auto &param : comp.params)
@@ -364,7 +381,7 @@ void Parser::parse_listen_block(Component &comp)
         }
 
         expect(TokenType::DOT, "Expected '.' before signal name in listen entry");
-        entry.signal_name = current().value;
+        entry.signal_name = value(current());
         expect(TokenType::IDENTIFIER, "Expected signal name in listen entry");
 
         expect(TokenType::ARROW, "Expected '=>' in listen entry");
@@ -380,7 +397,7 @@ void Parser::parse_listen_block(Component &comp)
                 advance();
             }
 
-            std::string param_type = current().value;
+            std::string param_type = value(current());
             if (is_type_token())
             {
                 advance();
@@ -396,7 +413,7 @@ void Parser::parse_listen_block(Component &comp)
                 param_type += parse_type_bracket_suffix();
             }
 
-            std::string param_name = current().value;
+            std::string param_name = value(current());
             if (is_identifier_token())
             {
                 advance();
@@ -453,44 +470,80 @@ void Parser::parse_app()
 
     while (current().type != TokenType::RBRACE && current().type != TokenType::END_OF_FILE)
     {
-        std::string key = current().value;
+        std::string key = value(current());
         expect(TokenType::IDENTIFIER, "Expected key");
         expect(TokenType::ASSIGN, "Expected '='");
 
         if (key == "root")
         {
-            app_config.root_component = current().value;
+            app_config.root_component = value(current());
             expect(TokenType::IDENTIFIER, "Expected component name");
         }
         else if (key == "title")
         {
-            app_config.title = current().value;
+            app_config.title = value(current());
             expect(TokenType::STRING_LITERAL, "Expected string");
         }
         else if (key == "description")
         {
-            app_config.description = current().value;
+            app_config.description = value(current());
             expect(TokenType::STRING_LITERAL, "Expected string");
         }
         else if (key == "lang")
         {
-            app_config.lang = current().value;
+            app_config.lang = value(current());
             expect(TokenType::STRING_LITERAL, "Expected string");
         }
         else if (key == "base")
         {
-            app_config.base = current().value;
+            app_config.base = value(current());
+            expect(TokenType::STRING_LITERAL, "Expected string");
+        }
+        else if (key == "schedule")
+        {
+            app_config.schedule = value(current());
+            if (app_config.schedule != "sync" && app_config.schedule != "frame")
+            {
+                throw std::runtime_error("App schedule must be \"sync\" or \"frame\" at line " + std::to_string(current().line));
+            }
             expect(TokenType::STRING_LITERAL, "Expected string");
         }
+        else if (key == "memo")
+        {
+            expect(TokenType::LBRACKET, "Expected '['");
+            while (current().type != TokenType::RBRACKET)
+            {
+                app_config.memo.insert(value(current()));
+                expect(TokenType::IDENTIFIER, "Expected component name");
+
+                if (current().type == TokenType::COMMA)
+                    advance();
+            }
+            expect(TokenType::RBRACKET, "Expected ']'");
+        }
+        else if (key == "coalesce")
+        {
+            if (current().type != TokenType::TRUE && current().type != TokenType::FALSE)
+            {
+                throw std::runtime_error("App coalesce must be true or false at line " + std::to_string(current().line));
+            }
+            app_config.coalesce = current().type == TokenType::TRUE;
+            advance();
+        }
+        else if (key == "event_budget")
+        {
+            app_config.event_budget = std::stoi(value(current()));
+            expect(TokenType::INT_LITERAL, "Expected milliseconds");
+        }
         else if (key == "routes")
         {
             expect(TokenType::LBRACE, "Expected '{'");
             while (current().type != TokenType::RBRACE)
             {
-                std::string route = current().value;
+                std::string route = value(current());
                 expect(TokenType::STRING_LITERAL, "Expected route string");
                 expect(TokenType::COLON, "Expected ':'");
-                std::string comp = current().value;
+                std::string comp = value(current());
                 expect(TokenType::IDENTIFIER, "Expected component name");
                 app_config.routes[route] = comp;
 
@@ -513,7 +566,7 @@ Component Parser::parse_component()
     component_array_types.clear();
 
     expect(TokenType::COMPONENT, "Expected 'component'");
-    comp.name = current().value;
+    comp.name = value(current());
     comp.line = current().line;
 
     // Check for collisions with built-in types (only for non-namespaced components)
@@ -558,7 +611,7 @@ Component Parser::parse_component()
                 // Function parameter: def onclick : void  OR  def onRemove(int) : void
                 advance();
                 param->is_callback = true;
-                param->name = current().value;
+                param->name = value(current());
                 if (is_identifier_token())
                 {
                     advance();
@@ -575,7 +628,7 @@ Component Parser::parse_component()
                     advance();
                     while (current().type != TokenType::RPAREN && current().type != TokenType::END_OF_FILE)
                     {
-                        std::string param_type = current().value;
+                        std::string param_type = value(current());
                         if (current().type == TokenType::INT || current().type == TokenType::STRING ||
                             current().type == TokenType::FLOAT || current().type == TokenType::FLOAT32 ||
                             current().type == TokenType::BOOL ||
@@ -618,7 +671,7 @@ Component Parser::parse_component()
 
                 expect(TokenType::COLON, "Expected ':'");
 
-                std::string retType = current().value;
+                std::string retType = value(current());
                 if (is_type_token())
                 {
                     advance();
@@ -640,7 +693,7 @@ Component Parser::parse_component()
             }
             else
             {
-                param->type = current().value;
+                param->type = value(current());
                 if (is_type_token())
                 {
                     advance();
@@ -664,7 +717,7 @@ Component Parser::parse_component()
                     param->type += parse_type_bracket_suffix();
                 }
 
-                param->name = current().value;
+                param->name = value(current());
                 if (is_identifier_token())
                 {
                     advance();
@@ -743,7 +796,7 @@ Component Parser::parse_component()
 
                 if (is_identifier_token() && peek().type == TokenType::LPAREN)
                 {
-                    parsed_name = current().value;
+                    parsed_name = value(current());
                     advance();
                 }
                 else
@@ -754,7 +807,7 @@ Component Parser::parse_component()
                 expect(TokenType::LPAREN, "Expected '(' in function type declaration");
                 while (current().type != TokenType::RPAREN && current().type != TokenType::END_OF_FILE)
                 {
-                    std::string param_type = current().value;
+                    std::string param_type = value(current());
                     if (current().type == TokenType::INT || current().type == TokenType::STRING ||
                         current().type == TokenType::FLOAT || current().type == TokenType::FLOAT32 ||
                         current().type == TokenType::BOOL || current().type == TokenType::IDENTIFIER ||
@@ -794,7 +847,7 @@ Component Parser::parse_component()
                 expect(TokenType::RPAREN, "Expected ')' after function type parameters");
                 expect(TokenType::COLON, "Expected ':' in function type declaration");
 
-                std::string ret_type = current().value;
+                std::string ret_type = value(current());
                 if (is_type_token())
                 {
                     advance();
@@ -816,14 +869,14 @@ Component Parser::parse_component()
             }
             else
             {
-                var_decl->type = current().value;
+                var_decl->type = value(current());
                 advance();
 
                 // Handle Module::Type syntax for namespaced types
                 if (current().type == TokenType::DOUBLE_COLON)
                 {
                     advance();
-                    var_decl->type += "::" + current().value;
+                    var_decl->type += "::" + value(current());
                     expect(TokenType::IDENTIFIER, "Expected type name after '::'");
                 }
 
@@ -859,7 +912,7 @@ Component Parser::parse_component()
                         }
                         else if (is_type_token() || current().type == TokenType::IDENTIFIER)
                         {
-                            var_decl->type += current().value;
+                            var_decl->type += value(current());
                             advance();
                         }
                         else
@@ -874,7 +927,7 @@ Component Parser::parse_component()
                 if (current().type == TokenType::DOT)
                 {
                     advance();
-                    var_decl->type += "." + current().value;
+                    var_decl->type += "." + value(current());
                     expect(TokenType::IDENTIFIER, "Expected enum name after '.'");
                 }
 
@@ -891,7 +944,7 @@ Component Parser::parse_component()
                     var_decl->type += parse_type_bracket_suffix();
                 }
 
-                var_decl->name = current().value;
+                var_decl->name = value(current());
                 if (is_identifier_token())
                 {
                     advance();
@@ -960,7 +1013,7 @@ Component Parser::parse_component()
             advance();
             FunctionDef func;
             func.is_public = is_public;
-            func.name = current().value;
+            func.name = value(current());
             int func_line = current().line;
             expect(TokenType::IDENTIFIER, "Expected function name");
 
@@ -969,6 +1022,10 @@ Component Parser::parse_component()
             {
                 ErrorHandler::compiler_error("Method name '" + func.name + "' must start with a lowercase letter", func_line);
             }
+            if (func.name == "pauseTick" || func.name == "resumeTick")
+            {
+                ErrorHandler::compiler_error("Method name '" + func.name + "' is built in: it pauses or resumes the component's tick block", func_line);
+            }
 
             // Parse generic type parameters: def first<T>(...) : T
             if (current().type == TokenType::LT)
@@ -976,7 +1033,7 @@ Component Parser::parse_component()
                 advance(); // skip '<'
                 while (current().type != TokenType::GT && current().type != TokenType::END_OF_FILE)
                 {
-                    std::string type_param = current().value;
+                    std::string type_param = value(current());
                     expect(TokenType::IDENTIFIER, "Expected type parameter name");
                     
                     // Type parameter names must start with uppercase
@@ -1027,7 +1084,7 @@ Component Parser::parse_component()
 
                     if (is_identifier_token() && peek().type == TokenType::LPAREN)
                     {
-                        paramName = current().value;
+                        paramName = value(current());
                         advance();
                     }
                     else
@@ -1038,7 +1095,7 @@ Component Parser::parse_component()
                     expect(TokenType::LPAREN, "Expected '(' in function parameter type");
                     while (current().type != TokenType::RPAREN && current().type != TokenType::END_OF_FILE)
                     {
-                        std::string callback_param_type = current().value;
+                        std::string callback_param_type = value(current());
                         if (current().type == TokenType::INT || current().type == TokenType::FLOAT ||
                             current().type == TokenType::FLOAT32 || current().type == TokenType::STRING ||
                             current().type == TokenType::BOOL || current().type == TokenType::IDENTIFIER ||
@@ -1077,7 +1134,7 @@ Component Parser::parse_component()
                     expect(TokenType::RPAREN, "Expected ')' in function parameter type");
                     expect(TokenType::COLON, "Expected ':' for function parameter return type");
 
-                    std::string retType = current().value;
+                    std::string retType = value(current());
                     if (is_type_token())
                     {
                         advance();
@@ -1098,7 +1155,7 @@ Component Parser::parse_component()
                 }
                 else
                 {
-                    paramType = current().value;
+                    paramType = value(current());
                     if (current().type == TokenType::INT || current().type == TokenType::FLOAT ||
                         current().type == TokenType::FLOAT32 ||
                         current().type == TokenType::STRING || current().type == TokenType::BOOL ||
@@ -1124,7 +1181,7 @@ Component Parser::parse_component()
                         advance();
                     }
 
-                    paramName = current().value;
+                    paramName = value(current());
                     if (is_identifier_token())
                     {
                         advance();
@@ -1157,7 +1214,7 @@ Component Parser::parse_component()
             expect(TokenType::COLON, "Expected ':' for return type");
 
             // Single return type
-            func.return_type = current().value;
+            func.return_type = value(current());
             advance();
             expect(TokenType::LBRACE, "Expected '{'");
 
@@ -1225,7 +1282,7 @@ Component Parser::parse_component()
                         advance();
                     }
 
-                    std::string paramType = current().value;
+                    std::string paramType = value(current());
                     if (current().type == TokenType::INT || current().type == TokenType::FLOAT ||
                         current().type == TokenType::FLOAT32 ||
                         current().type == TokenType::STRING || current().type == TokenType::BOOL ||
@@ -1251,7 +1308,7 @@ Component Parser::parse_component()
                         advance();
                     }
 
-                    std::string paramName = current().value;
+                    std::string paramName = value(current());
                     if (is_identifier_token())
                     {
                         advance();
@@ -1286,7 +1343,7 @@ Component Parser::parse_component()
         {
             advance();
             bool is_global = false;
-            if (current().type == TokenType::IDENTIFIER && current().value == "global")
+            if (current().type == TokenType::IDENTIFIER && text(current()) == "global")
             {
                 is_global = true;
                 advance();
@@ -1,24 +1,32 @@
 #include "parser.h"
+#include "../lexer.h"
 #include "defs/def_parser.h"
 #include "cli/error.h"
 #include <stdexcept>
 #include <limits>
 #include <cctype>
 
-Parser::Parser(const std::vector<Token> &toks) : tokens(toks) {}
+Parser::Parser(std::string_view src, std::vector<Token> toks) : source(src), tokens(std::move(toks)) {}
 
-Token Parser::current()
+const Token &Parser::current()
 {
     return pos < tokens.size() ? tokens[pos] : tokens.back();
 }
 
-Token Parser::peek(int offset)
+const Token &Parser::peek(int offset)
 {
     return (pos + offset) < tokens.size() ? tokens[pos + offset] : tokens.back();
 }
 
 void Parser::advance() { pos++; }
 
+std::string Parser::value(const Token &tok) const
+{
+    if (tok.type == TokenType::STRING_LITERAL || tok.type == TokenType::TEMPLATE_STRING)
+        return Lexer::literal_value(source, tok);
+    return std::string(text(tok));
+}
+
 bool Parser::match(TokenType type)
 {
     if (current().type == type)
@@ -74,7 +82,7 @@ std::string Parser::parse_type_bracket_suffix()
     if (current().type == TokenType::INT_LITERAL)
     {
         // Fixed-size array: Type[N]
-        std::string size = current().value;
+        std::string size = value(current());
         advance();
         expect(TokenType::RBRACKET, "Expected ']'");
         return "[" + size + "]";
@@ -88,7 +96,7 @@ std::string Parser::parse_type_bracket_suffix()
     else if (is_type_token())
     {
         // Map type: ValueType[KeyType]
-        std::string key_type = current().value;
+        std::string key_type = value(current());
         advance();
         expect(TokenType::RBRACKET, "Expected ']'");
         return "[" + key_type + "]";
@@ -129,8 +137,8 @@ std::vector<CallArg> Parser::parse_call_args(TokenType end_token)
         if (is_identifier_token() && peek().type == TokenType::COLON)
         {
             ErrorHandler::compiler_error(
-                "Named fields use '=', not ':' (write '" + current().value +
-                " = value', or '" + current().value + " := value' to move)",
+                "Named fields use '=', not ':' (write '" + value(current()) +
+                " = value', or '" + value(current()) + " := value' to move)",
                 current().line);
         }
 
@@ -146,7 +154,7 @@ std::vector<CallArg> Parser::parse_call_args(TokenType end_token)
 
         if (is_named)
         {
-            arg.name = current().value;
+            arg.name = value(current());
             advance();
 
             // Check for := (move) or = (copy/reference)
@@ -189,7 +197,7 @@ void Parser::parse_file()
         {
             ErrorHandler::compiler_error("Expected module name after 'module'", current().line);
         }
-        module_name = current().value;
+        module_name = value(current());
         // Module names must start with uppercase
         if (!module_name.empty() && !std::isupper(module_name[0]))
         {
@@ -222,7 +230,7 @@ void Parser::parse_file()
         {
             advance();
             expect(TokenType::STRING_LITERAL, "Expected import path");
-            imports.emplace_back(tokens[pos - 1].value, is_public);
+            imports.emplace_back(value(tokens[pos - 1]), is_public);
             expect(TokenType::SEMICOLON, "Expected ';'");
         }
         else if (current().type == TokenType::COMPONENT)
@@ -248,7 +256,7 @@ void Parser::parse_file()
             data_def->module_name = module_name;
             global_data.push_back(std::move(data_def));
         }
-        else if (current().type == TokenType::IDENTIFIER && current().value == "app")
+        else if (current().type == TokenType::IDENTIFIER && text(current()) == "app")
         {
             advance();
             parse_app();
@@ -1,28 +1,68 @@
 #include "parser.h"
 #include "cli/error.h"
+#include <array>
 #include <limits>
 #include <stdexcept>
 #include <cctype>
 
-std::unique_ptr<Expression> Parser::parse_expression()
+// Binding powers of the binary operators, lowest first. Operators of one level
+// are left-associative; the ternary is right-associative.
+enum BindingPower : uint8_t
+{
+    BP_NONE = 0,
+    BP_TERNARY,        // ? :
+    BP_OR,             // ||
+    BP_AND,            // &&
+    BP_BITWISE_OR,     // |
+    BP_BITWISE_XOR,    // ^
+    BP_BITWISE_AND,    // &
+    BP_EQUALITY,       // == !=
+    BP_COMPARISON,     // < > <= >=
+    BP_SHIFT,          // << >>
+    BP_ADDITIVE,       // + -
+    BP_MULTIPLICATIVE, // * / %
+};
+
+// Token type -> binding power as an infix operator (BP_NONE ends the expression)
+static constexpr auto infix_binding_power = []
+{
+    std::array<uint8_t, 256> bp{};
+    bp[(uint8_t)TokenType::QUESTION] = BP_TERNARY;
+    bp[(uint8_t)TokenType::OR] = BP_OR;
+    bp[(uint8_t)TokenType::AND] = BP_AND;
+    bp[(uint8_t)TokenType::PIPE] = BP_BITWISE_OR;
+    bp[(uint8_t)TokenType::CARET] = BP_BITWISE_XOR;
+    bp[(uint8_t)TokenType::AMPERSAND] = BP_BITWISE_AND;
+    bp[(uint8_t)TokenType::EQ] = BP_EQUALITY;
+    bp[(uint8_t)TokenType::NEQ] = BP_EQUALITY;
+    bp[(uint8_t)TokenType::LT] = BP_COMPARISON;
+    bp[(uint8_t)TokenType::GT] = BP_COMPARISON;
+    bp[(uint8_t)TokenType::LTE] = BP_COMPARISON;
+    bp[(uint8_t)TokenType::GTE] = BP_COMPARISON;
+    bp[(uint8_t)TokenType::LSHIFT] = BP_SHIFT;
+    bp[(uint8_t)TokenType::RSHIFT] = BP_SHIFT;
+    bp[(uint8_t)TokenType::PLUS] = BP_ADDITIVE;
+    bp[(uint8_t)TokenType::MINUS] = BP_ADDITIVE;
+    bp[(uint8_t)TokenType::STAR] = BP_MULTIPLICATIVE;
+    bp[(uint8_t)TokenType::SLASH] = BP_MULTIPLICATIVE;
+    bp[(uint8_t)TokenType::PERCENT] = BP_MULTIPLICATIVE;
+    return bp;
+}();
+
+// Deepest nesting of expressions (parentheses, ternary branches, call
+// arguments, ...) that is parsed; deeper input is an error instead of a stack
+// overflow
+static constexpr int max_expression_nesting = 10000;
+
+static bool is_prefix_operator(TokenType type)
 {
-    return parse_ternary();
+    return type == TokenType::MINUS || type == TokenType::PLUS || type == TokenType::NOT ||
+           type == TokenType::TILDE || type == TokenType::AMPERSAND || type == TokenType::COLON;
 }
 
-std::unique_ptr<Expression> Parser::parse_ternary()
+std::unique_ptr<Expression> Parser::parse_expression()
 {
-    auto expr = parse_or();
-
-    if (current().type == TokenType::QUESTION)
-    {
-        advance();                           // skip '?'
-        auto true_expr = parse_expression(); // Allow nested ternary
-        expect(TokenType::COLON, "Expected ':' in ternary expression");
-        auto false_expr = parse_ternary(); // Right-associative
-        expr = std::make_unique<TernaryOp>(std::move(expr), std::move(true_expr), std::move(false_expr));
-    }
-
-    return expr;
+    return parse_binary(BP_TERNARY);
 }
 
 std::unique_ptr<Expression> Parser::parse_expression_no_gt()
@@ -31,152 +71,79 @@ std::unique_ptr<Expression> Parser::parse_expression_no_gt()
     // Used for expressions inside view tags like <if condition>
     bool old_allow_gt = allow_gt_comparison;
     allow_gt_comparison = false;
-    auto expr = parse_or();
+    auto expr = parse_binary(BP_OR);
     allow_gt_comparison = old_allow_gt;
     return expr;
 }
 
-std::unique_ptr<Expression> Parser::parse_or()
+// Precedence climbing: parse an operand, then keep folding in operators that
+// bind at least as tightly as min_bp
+std::unique_ptr<Expression> Parser::parse_binary(int min_bp)
 {
-    auto left = parse_and();
-
-    while (current().type == TokenType::OR)
+    if (expression_depth > max_expression_nesting)
     {
-        std::string op = current().value;
-        advance();
-        auto right = parse_and();
-        left = std::make_unique<BinaryOp>(std::move(left), op, std::move(right));
+        ErrorHandler::compiler_error("Expression nested more than " + std::to_string(max_expression_nesting) + " levels deep", current().line);
     }
+    expression_depth++;
 
-    return left;
-}
-
-std::unique_ptr<Expression> Parser::parse_and()
-{
-    auto left = parse_bitwise_or();
-
-    while (current().type == TokenType::AND)
-    {
-        std::string op = current().value;
-        advance();
-        auto right = parse_bitwise_or();
-        left = std::make_unique<BinaryOp>(std::move(left), op, std::move(right));
-    }
-
-    return left;
-}
-
-std::unique_ptr<Expression> Parser::parse_bitwise_or()
-{
-    auto left = parse_bitwise_xor();
-
-    while (current().type == TokenType::PIPE)
-    {
-        std::string op = current().value;
-        advance();
-        auto right = parse_bitwise_xor();
-        left = std::make_unique<BinaryOp>(std::move(left), op, std::move(right));
-    }
-
-    return left;
-}
-
-std::unique_ptr<Expression> Parser::parse_bitwise_xor()
-{
-    auto left = parse_bitwise_and();
-
-    while (current().type == TokenType::CARET)
-    {
-        std::string op = current().value;
-        advance();
-        auto right = parse_bitwise_and();
-        left = std::make_unique<BinaryOp>(std::move(left), op, std::move(right));
-    }
-
-    return left;
-}
-
-std::unique_ptr<Expression> Parser::parse_bitwise_and()
-{
-    auto left = parse_equality();
+    auto left = parse_unary();
 
-    while (current().type == TokenType::AMPERSAND)
+    while (true)
     {
-        std::string op = current().value;
-        advance();
-        auto right = parse_equality();
-        left = std::make_unique<BinaryOp>(std::move(left), op, std::move(right));
-    }
-
-    return left;
-}
+        TokenType type = current().type;
+        int bp = infix_binding_power[(uint8_t)type];
+        if (type == TokenType::GT && !allow_gt_comparison)
+            bp = BP_NONE;
+        if (bp == BP_NONE || bp < min_bp)
+            break;
 
-std::unique_ptr<Expression> Parser::parse_equality()
-{
-    auto left = parse_comparison();
+        if (type == TokenType::QUESTION)
+        {
+            advance();                           // skip '?'
+            auto true_expr = parse_expression(); // Allow nested ternary
+            expect(TokenType::COLON, "Expected ':' in ternary expression");
+            auto false_expr = parse_binary(BP_TERNARY); // Right-associative
+            left = std::make_unique<TernaryOp>(std::move(left), std::move(true_expr), std::move(false_expr));
+            continue;
+        }
 
-    while (current().type == TokenType::EQ || current().type == TokenType::NEQ)
-    {
-        std::string op = current().value;
+        std::string op(text(current()));
         advance();
-        auto right = parse_comparison();
+        auto right = parse_binary(bp + 1);
         left = std::make_unique<BinaryOp>(std::move(left), op, std::move(right));
     }
 
+    expression_depth--;
     return left;
 }
 
-std::unique_ptr<Expression> Parser::parse_comparison()
+// Prefix operators, a primary expression, then postfix ++/--. Prefix operators
+// bind tighter than any binary operator and looser than postfix ones
+// (-x++ is -(x++)), and are applied innermost first without recursing.
+std::unique_ptr<Expression> Parser::parse_unary()
 {
-    auto left = parse_shift();
-
-    while (current().type == TokenType::LT ||
-           (current().type == TokenType::GT && allow_gt_comparison) ||
-           current().type == TokenType::LTE || current().type == TokenType::GTE)
-    {
-        std::string op = current().value;
+    size_t first_prefix = pos;
+    while (is_prefix_operator(current().type))
         advance();
-        auto right = parse_shift();
-        left = std::make_unique<BinaryOp>(std::move(left), op, std::move(right));
-    }
-
-    return left;
-}
+    size_t end_prefix = pos;
 
-std::unique_ptr<Expression> Parser::parse_shift()
-{
-    auto left = parse_additive();
-
-    while (current().type == TokenType::LSHIFT || current().type == TokenType::RSHIFT)
+    std::unique_ptr<Expression> expr;
+    if (match(TokenType::LPAREN))
     {
-        std::string op = current().value;
-        advance();
-        auto right = parse_additive();
-        left = std::make_unique<BinaryOp>(std::move(left), op, std::move(right));
+        // Parenthesized expression, parsed here rather than in parse_primary
+        // so each level of nesting costs only this frame and parse_binary's.
+        // Re-enable > comparison inside parentheses since it's unambiguous
+        bool old_allow_gt = allow_gt_comparison;
+        allow_gt_comparison = true;
+        expr = parse_expression();
+        allow_gt_comparison = old_allow_gt;
+        expect(TokenType::RPAREN, "Expected ')'");
     }
-
-    return left;
-}
-
-std::unique_ptr<Expression> Parser::parse_additive()
-{
-    auto left = parse_multiplicative();
-
-    while (current().type == TokenType::PLUS || current().type == TokenType::MINUS)
+    else
     {
-        std::string op = current().value;
-        advance();
-        auto right = parse_multiplicative();
-        left = std::make_unique<BinaryOp>(std::move(left), op, std::move(right));
+        expr = parse_primary();
     }
 
-    return left;
-}
-
-std::unique_ptr<Expression> Parser::parse_postfix()
-{
-    auto expr = parse_primary();
-
     while (true)
     {
         if (current().type == TokenType::PLUS_PLUS)
@@ -194,50 +161,27 @@ std::unique_ptr<Expression> Parser::parse_postfix()
             break;
         }
     }
-    return expr;
-}
 
-std::unique_ptr<Expression> Parser::parse_unary()
-{
-    // Unary operators: -, +, !, ~
-    if (current().type == TokenType::MINUS || current().type == TokenType::PLUS || 
-        current().type == TokenType::NOT || current().type == TokenType::TILDE)
+    for (size_t i = end_prefix; i-- > first_prefix;)
     {
-        std::string op = current().value;
-        advance();
-        auto operand = parse_unary();
-        return std::make_unique<UnaryOp>(op, std::move(operand));
-    }
-    // Reference expression: &expr (borrow, pass by reference)
-    if (current().type == TokenType::AMPERSAND)
-    {
-        advance();
-        auto operand = parse_unary();
-        return std::make_unique<ReferenceExpression>(std::move(operand));
-    }
-    // Move expression: :expr (transfer ownership)
-    if (current().type == TokenType::COLON)
-    {
-        advance();
-        auto operand = parse_unary();
-        return std::make_unique<MoveExpression>(std::move(operand));
-    }
-    return parse_postfix();
-}
-
-std::unique_ptr<Expression> Parser::parse_multiplicative()
-{
-    auto left = parse_unary();
-
-    while (current().type == TokenType::STAR || current().type == TokenType::SLASH || current().type == TokenType::PERCENT)
-    {
-        std::string op = current().value;
-        advance();
-        auto right = parse_unary();
-        left = std::make_unique<BinaryOp>(std::move(left), op, std::move(right));
+        const Token &op = tokens[i];
+        if (op.type == TokenType::AMPERSAND)
+        {
+            // Reference expression: &expr (borrow, pass by reference)
+            expr = std::make_unique<ReferenceExpression>(std::move(expr));
+        }
+        else if (op.type == TokenType::COLON)
+        {
+            // Move expression: :expr (transfer ownership)
+            expr = std::make_unique<MoveExpression>(std::move(expr));
+        }
+        else
+        {
+            // Unary operators: -, +, !, ~
+            expr = std::make_unique<UnaryOp>(std::string(text(op)), std::move(expr));
+        }
     }
-
-    return left;
+    return expr;
 }
 
 std::unique_ptr<Expression> Parser::parse_primary()
@@ -251,63 +195,63 @@ std::unique_ptr<Expression> Parser::parse_primary()
     // Integer literal
     if (current().type == TokenType::INT_LITERAL)
     {
-        int value;
+        int int_value;
         try
         {
             // Use base 0 to auto-detect decimal (10) or hexadecimal (0x)
-            long long ll_value = std::stoll(current().value, nullptr, 0);
+            long long ll_value = std::stoll(value(current()), nullptr, 0);
             if (ll_value > std::numeric_limits<int>::max() || ll_value < std::numeric_limits<int>::min())
             {
                 throw std::out_of_range("overflow");
             }
-            value = static_cast<int>(ll_value);
+            int_value = static_cast<int>(ll_value);
         }
         catch (const std::out_of_range &)
         {
-            ErrorHandler::compiler_error("Integer literal '" + current().value + "' is too large", current().line);
+            ErrorHandler::compiler_error("Integer literal '" + value(current()) + "' is too large", current().line);
         }
         catch (const std::invalid_argument &)
         {
-            ErrorHandler::compiler_error("Invalid integer literal '" + current().value + "'", current().line);
+            ErrorHandler::compiler_error("Invalid integer literal '" + value(current()) + "'", current().line);
         }
         advance();
-        return std::make_unique<IntLiteral>(value);
+        return std::make_unique<IntLiteral>(int_value);
     }
 
     // Float literal
     if (current().type == TokenType::FLOAT_LITERAL)
     {
-        double value;
+        double float_value;
         try
         {
-            value = std::stod(current().value);
+            float_value = std::stod(value(current()));
         }
         catch (const std::out_of_range &)
         {
-            ErrorHandler::compiler_error("Float literal '" + current().value + "' is too large", current().line);
+            ErrorHandler::compiler_error("Float literal '" + value(current()) + "' is too large", current().line);
         }
         catch (const std::invalid_argument &)
         {
-            ErrorHandler::compiler_error("Invalid float literal '" + current().value + "'", current().line);
+            ErrorHandler::compiler_error("Invalid float literal '" + value(current()) + "'", current().line);
         }
         advance();
-        return std::make_unique<FloatLiteral>(value);
+        return std::make_unique<FloatLiteral>(float_value);
     }
 
     // String literal
     if (current().type == TokenType::STRING_LITERAL)
     {
-        std::string value = current().value;
+        std::string str = value(current());
         advance();
-        return std::make_unique<StringLiteral>(value, false);
+        return std::make_unique<StringLiteral>(str, false);
     }
 
     // Template string (backticks)
     if (current().type == TokenType::TEMPLATE_STRING)
     {
-        std::string value = current().value;
+        std::string str = value(current());
         advance();
-        return std::make_unique<StringLiteral>(value, true);
+        return std::make_unique<StringLiteral>(str, true);
     }
 
     // Boolean literal
@@ -339,7 +283,7 @@ std::unique_ptr<Expression> Parser::parse_primary()
     // Identifer or function call (also allow 'key' and 'data' keywords as identifier)
     if (is_identifier_token())
     {
-        std::string name = current().value;
+        std::string name = value(current());
         int identifier_line = current().line;
         advance();
 
@@ -347,7 +291,7 @@ std::unique_ptr<Expression> Parser::parse_primary()
         if (current().type == TokenType::DOUBLE_COLON)
         {
             advance();
-            std::string value_name = current().value;
+            std::string value_name = value(current());
             expect(TokenType::IDENTIFIER, "Expected name after '::'");
             
             // Check if this is a namespaced constructor call: Module::Type(...)
@@ -417,14 +361,14 @@ std::unique_ptr<Expression> Parser::parse_primary()
             else if (current().type == TokenType::DOT)
             {
                 advance();
-                std::string member = current().value;
+                std::string member = value(current());
                 expect(TokenType::IDENTIFIER, "Expected member name");
 
                 // Check for Component.EnumName::Value syntax for shared enums
                 if (current().type == TokenType::DOUBLE_COLON)
                 {
                     advance();
-                    std::string value_name = current().value;
+                    std::string value_name = value(current());
                     expect(TokenType::IDENTIFIER, "Expected enum value name after '::'");
                     // name is the component name, member is the enum name
                     return std::make_unique<EnumAccess>(member, value_name, name);
@@ -503,19 +447,7 @@ std::unique_ptr<Expression> Parser::parse_primary()
         return arr;
     }
 
-    // Parenthesized expression
-    if (match(TokenType::LPAREN))
-    {
-        // Re-enable > comparison inside parentheses since it's unambiguous
-        bool old_allow_gt = allow_gt_comparison;
-        allow_gt_comparison = true;
-        auto expr = parse_expression();
-        allow_gt_comparison = old_allow_gt;
-        expect(TokenType::RPAREN, "Expected ')'");
-        return expr;
-    }
-
-    ErrorHandler::compiler_error("Unexpected token in expression: " + current().value + " (Type: " + std::to_string((int)current().type) + ")", current().line);
+    ErrorHandler::compiler_error("Unexpected token in expression: " + value(current()) + " (Type: " + std::to_string((int)current().type) + ")", current().line);
 }
 
 // Parse match expression: match (subject) { pattern => expr, pattern => { ... yield expr; ... }, ... }
@@ -567,24 +499,24 @@ std::unique_ptr<Expression> Parser::parse_match()
         else if (current().type == TokenType::IDENTIFIER && peek().type == TokenType::DOUBLE_COLON)
         {
             arm.pattern.kind = MatchPattern::Kind::Enum;
-            arm.pattern.type_name = current().value;
+            arm.pattern.type_name = value(current());
             advance(); // skip enum name
             advance(); // skip '::'
-            arm.pattern.enum_value = current().value;
+            arm.pattern.enum_value = value(current());
             expect(TokenType::IDENTIFIER, "Expected enum value after '::'");
         }
         // Check for variant pattern: Variant(Type name, ...)
         else if (current().type == TokenType::IDENTIFIER && peek().type == TokenType::LPAREN)
         {
             arm.pattern.kind = MatchPattern::Kind::Variant;
-            arm.pattern.type_name = current().value;  // constructor/variant name (e.g., Success/Error)
+            arm.pattern.type_name = value(current());  // constructor/variant name (e.g., Success/Error)
             advance(); // skip variant name
             advance(); // skip '('
 
             while (current().type != TokenType::RPAREN && current().type != TokenType::END_OF_FILE)
             {
                 MatchPattern::VariantBinding binding;
-                binding.type = current().value;
+                binding.type = value(current());
 
                 if (current().type == TokenType::INT || current().type == TokenType::STRING ||
                     current().type == TokenType::FLOAT || current().type == TokenType::FLOAT32 ||
@@ -600,7 +532,7 @@ std::unique_ptr<Expression> Parser::parse_match()
                 if (current().type == TokenType::DOUBLE_COLON)
                 {
                     advance();
-                    binding.type += "::" + current().value;
+                    binding.type += "::" + value(current());
                     expect(TokenType::IDENTIFIER, "Expected type name after '::' in variant pattern");
                 }
 
@@ -611,7 +543,7 @@ std::unique_ptr<Expression> Parser::parse_match()
                     binding.type += "[]";
                 }
 
-                binding.name = current().value;
+                binding.name = value(current());
                 expect(TokenType::IDENTIFIER, "Expected variable name in variant pattern");
 
                 arm.pattern.variant_bindings.push_back(std::move(binding));
@@ -634,14 +566,14 @@ std::unique_ptr<Expression> Parser::parse_match()
         else if (current().type == TokenType::IDENTIFIER && peek().type == TokenType::LBRACE)
         {
             arm.pattern.kind = MatchPattern::Kind::Pod;
-            arm.pattern.type_name = current().value;
+            arm.pattern.type_name = value(current());
             advance(); // skip type name
             advance(); // skip '{'
             
             while (current().type != TokenType::RBRACE && current().type != TokenType::END_OF_FILE)
             {
                 MatchPattern::FieldPattern field;
-                field.name = current().value;
+                field.name = value(current());
                 expect(TokenType::IDENTIFIER, "Expected field name in pod pattern");
                 
                 // Check if this is a value match (field = value) or just a binding (field)
@@ -687,7 +619,7 @@ std::unique_ptr<Expression> Parser::parse_match()
             {
                 // Match-arm explicit yield: yield <expr>;
                 // Parsed locally so we don't introduce a global keyword change.
-                if (current().type == TokenType::IDENTIFIER && current().value == "yield")
+                if (current().type == TokenType::IDENTIFIER && text(current()) == "yield")
                 {
                     int yield_line = current().line;
                     advance(); // skip 'yield'
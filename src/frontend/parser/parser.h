@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 #include <map>
+#include <string_view>
 
 // Represents an import declaration
 struct ImportDecl {
@@ -17,10 +18,12 @@ struct ImportDecl {
 
 class Parser{
     private:
+        std::string_view source;  // Text the token spans point into; owned by the caller
         std::vector<Token> tokens;
         size_t pos = 0;
         bool allow_gt_comparison = true;  // When false, > is not treated as comparison op
         bool allow_brace_init = true;     // When false, Name{ is not treated as data literal
+        int expression_depth = 0;         // Nesting of parse_binary calls, bounded to protect the stack
         
         // Maps member variable names to their component types (for detecting <memberName/> in views)
         std::map<std::string, std::string> component_member_types;
@@ -28,12 +31,18 @@ class Parser{
         // Maps member variable names to their component array element types (e.g., "rows" -> "Row" for Row[] rows)
         std::map<std::string, std::string> component_array_types;
 
-        Token current();
-        Token peek(int offset = 1);
+        const Token& current();
+        const Token& peek(int offset = 1);
         void advance();
         bool match(TokenType type);
         void expect(TokenType type, const std::string& msg);
         
+        // Token text: the raw span, or the decoded literal for strings
+        std::string_view text(const Token& tok) const { return source.substr(tok.offset, tok.length); }
+        std::string value(const Token& tok) const;
+        // True if b starts right where a ends, with no whitespace or comment between
+        bool adjacent(const Token& a, const Token& b) const { return a.offset + a.length == b.offset; }
+
         // Helper methods
         bool is_type_token();                    // INT, STRING, FLOAT, FLOAT32, BOOL, IDENTIFIER, VOID
         bool is_identifier_token();              // IDENTIFIER, KEY, DATA (keywords usable as names)
@@ -53,19 +62,8 @@ class Parser{
 
         std::unique_ptr<Expression> parse_expression();
         std::unique_ptr<Expression> parse_expression_no_gt();  // Parse expression without > as comparison
-        std::unique_ptr<Expression> parse_ternary();
-        std::unique_ptr<Expression> parse_or();
-        std::unique_ptr<Expression> parse_and();
-        std::unique_ptr<Expression> parse_bitwise_or();
-        std::unique_ptr<Expression> parse_bitwise_xor();
-        std::unique_ptr<Expression> parse_bitwise_and();
-        std::unique_ptr<Expression> parse_equality();
-        std::unique_ptr<Expression> parse_comparison();
-        std::unique_ptr<Expression> parse_shift();
-        std::unique_ptr<Expression> parse_additive();
-        std::unique_ptr<Expression> parse_postfix();
-        std::unique_ptr<Expression> parse_unary();
-        std::unique_ptr<Expression> parse_multiplicative();
+        std::unique_ptr<Expression> parse_binary(int min_bp);  // Operators binding at least as tightly as min_bp
+        std::unique_ptr<Expression> parse_unary();  // Prefix operators, primary, postfix ++/--
         std::unique_ptr<Expression> parse_primary();
         std::unique_ptr<Expression> parse_match();  // Parse match expression
         std::unique_ptr<Expression> parse_prop_or_attr_value();
@@ -90,6 +88,6 @@ class Parser{
         std::vector<std::unique_ptr<EnumDef>> global_enums;  // Enums declared outside components
         std::vector<ImportDecl> imports;  // Import declarations (path + pub status)
         AppConfig app_config;
-        Parser(const std::vector<Token>& toks);
+        Parser(std::string_view src, std::vector<Token> toks);
         void parse_file();
 };
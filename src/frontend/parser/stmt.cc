@@ -17,6 +17,23 @@ std::unique_ptr<Statement> Parser::parse_statement()
         return block;
     }
 
+    // batch { ... } / sync { ... } (contextual: an identifier followed by a block)
+    if (current().type == TokenType::IDENTIFIER && (text(current()) == "batch" || text(current()) == "sync") &&
+        peek().type == TokenType::LBRACE)
+    {
+        auto batch = std::make_unique<BatchStatement>();
+        batch->is_sync = text(current()) == "sync";
+        batch->line = current().line;
+        advance();
+        advance();
+        while (current().type != TokenType::RBRACE && current().type != TokenType::END_OF_FILE)
+        {
+            batch->statements.push_back(parse_statement());
+        }
+        expect(TokenType::RBRACE, "Expected '}'");
+        return batch;
+    }
+
     // If
     if (current().type == TokenType::IF)
     {
@@ -44,7 +61,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
         // Check for range-based or foreach syntax: for i in start:end { } OR for e in array { }
         if (current().type == TokenType::IDENTIFIER && peek().type == TokenType::IN)
         {
-            std::string var_name = current().value;
+            std::string var_name = value(current());
             advance(); // skip identifier
             advance(); // skip 'in'
 
@@ -102,7 +119,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
         {
             throw std::runtime_error("Expected signal name after 'emit'");
         }
-        emit_stmt->signal_name = current().value;
+        emit_stmt->signal_name = value(current());
         advance();
 
         expect(TokenType::LPAREN, "Expected '(' after signal name in emit statement");
@@ -220,7 +237,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
 
             if (is_identifier_token() && peek().type == TokenType::LPAREN)
             {
-                name = current().value;
+                name = value(current());
                 advance();
             }
             else
@@ -231,7 +248,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
             expect(TokenType::LPAREN, "Expected '(' in function type declaration");
             while (current().type != TokenType::RPAREN && current().type != TokenType::END_OF_FILE)
             {
-                std::string param_type = current().value;
+                std::string param_type = value(current());
                 if (current().type == TokenType::INT || current().type == TokenType::STRING ||
                     current().type == TokenType::FLOAT || current().type == TokenType::FLOAT32 ||
                     current().type == TokenType::BOOL || current().type == TokenType::IDENTIFIER ||
@@ -271,7 +288,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
             expect(TokenType::RPAREN, "Expected ')' after function type parameters");
             expect(TokenType::COLON, "Expected ':' in function type declaration");
 
-            std::string ret_type = current().value;
+            std::string ret_type = value(current());
             if (is_type_token())
             {
                 advance();
@@ -292,14 +309,14 @@ std::unique_ptr<Statement> Parser::parse_statement()
         }
         else
         {
-            type = current().value;
+            type = value(current());
             advance();
 
             // Handle Module::Type syntax for namespaced types
             if (current().type == TokenType::DOUBLE_COLON)
             {
                 advance();
-                type += "::" + current().value;
+                type += "::" + value(current());
                 expect(TokenType::IDENTIFIER, "Expected type name after '::'");
             }
 
@@ -336,7 +353,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
                     }
                     else if (is_type_token() || current().type == TokenType::IDENTIFIER)
                     {
-                        type += current().value;
+                        type += value(current());
                         advance();
                     }
                     else
@@ -361,7 +378,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
                 type += parse_type_bracket_suffix();
             }
 
-            name = current().value;
+            name = value(current());
             if (is_identifier_token())
             {
                 advance();
@@ -403,7 +420,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
     {
         // Could be an index assignment or an expression statement with index access
         // Need to look ahead to see if there's an assignment operator after the bracket
-        std::string name = current().value;
+        std::string name = value(current());
         size_t saved_pos = pos;
         advance(); // skip identifier
         advance(); // skip '['
@@ -522,7 +539,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
 
             // Now parse the member chain
             expect(TokenType::DOT, "Expected '.'");
-            std::string last_member = current().value;
+            std::string last_member = value(current());
             expect(TokenType::IDENTIFIER, "Expected member name");
 
             // Handle chained member access (arr[i].a.b = value)
@@ -530,7 +547,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
             {
                 advance(); // skip '.'
                 obj_expr = std::make_unique<MemberAccess>(std::move(obj_expr), last_member);
-                last_member = current().value;
+                last_member = value(current());
                 expect(TokenType::IDENTIFIER, "Expected member name");
             }
 
@@ -624,11 +641,11 @@ std::unique_ptr<Statement> Parser::parse_statement()
         if (is_member_assign && has_index)
         {
             // obj.member[index] = value - build MemberAccess then index into it
-            std::unique_ptr<Expression> obj_expr = std::make_unique<Identifier>(current().value);
+            std::unique_ptr<Expression> obj_expr = std::make_unique<Identifier>(value(current()));
             advance(); // skip first identifier
             advance(); // skip first '.'
 
-            std::string member = current().value;
+            std::string member = value(current());
             expect(TokenType::IDENTIFIER, "Expected member name");
 
             // Handle chained member access
@@ -636,7 +653,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
             {
                 advance(); // skip '.'
                 obj_expr = std::make_unique<MemberAccess>(std::move(obj_expr), member);
-                member = current().value;
+                member = value(current());
                 expect(TokenType::IDENTIFIER, "Expected member name");
             }
 
@@ -685,11 +702,11 @@ std::unique_ptr<Statement> Parser::parse_statement()
         if (is_member_assign)
         {
             // Parse the object part (all but the last member)
-            std::unique_ptr<Expression> obj_expr = std::make_unique<Identifier>(current().value);
+            std::unique_ptr<Expression> obj_expr = std::make_unique<Identifier>(value(current()));
             advance(); // skip first identifier
             advance(); // skip first '.'
 
-            std::string last_member = current().value;
+            std::string last_member = value(current());
             expect(TokenType::IDENTIFIER, "Expected member name");
 
             // Handle chained member access (a.b.c = value means object is a.b, member is c)
@@ -698,7 +715,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
                 advance(); // skip '.'
                 // Previous member becomes part of the object
                 obj_expr = std::make_unique<MemberAccess>(std::move(obj_expr), last_member);
-                last_member = current().value;
+                last_member = value(current());
                 expect(TokenType::IDENTIFIER, "Expected member name");
             }
 
@@ -753,7 +770,7 @@ std::unique_ptr<Statement> Parser::parse_statement()
          peek().type == TokenType::RSHIFT_ASSIGN))
     {
 
-        std::string name = current().value;
+        std::string name = value(current());
         advance();
 
         TokenType opType = current().type;
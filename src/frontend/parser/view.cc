@@ -11,21 +11,21 @@ std::unique_ptr<Expression> Parser::parse_prop_or_attr_value()
 
     if (current().type == TokenType::STRING_LITERAL)
     {
-        auto val = std::make_unique<StringLiteral>(current().value);
+        auto val = std::make_unique<StringLiteral>(value(current()));
         advance();
         return val;
     }
 
     if (current().type == TokenType::INT_LITERAL)
     {
-        auto val = std::make_unique<IntLiteral>(std::stoi(current().value));
+        auto val = std::make_unique<IntLiteral>(std::stoi(value(current())));
         advance();
         return val;
     }
 
     if (current().type == TokenType::FLOAT_LITERAL)
     {
-        auto val = std::make_unique<FloatLiteral>(std::stod(current().value));
+        auto val = std::make_unique<FloatLiteral>(std::stod(value(current())));
         advance();
         return val;
     }
@@ -34,13 +34,13 @@ std::unique_ptr<Expression> Parser::parse_prop_or_attr_value()
     {
         if (current().type == TokenType::INT_LITERAL)
         {
-            auto val = std::make_unique<IntLiteral>(-std::stoi(current().value));
+            auto val = std::make_unique<IntLiteral>(-std::stoi(value(current())));
             advance();
             return val;
         }
         else if (current().type == TokenType::FLOAT_LITERAL)
         {
-            auto val = std::make_unique<FloatLiteral>(-std::stod(current().value));
+            auto val = std::make_unique<FloatLiteral>(-std::stod(value(current())));
             advance();
             return val;
         }
@@ -80,26 +80,20 @@ std::string Parser::parse_style_block()
 
         Token tok = current();
 
-        int prev_len = prev.value.length();
-        if (prev.type == TokenType::STRING_LITERAL)
-            prev_len += 2;
-
-        if (tok.line > prev.line)
-        {
-            css += " ";
-        }
-        else if (tok.column > prev.column + prev_len)
+        // Tokens that were separated in the source stay separated in the CSS
+        if (tok.offset > prev.offset + prev.length)
         {
             css += " ";
         }
 
+        // String spans keep their quotes and escapes as written
         if (tok.type == TokenType::STRING_LITERAL)
         {
-            css += "\"" + tok.value + "\"";
+            css += text(tok);
         }
         else
         {
-            css += tok.value;
+            css += value(tok);
         }
 
         prev = tok;
@@ -127,7 +121,7 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
                 is_move_prop = true;
             }
 
-            std::string prop_name = current().value;
+            std::string prop_name = value(current());
             expect(TokenType::IDENTIFIER, "Expected prop name");
 
             std::unique_ptr<Expression> prop_value;
@@ -204,7 +198,7 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
         return comp;
     }
 
-    std::string tag = current().value;
+    std::string tag = value(current());
     expect(TokenType::IDENTIFIER, "Expected tag name");
     // Special tag: <raw> - raw HTML injection
     if (tag == "raw")
@@ -242,13 +236,10 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
                 {
                     if (!first)
                     {
-                        int prev_len = prev_token.value.length();
-                        if (prev_token.type == TokenType::STRING_LITERAL)
-                            prev_len += 2;
-                        if (prev_token.line != current().line || prev_token.column + prev_len != current().column)
+                        if (!adjacent(prev_token, current()))
                             text += " ";
                     }
-                    text += current().value;
+                    text += value(current());
                     prev_token = current();
                     advance();
                     first = false;
@@ -263,9 +254,9 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
         // </raw>
         expect(TokenType::LT, "Expected '<'");
         expect(TokenType::SLASH, "Expected '/'");
-        if (current().value != "raw")
+        if (text(current()) != "raw")
         {
-            throw std::runtime_error("Mismatched closing tag: expected raw, got " + current().value);
+            throw std::runtime_error("Mismatched closing tag: expected raw, got " + value(current()));
         }
         expect(TokenType::IDENTIFIER, "Expected 'raw'");
         expect(TokenType::GT, "Expected '>'");
@@ -300,7 +291,7 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
         {
             ErrorHandler::compiler_error("Expected component name after '" + module_prefix + "::'", current().line);
         }
-        tag = current().value;
+        tag = value(current());
         advance();
     }
 
@@ -357,13 +348,13 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
             {
                 throw std::runtime_error("Expected variable name in element binding &={varName}");
             }
-            el->ref_binding = current().value;
+            el->ref_binding = value(current());
             advance();
             expect(TokenType::RBRACE, "Expected '}' after variable name");
             continue;
         }
 
-        std::string attrName = current().value;
+        std::string attrName = value(current());
         advance();
 
         // Handle hyphenated attribute names (e.g., fill-opacity, stroke-width, data-id)
@@ -371,7 +362,7 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
         {
             attrName += "-";
             advance(); // consume '-'
-            attrName += current().value;
+            attrName += value(current());
             advance(); // consume identifier part
         }
 
@@ -441,10 +432,7 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
             Token prev_token = current();
             
             // Check for leading whitespace (gap between last non-text token and first text token)
-            int last_len = last_non_text_token.value.length();
-            if (last_non_text_token.type == TokenType::STRING_LITERAL)
-                last_len += 2;
-            if (last_non_text_token.line != current().line || last_non_text_token.column + last_len != current().column)
+            if (!adjacent(last_non_text_token, current()))
             {
                 text += " ";
             }
@@ -454,19 +442,15 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
             {
                 if (!first)
                 {
-                    int prev_len = prev_token.value.length();
-                    if (prev_token.type == TokenType::STRING_LITERAL)
-                        prev_len += 2;
-
-                    if (prev_token.line != current().line || prev_token.column + prev_len != current().column)
+                    if (!adjacent(prev_token, current()))
                     {
                         text += " ";
                     }
                 }
                 if (current().type == TokenType::STRING_LITERAL)
-                    text += current().value;
+                    text += value(current());
                 else
-                    text += current().value;
+                    text += value(current());
 
                 prev_token = current();
                 advance();
@@ -478,11 +462,7 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
                 // If so, preserve the trailing space
                 if (current().type != TokenType::END_OF_FILE)
                 {
-                    int prev_len = prev_token.value.length();
-                    if (prev_token.type == TokenType::STRING_LITERAL)
-                        prev_len += 2;
-
-                    if (prev_token.line != current().line || prev_token.column + prev_len != current().column)
+                    if (!adjacent(prev_token, current()))
                     {
                         text += " ";
                     }
@@ -497,9 +477,9 @@ std::unique_ptr<ASTNode> Parser::parse_html_element()
 
     expect(TokenType::LT, "Expected '<'");
     expect(TokenType::SLASH, "Expected '/'");
-    if (current().value != tag)
+    if (text(current()) != tag)
     {
-        throw std::runtime_error("Mismatched closing tag: expected " + tag + ", got " + current().value);
+        throw std::runtime_error("Mismatched closing tag: expected " + tag + ", got " + value(current()));
     }
     expect(TokenType::IDENTIFIER, "Expected tag name");
     expect(TokenType::GT, "Expected '>'");
@@ -532,6 +512,7 @@ std::unique_ptr<ViewIfStatement> Parser::parse_view_if()
 {
     // Syntax: <if condition> ... <else> ... </else> </if>
     //     or: <if condition> ... </if>
+    //     or: <if condition keep> ... </if>  (hidden branch is parked, not destroyed)
     auto viewIf = std::make_unique<ViewIfStatement>();
     viewIf->line = current().line;
 
@@ -541,6 +522,11 @@ std::unique_ptr<ViewIfStatement> Parser::parse_view_if()
     // Parse condition (everything until '>')
     // Use parse_expression_no_gt so > is not treated as comparison
     viewIf->condition = parse_expression_no_gt();
+    if (current().type == TokenType::IDENTIFIER && text(current()) == "keep")
+    {
+        viewIf->keep = true;
+        advance();
+    }
     expect(TokenType::GT, "Expected '>'");
 
     // Helper lambdas for termination checks
@@ -586,10 +572,7 @@ std::unique_ptr<ViewIfStatement> Parser::parse_view_if()
             Token prev_token = current();
             
             // Check for leading whitespace
-            int last_len = last_non_text_token.value.length();
-            if (last_non_text_token.type == TokenType::STRING_LITERAL) last_len += 2;
-            if (last_non_text_token.line != current().line || 
-                last_non_text_token.column + last_len != current().column) {
+            if (!adjacent(last_non_text_token, current())) {
                 text += " ";
             }
             
@@ -597,14 +580,11 @@ std::unique_ptr<ViewIfStatement> Parser::parse_view_if()
                    current().type != TokenType::END_OF_FILE)
             {
                 if (!first) {
-                    int prev_len = prev_token.value.length();
-                    if (prev_token.type == TokenType::STRING_LITERAL) prev_len += 2;
-                    if (prev_token.line != current().line || 
-                        prev_token.column + prev_len != current().column) {
+                    if (!adjacent(prev_token, current())) {
                         text += " ";
                     }
                 }
-                text += current().value;
+                text += value(current());
                 prev_token = current();
                 advance();
                 first = false;
@@ -613,10 +593,7 @@ std::unique_ptr<ViewIfStatement> Parser::parse_view_if()
             if (!text.empty()) {
                 // Check for trailing whitespace
                 if (current().type != TokenType::END_OF_FILE) {
-                    int prev_len = prev_token.value.length();
-                    if (prev_token.type == TokenType::STRING_LITERAL) prev_len += 2;
-                    if (prev_token.line != current().line || 
-                        prev_token.column + prev_len != current().column) {
+                    if (!adjacent(prev_token, current())) {
                         text += " ";
                     }
                 }
@@ -659,10 +636,7 @@ std::unique_ptr<ViewIfStatement> Parser::parse_view_if()
                 bool first = true;
                 Token prev_token = current();
                 
-                int last_len = last_non_text_token.value.length();
-                if (last_non_text_token.type == TokenType::STRING_LITERAL) last_len += 2;
-                if (last_non_text_token.line != current().line || 
-                    last_non_text_token.column + last_len != current().column) {
+                if (!adjacent(last_non_text_token, current())) {
                     text += " ";
                 }
                 
@@ -670,14 +644,11 @@ std::unique_ptr<ViewIfStatement> Parser::parse_view_if()
                        current().type != TokenType::END_OF_FILE)
                 {
                     if (!first) {
-                        int prev_len = prev_token.value.length();
-                        if (prev_token.type == TokenType::STRING_LITERAL) prev_len += 2;
-                        if (prev_token.line != current().line || 
-                            prev_token.column + prev_len != current().column) {
+                        if (!adjacent(prev_token, current())) {
                             text += " ";
                         }
                     }
-                    text += current().value;
+                    text += value(current());
                     prev_token = current();
                     advance();
                     first = false;
@@ -685,10 +656,7 @@ std::unique_ptr<ViewIfStatement> Parser::parse_view_if()
                 
                 if (!text.empty()) {
                     if (current().type != TokenType::END_OF_FILE) {
-                        int prev_len = prev_token.value.length();
-                        if (prev_token.type == TokenType::STRING_LITERAL) prev_len += 2;
-                        if (prev_token.line != current().line || 
-                            prev_token.column + prev_len != current().column) {
+                        if (!adjacent(prev_token, current())) {
                             text += " ";
                         }
                     }
@@ -723,7 +691,7 @@ std::unique_ptr<ASTNode> Parser::parse_view_for()
     expect(TokenType::LT, "Expected '<'");
     expect(TokenType::FOR, "Expected 'for'");
 
-    std::string var_name = current().value;
+    std::string var_name = value(current());
     expect(TokenType::IDENTIFIER, "Expected loop variable name");
     expect(TokenType::IN, "Expected 'in'");
 
@@ -781,6 +749,18 @@ std::unique_ptr<ASTNode> Parser::parse_view_for()
         viewForEach->key_expr = parse_expression();
         expect(TokenType::RBRACE, "Expected '}' after key expression");
 
+        // Optional window: <for row in rows key={row.id} window={first:first + 50}>
+        if (current().type == TokenType::IDENTIFIER && text(current()) == "window")
+        {
+            advance();
+            expect(TokenType::ASSIGN, "Expected '=' after 'window'");
+            expect(TokenType::LBRACE, "Expected '{' for window range");
+            viewForEach->window_start = parse_expression();
+            expect(TokenType::COLON, "Expected ':' in window range. Use: window={start:end}");
+            viewForEach->window_end = parse_expression();
+            expect(TokenType::RBRACE, "Expected '}' after window range");
+        }
+
         expect(TokenType::GT, "Expected '>'");
 
         // If iterating over a component array, temporarily add loop var to component_member_types
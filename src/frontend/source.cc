@@ -0,0 +1,37 @@
+#include "source.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+SourceManager::~SourceManager(){
+    for(const auto& m : mappings) munmap(m.data, m.size);
+}
+
+bool SourceManager::load(const std::string& path, std::string_view& text){
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0) return false;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)){
+        close(fd);
+        return false;
+    }
+
+    // An empty file can't be mapped
+    size_t size = static_cast<size_t>(st.st_size);
+    if(size == 0){
+        close(fd);
+        text = std::string_view();
+        return true;
+    }
+
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED) return false;
+
+    std::lock_guard<std::mutex> guard(mappings_lock);
+    mappings.push_back({data, size});
+    text = std::string_view(static_cast<const char*>(data), size);
+    return true;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Source files of one compilation. Each file is memory-mapped read-only and
+// stays mapped until the manager is destroyed, so tokens can refer to its
+// text by offset instead of holding copies.
+class SourceManager {
+    public:
+        SourceManager() = default;
+        SourceManager(const SourceManager&) = delete;
+        SourceManager& operator=(const SourceManager&) = delete;
+        ~SourceManager();
+
+        // Map the file at path and set text to its contents; false if it
+        // can't be opened. Safe to call from several threads at once
+        bool load(const std::string& path, std::string_view& text);
+
+    private:
+        struct Mapping {
+            void* data;
+            size_t size;
+        };
+        std::mutex mappings_lock;
+        std::vector<Mapping> mappings;
+};
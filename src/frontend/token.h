@@ -1,8 +1,8 @@
 #pragma once
 
-#include <string>
+#include <cstdint>
 
-enum class TokenType {
+enum class TokenType : uint8_t {
     // Keywords
     COMPONENT, DEF, RETURN, POD, VIEW, IF, ELSE, FOR, TICK, INIT, MOUNT, STYLE, MUT, IMPORT, SHARED, IN, PUB, KEY, ENUM, ROUTER, MODULE, MATCH,
     SIGNAL, LISTEN, EMIT,
@@ -27,9 +27,12 @@ enum class TokenType {
     END_OF_FILE, UNKNOWN
 };
 
+// A token is a span of the source it was read from. String and template
+// literal spans include their quotes; the parser decodes escapes only when it
+// asks for the literal's value.
 struct Token {
     TokenType type;
-    std::string value;
+    uint32_t offset;
+    uint32_t length;
     int line;
-    int column;
 };
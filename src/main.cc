@@ -1,5 +1,6 @@
-#include "frontend/lexer.h"
-#include "frontend/parser/parser.h"
+#include "frontend/source.h"
+#include "frontend/loader.h"
+#include "frontend/parse_cache.h"
 #include "ast/ast.h"
 #include "defs/def_parser.h"
 #include "analysis/type_checker.h"
@@ -18,7 +19,9 @@
 #include <queue>
 #include <algorithm>
 #include <filesystem>
+#include <optional>
 #include <cstdlib>
+#include <thread>
 
 namespace fs = std::filesystem;
 
@@ -185,6 +188,8 @@ int main(int argc, char **argv)
 
     std::string input_file;
     std::string output_dir;
+    int jobs = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    bool use_parse_cache = true;
 
     for (int i = 1; i < argc; ++i)
     {
@@ -193,6 +198,8 @@ int main(int argc, char **argv)
             cc_only = true;
         else if (arg == "--keep-cc")
             keep_cc = true;
+        else if (arg == "--no-cache")
+            use_parse_cache = false;
         else if (arg == "--out" || arg == "-o")
         {
             if (i + 1 < argc)
@@ -205,6 +212,17 @@ int main(int argc, char **argv)
                 return 1;
             }
         }
+        else if (arg == "-j" || (arg.size() > 2 && arg.compare(0, 2, "-j") == 0))
+        {
+            // -j N or -jN: threads used to load and parse source files
+            std::string count = arg.size() > 2 ? arg.substr(2) : (i + 1 < argc ? argv[++i] : "");
+            jobs = count.find_first_not_of("0123456789") == std::string::npos && !count.empty() ? std::atoi(count.c_str()) : 0;
+            if (jobs < 1)
+            {
+                ErrorHandler::cli_error("-j requires a positive number of jobs");
+                return 1;
+            }
+        }
         else if (input_file.empty())
             input_file = arg;
         else
@@ -241,6 +259,12 @@ int main(int argc, char **argv)
         project_root = fs::current_path();
     }
 
+    // Every AST node of the compilation is allocated here and released at
+    // once at exit; declared first so it outlives everything holding nodes
+    AstArena ast_arena;
+    AstArena::Scope ast_arena_scope(ast_arena);
+    std::deque<AstArena> worker_arenas;  // Used by the extra threads of load_files
+
     std::vector<Component> all_components;
     std::vector<std::unique_ptr<DataDef>> all_global_data;
     std::vector<std::unique_ptr<EnumDef>> all_global_enums;
@@ -262,8 +286,21 @@ int main(int argc, char **argv)
         return 1;
     }
 
+    // Source files stay mapped until compilation ends
+    SourceManager sources;
+
+    // Parse results of earlier compilations, keyed by source content
+    std::optional<ParseCache> parse_cache;
+    if (use_parse_cache)
+        parse_cache.emplace(project_root / ".coi" / "cache" / "parse", compiler_build_id());
+
     try
     {
+        // Load every reachable file in parallel, then merge them breadth-first
+        // in import order, so components, messages and the first error reported
+        // are the same for any number of jobs
+        std::map<std::string, LoadedFile> loaded = load_files(file_queue.front(), project_root, jobs, sources, worker_arenas, parse_cache ? &*parse_cache : nullptr);
+
         while (!file_queue.empty())
         {
             std::string current_file_path = file_queue.front();
@@ -275,24 +312,17 @@ int main(int argc, char **argv)
 
             std::cerr << "Processing " << current_file_path << "..." << std::endl;
 
-            std::ifstream file(current_file_path);
-            if (!file)
+            LoadedFile &file = loaded.at(current_file_path);
+            if (!file.opened)
             {
                 std::cerr << colors::RED << "Error:" << colors::RESET << " Could not open file " << current_file_path << std::endl;
                 return 1;
             }
-            std::string source((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-
-            // Lexical analysis
-            Lexer lexer(source);
-            auto tokens = lexer.tokenize();
-
-            // Parsing
-            Parser parser(tokens);
-            parser.parse_file();
+            if (file.error)
+                std::rethrow_exception(file.error);
 
             // Add components with duplicate name check (allow same name in different modules)
-            for (auto &comp : parser.components)
+            for (auto &comp : file.components)
             {
                 bool duplicate = false;
                 for (const auto &existing : all_components)
@@ -308,85 +338,42 @@ int main(int argc, char **argv)
             }
 
             // Collect global enums
-            for (auto &enum_def : parser.global_enums)
+            for (auto &enum_def : file.global_enums)
             {
                 enum_def->source_file = current_file_path;
                 all_global_enums.push_back(std::move(enum_def));
             }
 
             // Collect global data types
-            for (auto &data_def : parser.global_data)
+            for (auto &data_def : file.global_data)
             {
                 data_def->source_file = current_file_path;
                 all_global_data.push_back(std::move(data_def));
             }
 
-            if (!parser.app_config.root_component.empty())
+            if (!file.app_config.root_component.empty())
             {
-                final_app_config = parser.app_config;
+                final_app_config = file.app_config;
             }
 
-            fs::path current_path(current_file_path);
-            fs::path parent_path = current_path.parent_path();
-
             // Track direct imports and pub imports for this file
             std::set<std::string> direct_imports;
             std::set<std::string> current_pub_imports;
-            for (const auto &import_decl : parser.imports)
+            for (const auto &import : file.imports)
             {
-                fs::path import_path;
-                const std::string &import_str = import_decl.path;
-                
-                if (!import_str.empty() && import_str[0] == '@')
+                if (!import.error.empty())
                 {
-                    // Package import:
-                    //   @scope/pkg-name -> .coi/pkgs/scope/pkg-name/Mod.coi
-                    //   @scope/pkg-name/path -> .coi/pkgs/scope/pkg-name/path.coi
-                    std::string pkg_path = import_str.substr(1);
-
-                    size_t slash_count = static_cast<size_t>(std::count(pkg_path.begin(), pkg_path.end(), '/'));
-                    if (slash_count == 0)
-                    {
-                        std::cerr << colors::RED << "Error:" << colors::RESET
-                                  << " package import must use scoped format @scope/name: " << import_str << std::endl;
-                        return 1;
-                    }
-                    
-                    // @scope/pkg-name -> @scope/pkg-name/Mod.coi
-                    if (slash_count == 1 && (pkg_path.size() < 4 || pkg_path.substr(pkg_path.size() - 4) != ".coi"))
-                    {
-                        pkg_path += "/Mod.coi";
-                    }
-                    else if (pkg_path.size() < 4 || pkg_path.substr(pkg_path.size() - 4) != ".coi")
-                    {
-                        pkg_path += ".coi";
-                    }
-                    
-                    import_path = project_root / ".coi" / "pkgs" / pkg_path;
-                }
-                else
-                {
-                    // Relative import
-                    import_path = parent_path / import_str;
+                    std::cerr << colors::RED << "Error:" << colors::RESET << " " << import.error << std::endl;
+                    return 1;
                 }
-                
-                try
+                direct_imports.insert(import.path);
+                if (import.is_public)
                 {
-                    std::string abs_path = fs::canonical(import_path).string();
-                    direct_imports.insert(abs_path);
-                    if (import_decl.is_public)
-                    {
-                        current_pub_imports.insert(abs_path);
-                    }
-                    if (processed_files.find(abs_path) == processed_files.end())
-                    {
-                        file_queue.push(abs_path);
-                    }
+                    current_pub_imports.insert(import.path);
                 }
-                catch (const std::exception &e)
+                if (processed_files.find(import.path) == processed_files.end())
                 {
-                    std::cerr << colors::RED << "Error:" << colors::RESET << " resolving import path " << import_decl.path << ": " << e.what() << std::endl;
-                    return 1;
+                    file_queue.push(import.path);
                 }
             }
             file_imports[current_file_path] = std::move(direct_imports);
@@ -430,6 +417,17 @@ int main(int argc, char **argv)
 
         std::cerr << "All files processed. Total components: " << all_components.size() << std::endl;
 
+        if (parse_cache)
+        {
+            size_t parsed_files = parse_cache->hits() + parse_cache->misses();
+            if (parsed_files > 0)
+            {
+                std::cerr << "Parse cache: " << parse_cache->hits() << " of " << parsed_files << " files reused ("
+                          << parse_cache->hits() * 100 / parsed_files << "%)" << std::endl;
+            }
+            parse_cache->prune();
+        }
+
         validate_view_hierarchy(all_components, file_imports);
         validate_type_imports(all_components, all_global_enums, all_global_data, file_imports);
         validate_mutability(all_components);
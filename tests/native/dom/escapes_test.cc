@@ -0,0 +1,43 @@
+// View text with backslashes (escapes.coi). Every code path must put the
+// characters written in the source on the page, the static subtree built
+// with one set_inner_html call included.
+
+#include "dom_gen.h"
+#include <cstdio>
+
+using namespace webcc;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s\n%s\n", what, got.c_str());
+}
+
+// Text of the first element with this tag
+static std::string text_of(const char* tag) {
+    for (const auto& [id, n] : stub::nodes) {
+        if (n.kind == stub::Node::Element && n.tag == tag) return stub::text(id);
+    }
+    return "?";
+}
+
+int main() {
+    stub::start(escapes::main);
+    const std::string source = R"(a\tb c\d)";
+
+    std::string section;
+    for (const auto& [id, n] : stub::nodes) {
+        if (n.tag == "section") section = stub::html(id);
+    }
+    expect(section == "<section><p>" + source + "</p></section>", "static subtree", section);
+    expect(text_of("h1") == source, "only text", text_of("h1"));
+    expect(text_of("h2") == source + " 1", "text with a binding", text_of("h2"));
+    expect(text_of("h3") == source + "!1", "text beside an element", text_of("h3"));
+
+    stub::clear();
+    stub::fire(dom::ClickEvent{stub::find("button", "Bump")});
+    expect(text_of("h2") == source + " 2", "text with a binding after update", text_of("h2"));
+
+    if (failures) std::printf("%d failure(s)\n", failures);
+    return failures ? 1 : 0;
+}
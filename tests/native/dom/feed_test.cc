@@ -0,0 +1,56 @@
+// WebSocket messages with coalesce on (feed.coi). A burst larger than one
+// frame's budget is handled over several frames, in order, updating the view
+// at the end of each; messages left for a later frame keep their text after
+// webcc reuses its buffer.
+
+#include "dom_gen.h"
+#include <cstdio>
+
+using namespace webcc;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s\n%s\n", what, got.c_str());
+}
+
+static std::string text_of(const char* tag) {
+    for (const auto& [id, n] : stub::nodes) {
+        if (n.kind == stub::Node::Element && n.tag == tag) return stub::text(id);
+    }
+    return "?";
+}
+
+int main() {
+    stub::start(feed::main);
+    handle socket = feed::app->ws;
+
+    // Every clock read costs a millisecond, so the 4 ms budget runs out
+    // well before 100 messages
+    const int burst = 100;
+    std::vector<std::string> buffer;
+    for (int i = 0; i < burst; i++) buffer.push_back("m" + std::to_string(i));
+    for (const auto& data : buffer) stub::events.push_back(Event::of(websocket::MessageEvent{socket, data}));
+    stub::clock_step = 1;
+    stub::clear();
+    stub::frame();
+
+    int first = feed::app->received;
+    expect(first > 0 && first < burst, "first frame stops at the budget", std::to_string(first));
+    expect((int)feed::__coi_events::g_deferred == burst - first, "rest deferred", std::to_string(first));
+    expect(text_of("p") == std::to_string(first), "view shows the first frame's messages", text_of("p"));
+    expect(stub::count("create li") == first, "one row per handled message", stub::log_text());
+
+    // webcc reuses its buffer once the frame is over
+    for (auto& data : buffer) data.assign(data.size(), 'x');
+
+    for (int i = 0; i < 100 && feed::app->received < burst; i++) stub::frame();
+    expect(feed::app->received == burst, "later frames handle the rest", std::to_string(feed::app->received));
+    bool in_order = (int)feed::app->lines.size() == burst;
+    for (int i = 0; in_order && i < burst; i++) in_order = feed::app->lines[i] == "m" + std::to_string(i);
+    expect(in_order, "messages handled in order with their own text");
+    expect(text_of("p") == std::to_string(burst), "view shows every message", text_of("p"));
+
+    if (failures) std::printf("%d failure(s)\n", failures);
+    return failures ? 1 : 0;
+}
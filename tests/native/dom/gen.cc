@@ -0,0 +1,72 @@
+// Writes dom_gen.h for the native DOM tests: every *.coi program of this
+// suite compiled by the compiler's own pipeline, each wrapped in a namespace
+// named after its file and built against shim.h instead of webcc.
+
+#include "frontend/lexer.h"
+#include "frontend/parser/parser.h"
+#include "ast/arena.h"
+#include "analysis/type_checker.h"
+#include "analysis/include_detector.h"
+#include "analysis/feature_detector.h"
+#include "codegen/codegen.h"
+#include "defs/def_parser.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+static std::string compile(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream source;
+    source << in.rdbuf();
+    std::string text = source.str();
+
+    Lexer lexer(text);
+    Parser parser(text, lexer.tokenize());
+    parser.parse_file();
+    std::vector<Component> components = std::move(parser.components);
+    for (auto& comp : components) comp.source_file = path.string();
+
+    validate_view_hierarchy(components);
+    validate_type_imports(components, parser.global_enums, parser.global_data, {});
+    validate_mutability(components);
+    validate_types(components, parser.global_enums, parser.global_data);
+
+    std::set<std::string> headers = get_required_headers(components);
+    FeatureFlags features = detect_features(components, headers);
+    std::stringstream out;
+    generate_cpp_code(out, components, parser.global_data, parser.global_enums, parser.app_config, headers, features);
+    return out.str();
+}
+
+int main() {
+    fs::path suite = fs::path(__FILE__).parent_path();
+    // load() reports what it read on stdout, which is the header here
+    std::stringstream load_report;
+    std::streambuf* out = std::cout.rdbuf(load_report.rdbuf());
+    DefSchema::instance().load((suite / "../../../defs").string());
+    std::cout.rdbuf(out);
+
+    std::vector<fs::path> programs;
+    for (const auto& e : fs::directory_iterator(suite)) {
+        if (e.path().extension() == ".coi") programs.push_back(e.path());
+    }
+    std::sort(programs.begin(), programs.end());
+
+    AstArena arena;
+    AstArena::Scope scope(arena);
+    std::cout << "#pragma once\n#include \"shim.h\"\n";
+    for (const auto& path : programs) {
+        ComponentTypeContext::instance().component_types.clear();
+        std::stringstream code(compile(path));
+        std::cout << "namespace " << path.stem().string() << " {\n";
+        for (std::string line; std::getline(code, line);) {
+            if (line.rfind("#include \"webcc/", 0) != 0) std::cout << line << "\n";
+        }
+        std::cout << "}\n";
+    }
+    return 0;
+}
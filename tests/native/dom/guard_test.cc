@@ -0,0 +1,63 @@
+// Dispatcher entries changing under a running handler (guard.coi). A handler
+// that hides its own button, removes its own row, re-registers itself through
+// a patch, or registers enough handlers to grow the table must not be
+// destroyed or moved while it runs, and every handler must keep working.
+
+#include "dom_gen.h"
+#include <cstdio>
+
+using namespace webcc;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s\n%s\n", what, got.c_str());
+}
+
+static void click(const char* tag, const char* label) {
+    stub::clear();
+    stub::fire(dom::ClickEvent{stub::find(tag, label)});
+}
+
+static bool shows(const char* tag, const char* text) { return stub::find(tag, text).is_valid(); }
+
+int main() {
+    stub::start(guard::main);
+
+    // Hiding its own button removes the running handler
+    click("button", "Close");
+    expect(!shows("button", "Close") && shows("p", "1"), "close", stub::html(dom::get_body()));
+    expect(stub::destroyed_while_running == 0, "close handler destroyed while running");
+    click("button", "Open");
+    click("button", "Close");
+    expect(shows("p", "2"), "close again", stub::html(dom::get_body()));
+
+    // Removing its own row removes the running handler
+    click("li", "1");
+    expect(!shows("li", "1") && shows("li", "2"), "drop own row", stub::html(dom::get_body()));
+    click("li", "2");
+    expect(!shows("li", "2"), "drop next row", stub::html(dom::get_body()));
+    expect(stub::destroyed_while_running == 0, "row handler destroyed while running");
+
+    // A patch re-registers the running handler of a state-reading item
+    click("b", "2");
+    expect(stub::nodes[stub::find("b", "2").id].attrs["class"] == "on", "pick", stub::html(dom::get_body()));
+    click("b", "1");
+    expect(stub::nodes[stub::find("b", "1").id].attrs["class"] == "on" &&
+           stub::nodes[stub::find("b", "2").id].attrs["class"] == "off", "pick again", stub::html(dom::get_body()));
+    expect(stub::destroyed_while_running == 0, "patched handler destroyed while running");
+
+    // Registering a hundred handlers grows the table under the running one
+    click("button", "Grow");
+    expect(shows("b", "110"), "grow", stub::html(dom::get_body()));
+    expect(stub::destroyed_while_running == 0, "grow handler moved while running");
+    click("b", "110");
+    expect(stub::nodes[stub::find("b", "110").id].attrs["class"] == "on", "handler added while growing", stub::html(dom::get_body()));
+    click("button", "Close");
+    click("button", "Open");
+    click("button", "Close");
+    expect(shows("p", "3"), "handlers after grow", stub::html(dom::get_body()));
+
+    if (failures) std::printf("%d failure(s)\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+// Component array rendered with <{item}/> (items.coi). Items start from an
+// array literal; pushing, removing and reassigning must keep every item's
+// click handler pointing at that item, and pausing one item's tick must
+// leave the others running.
+
+#include "dom_gen.h"
+#include <cstdio>
+
+using namespace webcc;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s\n%s\n", what, got.c_str());
+}
+
+static void click(const char* tag, const char* label) {
+    stub::clear();
+    stub::fire(dom::ClickEvent{stub::find(tag, label)});
+}
+
+// Text of each <li> in the list, in page order
+static std::string rows() {
+    std::string out;
+    for (const auto& [id, n] : stub::nodes) {
+        if (n.tag == "ul") for (int32_t c : n.children) if (stub::nodes[c].tag == "li") out += stub::text(c) + " ";
+    }
+    return out;
+}
+
+int main() {
+    stub::start(items::main);
+    expect(rows() == "1:0 2:0 ", "array literal renders", rows());
+
+    click("li", "1:0");
+    expect(rows() == "1:1 2:0 ", "click", rows());
+
+    // A push renders the new item only
+    click("button", "Add");
+    expect(rows() == "1:1 2:0 3:0 ", "push", rows());
+    expect(stub::count("create li") == 1 && stub::count("remove_element li") == 0, "push commands", stub::log_text());
+
+    // Removing the first item removes its element; the others move down a
+    // slot and their handlers follow them
+    click("button", "Drop");
+    expect(rows() == "2:0 3:0 ", "remove", rows());
+    expect(stub::count("remove_element li") == 1 && stub::count("create li") == 0, "remove commands", stub::log_text());
+    click("li", "3:0");
+    expect(rows() == "2:0 3:1 ", "click after remove", rows());
+
+    // Enough pushes to allocate new storage never move the earlier items
+    click("button", "Add many");
+    expect(stub::count("create li") == 20 && stub::count("remove_element li") == 0, "push many commands", stub::log_text());
+    click("li", "2:0");
+    click("li", "22:0");
+    expect(rows().rfind("2:1 3:1 4:0 ", 0) == 0 && rows().find(" 22:1 ") != std::string::npos, "clicks after push many", rows());
+
+    // Reassigning from a literal renders fresh items that take clicks
+    click("button", "Reset");
+    expect(rows() == "1:0 24:0 ", "reassign", rows());
+    click("li", "24:0");
+    expect(rows() == "1:0 24:1 ", "click after reassign", rows());
+
+    // Pausing the first item's tick leaves the second ticking
+    auto& list = items::app->items;
+    int first = list[0].ticks, second = list[1].ticks;
+    for (int i = 0; i < 3; i++) stub::frame();
+    expect(list[0].ticks == first + 3 && list[1].ticks == second + 3, "both tick");
+    click("button", "Hold");
+    first = list[0].ticks, second = list[1].ticks;
+    for (int i = 0; i < 3; i++) stub::frame();
+    expect(list[0].ticks == first && list[1].ticks == second + 3, "paused item holds");
+    click("button", "Free");
+    first = list[0].ticks;
+    for (int i = 0; i < 3; i++) stub::frame();
+    expect(list[0].ticks == first + 3, "resumed item ticks");
+
+    expect(stub::destroyed_while_running == 0, "handler destroyed while running");
+    if (failures) std::printf("%d failure(s)\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,61 @@
+// Keyed loop of child components (keyed.coi). Swapping, removing, pushing
+// and writing a field must each issue only the DOM commands that change,
+// in order, and keep the elements of the rows that survive.
+
+#include "dom_gen.h"
+#include <cstdio>
+
+using namespace webcc;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s\n%s\n", what, got.c_str());
+}
+
+static void click(const char* label) {
+    stub::clear();
+    stub::fire(dom::ClickEvent{stub::find("button", label)});
+}
+
+// Text of each <li> in the list, in page order
+static std::string rows() {
+    std::string out;
+    for (const auto& [id, n] : stub::nodes) {
+        if (n.tag == "ul") for (int32_t c : n.children) if (stub::nodes[c].tag == "li") out += stub::text(c) + " ";
+    }
+    return out;
+}
+
+int main() {
+    stub::start(keyed::main);
+    expect(rows() == "one two three ", "initial rows", rows());
+    expect(stub::count("create li") == 3, "one element per row", stub::log_text());
+    int32_t one = stub::find("li", "one").id, three = stub::find("li", "three").id;
+
+    // Swapping the ends moves two elements and creates or rewrites nothing
+    click("Swap");
+    expect(rows() == "three two one ", "swap order", rows());
+    expect(stub::log_text() == "insert_before li\ninsert_before li\n", "swap commands", stub::log_text());
+    expect(stub::find("li", "one").id == one && stub::find("li", "three").id == three, "swap keeps elements");
+
+    // Removing the first row removes its element only
+    click("Drop");
+    expect(rows() == "two one ", "remove order", rows());
+    expect(stub::log_text() == "remove_element li\n", "remove commands", stub::log_text());
+    expect(stub::nodes[three].parent < 0, "removed element detached");
+
+    // A pushed row is created in place before the loop anchor
+    click("Add");
+    expect(rows() == "two one new ", "push order", rows());
+    expect(stub::log_text() == "create li\ninsert_before li\nset_inner_text li\n", "push commands", stub::log_text());
+
+    // A field write updates that row's text and moves nothing
+    click("Rename");
+    expect(rows() == "two renamed new ", "field write", rows());
+    expect(stub::log_text() == "set_inner_text li\n", "field write commands", stub::log_text());
+    expect(stub::find("li", "renamed").id == one, "field write keeps element");
+
+    if (failures) std::printf("%d failure(s)\n", failures);
+    return failures ? 1 : 0;
+}
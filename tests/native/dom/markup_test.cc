@@ -0,0 +1,50 @@
+// Static subtrees (markup.coi). Markup the HTML parser would restructure must
+// be created node by node; the rest goes through set_inner_html. Either way
+// the page must hold the tree written in the source.
+
+#include "dom_gen.h"
+#include <cstdio>
+
+using namespace webcc;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s\n%s\n", what, got.c_str());
+}
+
+int main() {
+    stub::start(markup::main);
+
+    std::string page;
+    std::string inner;  // Markup passed to set_inner_html, one per line
+    for (const auto& [id, n] : stub::nodes) {
+        if (n.kind == stub::Node::Html) inner += n.text + "\n";
+        if (n.parent == 0) page = stub::html(id);
+    }
+
+    expect(page ==
+           "<div>"
+           "<table><tr><td>cell</td></tr></table>"
+           "<p><div>block</div></p>"
+           "<a href=\"#out\"><span><a href=\"#in\">link</a></span></a>"
+           "<form><form>inner</form></form>"
+           "<button><button>press</button></button>"
+           "<p><span><b>bold</b></span></p>"
+           "<section><p><em>fine</em></p></section>"
+           "</div>",
+           "page holds the source tree", page);
+
+    // Only markup that parses back to the same tree is set as HTML. The inner
+    // <a> is parsed with the <span> as context, where no outer <a> is open
+    expect(inner ==
+           "<a href=\"#in\">link</a>\n"
+           "<span><b>bold</b></span>\n"
+           "<p><em>fine</em></p>\n",
+           "static path taken only for markup that parses back", inner);
+    expect(stub::count("create tr") == 1 && stub::count("create td") == 1, "table rows created per node", stub::log_text());
+    expect(stub::count("create form") == 2 && stub::count("create button") == 2, "nested form and button created per node", stub::log_text());
+
+    if (failures) std::printf("%d failure(s)\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,44 @@
+// Memo component (memo.coi). A cached binding writes only when its text
+// changes, and Memo.written()/Memo.skipped() report the writes to coi code.
+
+#include "dom_gen.h"
+#include <cstdio>
+
+using namespace webcc;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s\n%s\n", what, got.c_str());
+}
+
+static void click(const char* label) {
+    stub::clear();
+    stub::fire(dom::ClickEvent{stub::find("button", label)});
+}
+
+int main() {
+    stub::start(memo::main);
+
+    // The first update of a binding writes; the same text again is skipped
+    click("Bump");
+    expect(stub::count("set_inner_text b") == 1, "first update writes", stub::log_text());
+    click("Bump");
+    expect(stub::count("set_inner_text b") == 0, "unchanged text skipped", stub::log_text());
+    click("Count");
+    expect(stub::find("p", "1 written, 1 skipped").is_valid(), "counters after two updates", stub::html(dom::get_body()));
+
+    // Values 3..11 show 0 or 1: only the change to 1 is written
+    int writes = 0;
+    for (int i = 0; i < 9; i++) {
+        click("Bump");
+        writes += stub::count("set_inner_text b");
+    }
+    expect(writes == 1, "one write for nine updates");
+    expect(stub::find("b", "1").is_valid(), "changed text written", stub::html(dom::get_body()));
+    click("Count");
+    expect(stub::find("p", "2 written, 9 skipped").is_valid(), "counters after eleven updates", stub::html(dom::get_body()));
+
+    if (failures) std::printf("%d failure(s)\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,54 @@
+// Keyed HTML loops (picker.coi). Items whose bindings read component state
+// follow that state: every surviving item is patched when it changes. Items
+// that depend on nothing but themselves are patched only when they change.
+
+#include "dom_gen.h"
+#include <cstdio>
+
+using namespace webcc;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s\n%s\n", what, got.c_str());
+}
+
+static void click(const char* tag, const char* label) {
+    stub::clear();
+    stub::fire(dom::ClickEvent{stub::find(tag, label)});
+}
+
+static std::string list(const char* tag) {
+    std::string out;
+    for (const auto& [id, n] : stub::nodes) {
+        if (n.tag == tag) for (int32_t c : n.children) out += stub::html(c);
+    }
+    return out;
+}
+
+int main() {
+    stub::start(picker::main);
+    expect(list("ul") == "<li class=\"on\">one</li><li class=\"off\">two</li><li class=\"off\">three</li>", "initial", list("ul"));
+
+    // Picking changes state only: the list reading it is patched, the other untouched
+    click("li", "two");
+    expect(list("ul") == "<li class=\"off\">one</li><li class=\"on\">two</li><li class=\"off\">three</li>", "pick", list("ul"));
+    expect(stub::count("set_attribute li") == 3 && stub::count("create li") == 0, "pick patches each item", stub::log_text());
+    expect(stub::count("set_inner_text b") == 0, "pick leaves the other list", stub::log_text());
+
+    // A pushed item is created with the current state
+    click("button", "Add");
+    expect(list("ul") == "<li class=\"off\">one</li><li class=\"on\">two</li><li class=\"off\">three</li><li class=\"off\">new</li>", "push", list("ul"));
+    expect(stub::count("create li") == 1 && stub::count("create b") == 1 && stub::count("set_attribute li") == 1, "push commands", stub::log_text());
+
+    // A field write patches only the written item in both lists
+    click("button", "Rename");
+    expect(list("ol") == "<b>one</b><b>two</b><b>third</b><b>new</b>", "field write", list("ol"));
+    expect(stub::log_text() == "set_attribute li\nset_inner_text li\nset_inner_text b\n", "field write commands", stub::log_text());
+
+    click("li", "new");
+    expect(list("ul") == "<li class=\"off\">one</li><li class=\"off\">two</li><li class=\"off\">third</li><li class=\"on\">new</li>", "pick pushed", list("ul"));
+
+    if (failures) std::printf("%d failure(s)\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,356 @@
+// Native stand-in for the parts of webcc the generated app code uses. DOM
+// commands are applied to an in-memory node tree and logged, so tests can
+// check both what the page ends up showing and which commands it took to
+// get there. coi::function reports being destroyed or replaced while it runs.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <new>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace webcc {
+
+using std::move;
+inline void* malloc(size_t size) { return std::malloc(size); }
+
+using string_view = std::string_view;
+
+struct string : std::string {
+    using std::string::string;
+    string() = default;
+    string(const std::string& s) : std::string(s) {}
+    explicit string(std::string_view s) : std::string(s) {}
+    uint32_t length() const { return (uint32_t)size(); }
+    int to_int() const { return std::atoi(c_str()); }
+    double to_float() const { return std::atof(c_str()); }
+    bool is_empty() const { return empty(); }
+};
+
+template<typename T> struct vector : std::vector<T> {
+    using std::vector<T>::vector;
+    void remove(int index) {
+        if (index >= 0 && (size_t)index < this->size()) this->erase(this->begin() + index);
+    }
+    int index_of(const T& v) const {
+        for (size_t i = 0; i < this->size(); i++) if ((*this)[i] == v) return (int)i;
+        return -1;
+    }
+    bool contains(const T& v) const { return index_of(v) >= 0; }
+    void sort() { std::sort(this->begin(), this->end()); }
+};
+
+template<typename T, size_t N> struct array : std::array<T, N> {};
+
+template<typename K, typename V> struct unordered_map : std::unordered_map<K, V> {};
+
+namespace stub {
+inline int destroyed_while_running = 0;  // coi::function destroyed or replaced during its own call
+}
+
+template<typename Signature> class function;
+template<typename R, typename... A> class function<R(A...)> {
+    std::function<R(A...)> fn;
+    bool* running = nullptr;  // Set while operator() is on the stack
+    void check() { if (running) { *running = false; running = nullptr; stub::destroyed_while_running++; } }
+public:
+    function() = default;
+    template<typename F, typename = decltype(std::function<R(A...)>(std::declval<F>()))>
+    function(F f) : fn(std::move(f)) {}
+    function(const function& o) : fn(o.fn) {}
+    function(function&& o) : fn(std::move(o.fn)) { o.check(); }
+    function& operator=(const function& o) { check(); fn = o.fn; return *this; }
+    function& operator=(function&& o) { check(); fn = std::move(o.fn); o.check(); return *this; }
+    ~function() { check(); }
+    explicit operator bool() const { return (bool)fn; }
+    R operator()(A... args) {
+        bool alive = true;
+        bool* outer = running;
+        running = &alive;
+        struct Restore { function* self; bool* alive; bool* outer; ~Restore() { if (*alive) self->running = outer; } } restore{this, &alive, outer};
+        return fn(args...);
+    }
+};
+
+struct handle {
+    int32_t id = -1;
+    handle() = default;
+    explicit handle(int32_t i) : id(i) {}
+    explicit operator int32_t() const { return id; }
+    bool is_valid() const { return id >= 0; }
+};
+struct DOMElement : handle {
+    DOMElement() = default;
+    explicit DOMElement(int32_t i) : handle(i) {}
+    DOMElement(handle h) : handle(h) {}
+};
+
+template<int N> struct formatter {
+    std::string buf;
+    template<typename T> formatter& operator<<(const T& v) {
+        if constexpr (std::is_same_v<T, bool>) buf += v ? "true" : "false";
+        else if constexpr (std::is_integral_v<T>) buf += std::to_string((long long)v);
+        else if constexpr (std::is_enum_v<T>) buf += std::to_string((long long)v);
+        else if constexpr (std::is_floating_point_v<T>) { char b[32]; std::snprintf(b, sizeof(b), "%g", (double)v); buf += b; }
+        else buf += std::string_view(v);
+        return *this;
+    }
+    const char* c_str() const { return buf.c_str(); }
+};
+template<int N> using hybrid_formatter = formatter<N>;
+
+inline constexpr float PI = 3.14159265f;
+inline constexpr float HALF_PI = PI / 2;
+inline constexpr float TAU = PI * 2;
+inline constexpr float DEG2RAD = PI / 180;
+inline constexpr float RAD2DEG = 180 / PI;
+inline float abs(float x) { return std::fabs(x); }
+inline float sqrt(float x) { return std::sqrt(x); }
+inline float sin(float x) { return std::sin(x); }
+inline float cos(float x) { return std::cos(x); }
+inline float tan(float x) { return std::tan(x); }
+inline double random() { return 0.5; }
+inline void random_seed(int) {}
+
+struct Event {
+    uint32_t opcode = 0;
+    alignas(8) unsigned char data[48] = {};
+    template<typename T> const T* as() const {
+        return opcode == T::OPCODE ? reinterpret_cast<const T*>(data) : nullptr;
+    }
+    template<typename T> static Event of(const T& payload) {
+        static_assert(sizeof(T) <= sizeof(data));
+        Event e;
+        e.opcode = T::OPCODE;
+        new (e.data) T(payload);
+        return e;
+    }
+};
+
+namespace stub {
+
+// One node of the page. Text set with set_inner_text or set_inner_html
+// replaces the children with a single text or raw HTML node.
+struct Node {
+    enum Kind { Element, Text, Comment, Html } kind = Element;
+    std::string tag;
+    std::string text;
+    std::map<std::string, std::string> attrs;
+    int32_t parent = -1;
+    std::vector<int32_t> children;
+};
+
+inline std::map<int32_t, Node> nodes;
+inline std::vector<std::string> commands;  // Log of DOM commands, e.g. "insert_before li"
+inline std::vector<Event> events;
+inline void (*main_loop)(double) = nullptr;
+inline int32_t next_id = 1;
+inline int32_t next_inner = 1 << 24;  // Nodes made by set_inner_text/set_inner_html
+inline int flushes = 0;
+inline double now = 0;
+inline double clock_step = 0;  // Added to the clock by each get_time(), as if handlers took time
+inline std::vector<std::string> logged;  // Lines passed to system::log
+
+inline std::string describe(int32_t id) {
+    auto it = nodes.find(id);
+    if (it == nodes.end()) return "?";
+    switch (it->second.kind) {
+        case Node::Element: return it->second.tag;
+        case Node::Text: return "#text";
+        case Node::Comment: return "#comment";
+        case Node::Html: return "#html";
+    }
+    return "?";
+}
+inline void record(const char* op, int32_t id) { commands.push_back(std::string(op) + " " + describe(id)); }
+
+inline void detach(int32_t id) {
+    Node& n = nodes[id];
+    if (n.parent < 0) return;
+    auto& siblings = nodes[n.parent].children;
+    siblings.erase(std::find(siblings.begin(), siblings.end(), id));
+    n.parent = -1;
+}
+inline void insert(int32_t parent, int32_t child, int32_t before) {
+    detach(child);
+    auto& children = nodes[parent].children;
+    auto at = std::find(children.begin(), children.end(), before);
+    children.insert(at, child);
+    nodes[child].parent = parent;
+}
+inline void replace_children(int32_t id, Node::Kind kind, std::string_view text) {
+    for (int32_t c : std::vector<int32_t>(nodes[id].children)) detach(c);
+    if (text.empty()) return;
+    int32_t inner = next_inner++;
+    nodes[inner].kind = kind;
+    nodes[inner].text = std::string(text);
+    insert(id, inner, -1);
+}
+
+// Markup of a node, without comments and the scope attribute
+inline std::string html(int32_t id) {
+    const Node& n = nodes[id];
+    if (n.kind == Node::Text || n.kind == Node::Html) return n.text;
+    if (n.kind == Node::Comment) return "";
+    std::string out = "<" + n.tag;
+    for (const auto& [name, value] : n.attrs) if (name != "coi-scope") out += " " + name + "=\"" + value + "\"";
+    out += ">";
+    for (int32_t c : n.children) out += html(c);
+    return out + "</" + n.tag + ">";
+}
+inline std::string html(handle h) { return html(h.id); }
+inline std::string text(int32_t id) {
+    const Node& n = nodes[id];
+    if (n.kind == Node::Text) return n.text;
+    std::string out;
+    for (int32_t c : n.children) out += text(c);
+    return out;
+}
+
+// The attached element with this tag whose text is `content`, or an invalid handle
+inline handle find(std::string_view tag, std::string_view content) {
+    for (const auto& [id, n] : nodes) {
+        if (n.kind != Node::Element || n.tag != tag) continue;
+        int32_t top = id;
+        while (nodes[top].parent >= 0) top = nodes[top].parent;
+        if (top == 0 && text(id) == content) return handle(id);
+    }
+    return handle();
+}
+
+// Commands logged since the last clear() whose text is `command`
+inline int count(std::string_view command) {
+    return (int)std::count(commands.begin(), commands.end(), command);
+}
+inline std::string log_text() {
+    std::string out;
+    for (const auto& c : commands) out += c + "\n";
+    return out;
+}
+inline void clear() { commands.clear(); flushes = 0; }
+
+inline void frame() { now += 16; if (main_loop) main_loop(now); }
+template<typename T> inline void fire(const T& payload) { events.push_back(Event::of(payload)); frame(); }
+
+// Start an app: fresh page, then the generated main()
+inline void start(int (*app_main)()) {
+    nodes.clear();
+    nodes[0].tag = "body";
+    commands.clear();
+    events.clear();
+    logged.clear();
+    main_loop = nullptr;
+    next_id = 1;
+    flushes = 0;
+    clock_step = 0;
+    destroyed_while_running = 0;
+    app_main();
+}
+
+}  // namespace stub
+
+inline int32_t next_deferred_handle() { return stub::next_id++; }
+inline void flush() { stub::flushes++; }
+inline bool poll_event(Event& e) {
+    if (stub::events.empty()) return false;
+    e = stub::events.front();
+    stub::events.erase(stub::events.begin());
+    return true;
+}
+
+namespace dom {
+struct ClickEvent { static constexpr uint32_t OPCODE = 1; webcc::handle handle; };
+struct InputEvent { static constexpr uint32_t OPCODE = 2; webcc::handle handle; string_view value; };
+struct ChangeEvent { static constexpr uint32_t OPCODE = 3; webcc::handle handle; string_view value; };
+
+inline handle get_body() { return handle(0); }
+inline void create_element_deferred(handle h, string_view tag) {
+    stub::nodes[h.id].tag = std::string(tag);
+    stub::record("create", h.id);
+}
+inline void create_element_deferred_scoped(handle h, string_view tag, string_view scope) {
+    create_element_deferred(h, tag);
+    stub::nodes[h.id].attrs["coi-scope"] = std::string(scope);
+}
+inline void create_text_node_deferred(handle h, string_view text) {
+    stub::nodes[h.id].kind = stub::Node::Text;
+    stub::nodes[h.id].text = std::string(text);
+    stub::record("create", h.id);
+}
+inline void create_comment_deferred(handle h, string_view text) {
+    stub::nodes[h.id].kind = stub::Node::Comment;
+    stub::nodes[h.id].text = std::string(text);
+    stub::record("create", h.id);
+}
+inline void append_child(handle parent, handle child) {
+    stub::insert(parent.id, child.id, -1);
+    stub::record("append_child", child.id);
+}
+inline void insert_before(handle parent, handle child, handle before) {
+    stub::insert(parent.id, child.id, before.id);
+    stub::record("insert_before", child.id);
+}
+inline void remove_element(handle h) {
+    stub::detach(h.id);
+    stub::record("remove_element", h.id);
+}
+inline void set_inner_text(handle h, string_view text) {
+    stub::replace_children(h.id, stub::Node::Text, text);
+    stub::record("set_inner_text", h.id);
+}
+inline void set_inner_html(handle h, string_view html) {
+    stub::replace_children(h.id, stub::Node::Html, html);
+    stub::record("set_inner_html", h.id);
+}
+inline void set_node_value(handle h, string_view text) {
+    stub::nodes[h.id].text = std::string(text);
+    stub::record("set_node_value", h.id);
+}
+inline void set_attribute(handle h, string_view name, string_view value) {
+    stub::nodes[h.id].attrs[std::string(name)] = std::string(value);
+    stub::record("set_attribute", h.id);
+}
+inline void set_property(handle h, string_view name, string_view value) {
+    stub::nodes[h.id].attrs[std::string(name)] = std::string(value);
+    stub::record("set_property", h.id);
+}
+inline void add_click_listener(handle) {}
+inline void add_input_listener(handle) {}
+inline void add_change_listener(handle) {}
+}  // namespace dom
+
+struct WebSocket : handle {
+    WebSocket() = default;
+    explicit WebSocket(int32_t i) : handle(i) {}
+    WebSocket(handle h) : handle(h) {}
+};
+
+namespace websocket {
+struct MessageEvent { static constexpr uint32_t OPCODE = 10; webcc::handle handle; string_view data; };
+struct OpenEvent { static constexpr uint32_t OPCODE = 11; webcc::handle handle; };
+struct CloseEvent { static constexpr uint32_t OPCODE = 12; webcc::handle handle; };
+struct ErrorEvent { static constexpr uint32_t OPCODE = 13; webcc::handle handle; };
+
+inline WebSocket connect(string_view) { return WebSocket(stub::next_id++); }
+inline void send(handle, string_view) {}
+inline void close(handle) {}
+}  // namespace websocket
+
+namespace system {
+inline double get_time() { return stub::now += stub::clock_step; }
+inline int is_hidden() { return 0; }
+inline void set_main_loop(void (*fn)(double)) { stub::main_loop = fn; }
+inline void log(string_view text) { stub::logged.push_back(std::string(text)); }
+}  // namespace system
+
+}  // namespace webcc
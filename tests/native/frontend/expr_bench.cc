@@ -0,0 +1,69 @@
+// Expression parsing throughput: a generated file of operator-heavy methods,
+// and single expressions nested 10,000 deep through parentheses, prefix
+// operators and ternaries. Run with `tests/run.py native --bench`.
+
+#include "ast/arena.h"
+#include "frontend/lexer.h"
+#include "frontend/parser/parser.h"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+// prepare runs before each timed step, outside the measurement
+template<typename P, typename F>
+static void run(const char* name, size_t bytes, P prepare, F step) {
+    double best = 1e9;
+    for (int round = 0; round < 7; round++) {
+        prepare();
+        auto start = std::chrono::steady_clock::now();
+        step();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds < best) best = seconds;
+    }
+    std::printf("%-10s %7.2f MB  %8.2f ms  %8.1f MB/s\n", name, bytes / 1e6, best * 1e3, bytes / 1e6 / best);
+}
+
+static void parse(const char* name, const std::string& source) {
+    Lexer lexer(source);
+    const std::vector<Token> tokens = lexer.tokenize();
+    std::vector<Token> round_tokens;
+    run(name, source.size(), [&] { round_tokens = tokens; }, [&] {
+        AstArena arena;
+        AstArena::Scope scope(arena);
+        Parser parser(source, std::move(round_tokens));
+        parser.parse_file();
+    });
+}
+
+static std::string component(const std::string& body) {
+    return "component Bench {\n    mut int a = 1;\n    mut int b = 2;\n    mut bool c = true;\n" + body + "}\n";
+}
+
+int main() {
+    std::string methods;
+    for (int i = 0; methods.size() < 4000000; i++) {
+        std::string n = std::to_string(i);
+        methods +=
+            "    def f" + n + "(int x, int y) : int {\n"
+            "        int z = (x + y * " + n + " - (x % 7)) << 2 | y & 0xFF ^ x >> 1;\n"
+            "        bool ok = x > y && y <= " + n + " || !c && (a != b || a == x + 1);\n"
+            "        z += ok ? -x * 2 : y > 3 ? ~y : a + b - c ? 1 : 0;\n"
+            "        return items[x + 1].value(z, y - 1, \"s\") + f" + n + "(z / 2, y) * (x - y);\n"
+            "    }\n";
+    }
+    parse("operators", component(methods));
+
+    const int depth = 10000;
+    std::string parens(depth, '(');
+    parens += "a" + std::string(depth, ')');
+    parse("parens", component("    def f() : int { return " + parens + "; }\n"));
+
+    std::string prefix;
+    for (int i = 0; i < depth; i++) prefix += "- ";
+    parse("prefix", component("    def f() : int { return " + prefix + "a; }\n"));
+
+    std::string ternary;
+    for (int i = 0; i < depth; i++) ternary += "a > " + std::to_string(i) + " ? " + std::to_string(i) + " : ";
+    parse("ternary", component("    def f() : int { return " + ternary + "0; }\n"));
+    return 0;
+}
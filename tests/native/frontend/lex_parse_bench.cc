@@ -0,0 +1,70 @@
+// Lexing and parsing throughput of the compiler frontend over a corpus made
+// of the example app's sources, repeated. Run with `tests/run.py native --bench`.
+
+#include "ast/arena.h"
+#include "frontend/lexer.h"
+#include "frontend/parser/parser.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+static std::string corpus() {
+    fs::path examples = fs::path(__FILE__).parent_path() / "../../../example/src";
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(examples)) {
+        if (entry.path().extension() == ".coi") files.push_back(entry.path());
+    }
+    std::sort(files.begin(), files.end());
+
+    std::string sources;
+    for (const auto& file : files) {
+        std::ifstream in(file);
+        std::stringstream text;
+        text << in.rdbuf();
+        sources += text.str() + "\n";
+    }
+    std::string out;
+    while (out.size() < 8000000) out += sources;
+    return out;
+}
+
+// prepare runs before each timed step, outside the measurement
+template<typename P, typename F>
+static void run(const char* name, size_t bytes, P prepare, F step) {
+    double best = 1e9;
+    for (int round = 0; round < 7; round++) {
+        prepare();
+        auto start = std::chrono::steady_clock::now();
+        step();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (seconds < best) best = seconds;
+    }
+    std::printf("%-6s %7.2f MB  %8.2f ms  %8.1f MB/s\n", name, bytes / 1e6, best * 1e3, bytes / 1e6 / best);
+}
+
+int main() {
+    std::string source = corpus();
+    size_t count = 0;
+    run("lex", source.size(), [] {}, [&] {
+        Lexer lexer(source);
+        count = lexer.tokenize().size();
+    });
+    Lexer lexer(source);
+    const std::vector<Token> tokens = lexer.tokenize();
+    std::vector<Token> round_tokens;
+    size_t components = 0;
+    run("parse", source.size(), [&] { round_tokens = tokens; }, [&] {
+        AstArena arena;
+        AstArena::Scope scope(arena);
+        Parser parser(source, std::move(round_tokens));
+        parser.parse_file();
+        components = parser.components.size();
+    });
+    std::printf("%zu tokens, %zu components\n", count, components);
+    return 0;
+}
@@ -0,0 +1,59 @@
+// Tokens are spans into the source. Check the spans and line numbers, that
+// string literals are decoded on demand, and that the parser's spacing of view
+// text and style blocks, which is derived from span offsets, is unchanged.
+
+#include "frontend/lexer.h"
+#include "frontend/parser/parser.h"
+#include "ast/view.h"
+#include <cstdio>
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s (%s)\n", what, got.c_str());
+}
+
+static std::string_view span(std::string_view source, const Token& tok) {
+    return source.substr(tok.offset, tok.length);
+}
+
+int main() {
+    expect(sizeof(Token) == 16, "token is 16 bytes");
+
+    std::string_view source = "int x = 0x1F;\n  y += \"a\\\"b\\n\" + `t\\`${x}\\n`;\n";
+    Lexer lexer(source);
+    std::vector<Token> tokens = lexer.tokenize();
+    const char* spans[] = {"int", "x", "=", "0x1F", ";", "y", "+=", "\"a\\\"b\\n\"", "+", "`t\\`${x}\\n`", ";", ""};
+    expect(tokens.size() == sizeof(spans) / sizeof(spans[0]), "token count", std::to_string(tokens.size()));
+    for (size_t i = 0; i < tokens.size() && i < sizeof(spans) / sizeof(spans[0]); i++) {
+        expect(span(source, tokens[i]) == spans[i], "span", std::string(span(source, tokens[i])));
+    }
+    expect(tokens[4].line == 1 && tokens[5].line == 2 && tokens.back().line == 3, "lines");
+    expect(tokens.back().type == TokenType::END_OF_FILE && tokens.back().offset == source.size(), "end of file");
+
+    // Strings decode their escapes; template strings only unescape backticks
+    expect(Lexer::literal_value(source, tokens[7]) == "a\"b\n", "string value", Lexer::literal_value(source, tokens[7]));
+    expect(Lexer::literal_value(source, tokens[9]) == "t`${x}\\n", "template value", Lexer::literal_value(source, tokens[9]));
+
+    std::string_view app =
+        "component A {\n"
+        "    style { .a > p{ color : red; font-family: \"Fira Code\", mono } }\n"
+        "    view { <p>Hello,  \"world\" !{1}x <b>y</b></p> }\n"
+        "}\n";
+    Lexer app_lexer(app);
+    Parser parser(app, app_lexer.tokenize());
+    parser.parse_file();
+    const Component& comp = parser.components.at(0);
+    expect(comp.css == " .a > p{ color : red; font-family: \"Fira Code\", mono }\n", "style block", comp.css);
+
+    auto* p = dynamic_cast<HTMLElement*>(comp.render_roots.at(0).get());
+    expect(p && p->children.size() == 4, "view children");
+    if (p && p->children.size() == 4) {
+        auto* hello = dynamic_cast<TextNode*>(p->children[0].get());
+        auto* x = dynamic_cast<TextNode*>(p->children[2].get());
+        expect(hello && hello->text == "Hello, world !", "text spacing", hello ? hello->text : "");
+        expect(x && x->text == "x ", "trailing space", x ? x->text : "");
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,88 @@
+// load_files over a small import graph with a diamond, a package import, a
+// parse error and an unresolvable import. Every reachable file must be loaded
+// exactly once, and the results must not depend on the number of threads or
+// on whether files come from the parse cache.
+
+#include "frontend/loader.h"
+#include "frontend/parse_cache.h"
+#include <cstdio>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s (%s)\n", what, got.c_str());
+}
+
+static void write(const fs::path& path, const std::string& text) {
+    fs::create_directories(path.parent_path());
+    std::ofstream(path) << text;
+}
+
+// Components, imports and errors of every file, in path order
+static std::string summary(const std::map<std::string, LoadedFile>& files, const fs::path& root) {
+    std::string out;
+    for (const auto& [path, file] : files) {
+        out += fs::relative(path, root).string() + ":";
+        for (const auto& comp : file.components) out += " " + comp.name;
+        for (const auto& import : file.imports) {
+            out += import.error.empty() ? " ->" + fs::relative(import.path, root).string() : " !import";
+        }
+        if (file.error) out += " !parse";
+        out += "\n";
+    }
+    return out;
+}
+
+int main() {
+    fs::path root = fs::temp_directory_path() / "coi_loader_test";
+    fs::remove_all(root);
+    write(root / "src/App.coi", "import \"B.coi\";\nimport \"C.coi\";\ncomponent App {}\napp { root = App; }\n");
+    write(root / "src/B.coi", "pub import \"D.coi\";\ncomponent B {}\n");
+    write(root / "src/C.coi", "import \"D.coi\";\nimport \"@acme/ui\";\nimport \"Bad.coi\";\ncomponent C {}\n");
+    write(root / "src/D.coi", "import \"Missing.coi\";\ncomponent D {}\n");
+    write(root / "src/Bad.coi", "component Bad { def f() : int { return (1 + ; } }\n");
+    write(root / ".coi/pkgs/acme/ui/Mod.coi", "import \"../ui/Button.coi\";\ncomponent Ui {}\n");
+    write(root / ".coi/pkgs/acme/ui/Button.coi", "component Button {}\n");
+    root = fs::canonical(root);
+    std::string entry = (root / "src/App.coi").string();
+
+    const std::string expected =
+        ".coi/pkgs/acme/ui/Button.coi: Button\n"
+        ".coi/pkgs/acme/ui/Mod.coi: Ui ->.coi/pkgs/acme/ui/Button.coi\n"
+        "src/App.coi: App ->src/B.coi ->src/C.coi\n"
+        "src/B.coi: B ->src/D.coi\n"
+        "src/Bad.coi: !parse\n"
+        "src/C.coi: C ->src/D.coi ->.coi/pkgs/acme/ui/Mod.coi ->src/Bad.coi\n"
+        "src/D.coi: D !import\n";
+
+    for (int jobs : {1, 2, 8}) {
+        for (int round = 0; round < 20; round++) {
+            SourceManager sources;
+            std::deque<AstArena> arenas;
+            auto files = load_files(entry, root, jobs, sources, arenas);
+            std::string got = summary(files, root);
+            expect(got == expected, "loaded files", got);
+            expect(arenas.size() == static_cast<size_t>(jobs - 1), "one arena per extra thread");
+            expect(files.at(entry).app_config.root_component == "App", "app config");
+            expect(files.at((root / "src/B.coi").string()).imports.at(0).is_public, "pub import");
+        }
+    }
+
+    // A second load through the cache reuses every file that parsed
+    for (int pass = 0; pass < 2; pass++) {
+        SourceManager sources;
+        std::deque<AstArena> arenas;
+        ParseCache cache(root / ".coi/cache/parse", "test");
+        auto files = load_files(entry, root, 2, sources, arenas, &cache);
+        std::string got = summary(files, root);
+        expect(got == expected, "loaded files through the cache", got);
+        expect(cache.hits() == (pass ? 6u : 0u) && cache.misses() == (pass ? 1u : 7u), "cache hits",
+               std::to_string(cache.hits()) + "/" + std::to_string(cache.misses()));
+    }
+
+    fs::remove_all(root);
+    return failures ? 1 : 0;
+}
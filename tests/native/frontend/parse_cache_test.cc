@@ -0,0 +1,147 @@
+// ParseCache over the example app and the unit tests. Every file that parses
+// must come back from the cache unchanged: storing the loaded result again
+// must write the very same bytes. Entries of another compiler build, and
+// truncated entries, must miss. Pruning must delete what no compilation of
+// this build reads again and keep the directory under its size limit.
+
+#include "frontend/parse_cache.h"
+#include "frontend/lexer.h"
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, const std::string& got = "") {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s (%s)\n", what, got.c_str());
+}
+
+static std::string read(const fs::path& path) {
+    std::ifstream in(path, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+// The only entry in dir
+static fs::path entry(const fs::path& dir) {
+    fs::path found;
+    for (const auto& e : fs::directory_iterator(dir)) found = e.path();
+    return found;
+}
+
+static bool parse(const std::string& source, ParsedFile& file) {
+    try {
+        Lexer lexer(source);
+        Parser parser(source, lexer.tokenize());
+        parser.parse_file();
+        file.components = std::move(parser.components);
+        file.global_data = std::move(parser.global_data);
+        file.global_enums = std::move(parser.global_enums);
+        file.imports = std::move(parser.imports);
+        file.app_config = std::move(parser.app_config);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+int main() {
+    fs::path repo = fs::path(__FILE__).parent_path() / "../../..";
+    fs::path root = fs::temp_directory_path() / "coi_parse_cache_test";
+
+    std::vector<fs::path> files;
+    for (const char* dir : {"example/src", "tests/unit"}) {
+        for (const auto& e : fs::recursive_directory_iterator(repo / dir)) {
+            if (e.path().extension() == ".coi") files.push_back(e.path());
+        }
+    }
+
+    AstArena arena;
+    AstArena::Scope scope(arena);
+    int cached = 0;
+    for (const auto& path : files) {
+        std::string source = read(path);
+        ParsedFile parsed;
+        if (!parse(source, parsed)) continue;
+        cached++;
+        std::string name = path.filename().string();
+
+        fs::remove_all(root);
+        ParseCache first(root / "first", "test");
+        expect(!first.load(source, parsed), "empty cache misses", name);
+        first.store(source, parsed);
+        std::string stored = read(entry(root / "first"));
+
+        ParsedFile loaded;
+        expect(first.load(source, loaded), "stored entry hits", name);
+        expect(first.hits() == 1 && first.misses() == 1, "hit and miss counts", name);
+        ParseCache second(root / "second", "test");
+        second.store(source, loaded);
+        expect(read(entry(root / "second")) == stored, "loaded result stores the same bytes", name);
+
+        fs::copy_file(entry(root / "first"), root / "second" / entry(root / "first").filename(),
+                      fs::copy_options::overwrite_existing);
+        ParseCache other_build(root / "second", "other");
+        ParsedFile ignored;
+        expect(!other_build.load(source, ignored), "other compiler build misses", name);
+
+        fs::resize_file(entry(root / "first"), stored.size() - 1);
+        ParsedFile truncated;
+        expect(!first.load(source, truncated), "truncated entry misses", name);
+        expect(truncated.components.empty(), "missed load leaves no results", name);
+    }
+    expect(cached > 100, "files parsed", std::to_string(cached));
+
+    // Five entries of this build, one of another build, a dead temporary file
+    fs::remove_all(root);
+    fs::path dir = root / "prune";
+    ParseCache cache(dir, "test");
+    ParseCache other(dir, "other");
+    ParsedFile parsed;
+    expect(parse("component App { view { <div/> } }", parsed), "prune source parses");
+    std::vector<std::string> sources;
+    std::vector<fs::path> paths;
+    for (int i = 0; i < 6; i++) {
+        sources.push_back("// " + std::to_string(i));
+        std::set<fs::path> before;
+        for (const auto& e : fs::directory_iterator(dir)) before.insert(e.path());
+        (i < 5 ? cache : other).store(sources[i], parsed);
+        for (const auto& e : fs::directory_iterator(dir)) {
+            if (!before.count(e.path())) paths.push_back(e.path());
+        }
+    }
+    fs::path temp = dir / "0123456789abcdef.parse.tmp1-2";
+    std::ofstream(temp) << "partial";
+    expect(paths.size() == 6, "one file per entry", std::to_string(paths.size()));
+
+    // Last used this many days ago; the first is past the age limit
+    auto now = fs::file_time_type::clock::now();
+    auto days_ago = [&](int days) { return now - std::chrono::hours(24 * days); };
+    int ages[] = {ParseCache::MAX_AGE_DAYS + 1, 4, 3, 2, 1, 1};
+    for (size_t i = 0; i < paths.size(); i++) fs::last_write_time(paths[i], days_ago(ages[i]));
+    fs::last_write_time(temp, days_ago(1));
+
+    // A hit makes the entry the most recently used
+    ParsedFile loaded;
+    expect(cache.load(sources[1], loaded), "entry hits before prune");
+
+    // Room for two entries: the used one and the newest survive
+    cache.prune(2 * fs::file_size(paths[1]));
+    std::vector<bool> kept;
+    for (const auto& path : paths) kept.push_back(fs::exists(path));
+    expect(kept == std::vector<bool>{false, true, false, false, true, false}, "prune keeps the two most recently used");
+    expect(!fs::exists(temp), "prune deletes dead temporary files");
+    ParsedFile again;
+    expect(cache.load(sources[4], again), "kept entry still hits");
+
+    // Under the limit nothing of this build goes
+    cache.prune();
+    expect(fs::exists(paths[1]) && fs::exists(paths[4]), "prune under the limit keeps entries");
+
+    fs::remove_all(root);
+    return failures ? 1 : 0;
+}
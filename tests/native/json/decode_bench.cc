@@ -0,0 +1,66 @@
+// Decoding throughput of the emitted JSON runtime over a few generated
+// corpora. Run with `tests/run.py native --bench`.
+
+#include "json_gen.h"
+#include <chrono>
+#include <cstdio>
+
+static coi::string rows_corpus() {
+    coi::string json = "[";
+    for (int i = 0; i < 20000; i++) {
+        if (i) json += ",";
+        json += "{\"id\":" + std::to_string(i) + ",\"name\":\"user " + std::to_string(i) +
+                "\",\"done\":false,\"score\":" + std::to_string(i % 97) + ".25,\"at\":{\"x\":12.5,\"y\":-3}" +
+                ",\"ids\":[1,2,3,4],\"tags\":[\"red\",\"green\"]}";
+    }
+    return json + "]";
+}
+
+// Long text fields, a few with escapes
+static coi::string articles_corpus() {
+    coi::string text;
+    for (int i = 0; i < 40; i++) text += "Lorem ipsum dolor sit amet, consectetur adipiscing. ";
+    coi::string json = "[";
+    for (int i = 0; i < 2000; i++) {
+        if (i) json += ",";
+        json += "{\"id\":" + std::to_string(i) + ",\"title\":\"Article number " + std::to_string(i) +
+                "\",\"body\":\"" + text + (i % 4 == 0 ? "with a \\\"quote\\\"\\n" : "") +
+                "\",\"tags\":[\"news\",\"long\"]}";
+    }
+    return json + "]";
+}
+
+// Indented output with unknown keys whose values are only skipped
+static coi::string pretty_corpus() {
+    coi::string json = "[\n";
+    for (int i = 0; i < 10000; i++) {
+        if (i) json += ",\n";
+        json += "    {\n        \"id\": " + std::to_string(i) +
+                ",\n        \"audit\": {\n            \"history\": [\"created\", \"edited {twice}\", \"closed]\"],\n"
+                "            \"by\": {\"name\": \"admin\", \"roles\": [[1, 2], [3]]}\n        },\n"
+                "        \"name\": \"item\",\n        \"at\": {\"x\": 1, \"y\": 2}\n    }";
+    }
+    return json + "\n]";
+}
+
+template<typename F>
+static void run(const char* name, const coi::string& json, F parse) {
+    double best = 1e9;
+    size_t count = 0;
+    for (int round = 0; round < 15; round++) {
+        auto start = std::chrono::steady_clock::now();
+        auto result = parse(json);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        count = result.as_Success()._0.size();
+        if (seconds < best) best = seconds;
+    }
+    std::printf("%-10s %7.2f MB  %6zu items  %8.3f ms  %8.1f MB/s\n", name, json.size() / 1e6, count,
+                best * 1e3, json.size() / 1e6 / best);
+}
+
+int main() {
+    run("rows", rows_corpus(), [](const coi::string& s) { return parse_Row_array(s); });
+    run("articles", articles_corpus(), [](const coi::string& s) { return parse_Article_array(s); });
+    run("pretty", pretty_corpus(), [](const coi::string& s) { return parse_Row_array(s); });
+    return 0;
+}
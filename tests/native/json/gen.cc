@@ -0,0 +1,72 @@
+// Writes json_gen.h for the native JSON tests: the runtime, a few pod types
+// with their Meta structs, one parse_<Type>() function per root form, a
+// feed_<Type>() array stream decoder and the Json.stringify serializers, all
+// produced by the compiler's own json_codegen.
+
+#include "codegen/json_codegen.h"
+#include <iostream>
+
+struct TestType {
+    std::string name;
+    std::vector<DataField> fields;
+};
+
+static const std::vector<TestType> test_types = {
+    {"Point", {{"float", "x"}, {"float", "y"}}},
+    {"Row", {{"int", "id"}, {"string", "name"}, {"bool", "done"}, {"float", "score"},
+             {"Point", "at"}, {"int[]", "ids"}, {"string[]", "tags"}}},
+    {"Article", {{"int", "id"}, {"string", "title"}, {"string", "body"}, {"string[]", "tags"}}},
+    {"Task", {{"string", "title"}, {"Level", "level"}, {"int[3]", "slots"}, {"Row[]", "rows"}}},
+};
+
+static const JsonEnum test_enum = {"Level", {"Low", "High"}};
+
+static std::string cpp_type(const std::string& type) {
+    if (type.size() > 2 && type.substr(type.size() - 2) == "[]") {
+        return "coi::vector<" + cpp_type(type.substr(0, type.size() - 2)) + ">";
+    }
+    if (type.back() == ']') {
+        size_t open = type.rfind('[');
+        return "coi::array<" + cpp_type(type.substr(0, open)) + ", " +
+               type.substr(open + 1, type.size() - open - 2) + ">";
+    }
+    if (type == "int") return "int32_t";
+    if (type == "float") return "double";
+    if (type == "bool") return "bool";
+    if (type == "string") return "coi::string";
+    return type;
+}
+
+int main() {
+    for (const auto& t : test_types) {
+        DataTypeRegistry::instance().register_type(t.name, t.fields);
+    }
+
+    std::cout << "#pragma once\n#include \"shim.h\"\n";
+    emit_json_runtime(std::cout, true, true);
+
+    std::cout << "enum struct " << test_enum.name << " : uint8_t {\n";
+    for (const auto& value : test_enum.values) std::cout << "    " << value << ",\n";
+    std::cout << "    _COUNT\n};\n";
+
+    for (const auto& t : test_types) {
+        std::cout << "struct " << t.name << " {\n";
+        for (const auto& f : t.fields) {
+            std::cout << "    " << cpp_type(f.type) << " " << f.name << "{};\n";
+        }
+        std::cout << "};\n";
+        std::cout << generate_meta_struct(t.name);
+        std::cout << generate_field_token_constants(t.name);
+        std::cout << "inline auto parse_" << t.name << "(coi::string_view json) {\n    return "
+                  << generate_json_parse(t.name, "json") << ";\n}\n";
+        std::cout << "inline auto parse_" << t.name << "_array(coi::string_view json) {\n    return "
+                  << generate_json_parse(t.name + "[]", "json") << ";\n}\n";
+        std::cout << "inline auto feed_" << t.name << "(__coi_json::Stream& stream, coi::string_view json) {\n    return "
+                  << generate_json_feed(t.name + "[]", "stream", "json") << ";\n}\n";
+    }
+
+    std::vector<std::string> names;
+    for (const auto& t : test_types) names.push_back(t.name);
+    std::cout << generate_json_writers(names, {test_enum});
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Decoding a 10k-element array must allocate exactly what building the same
+// result by hand does: the decoded values are never copied on their way to
+// the match binding.
+
+#include "json_gen.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static bool counting = false;
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    if (counting) allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static constexpr int count = 10000;
+
+int main() {
+    // Short names and tags stay within the small-string buffer, so only the
+    // vectors allocate.
+    coi::string json = "[";
+    for (int i = 0; i < count; i++) {
+        if (i) json += ",";
+        json += "{\"id\":" + std::to_string(i) + ",\"name\":\"row" + std::to_string(i % 100) +
+                "\",\"done\":true,\"score\":1.5,\"at\":{\"x\":1,\"y\":2},\"ids\":[1,2,3],\"tags\":[\"a\",\"b\"]}";
+    }
+    json += "]";
+
+    allocations = 0;
+    counting = true;
+    {
+        coi::vector<Row> rows;
+        coi::vector<RowMeta> metas;
+        for (int i = 0; i < count; i++) {
+            Row row{};
+            row.id = i;
+            row.name = "row" + std::to_string(i % 100);
+            row.done = true;
+            row.score = 1.5;
+            row.at = Point{1, 2};
+            row.ids.push_back(1); row.ids.push_back(2); row.ids.push_back(3);
+            row.tags.push_back("a"); row.tags.push_back("b");
+            rows.push_back(coi::move(row));
+            metas.push_back(RowMeta{});
+        }
+    }
+    counting = false;
+    size_t expected = allocations;
+
+    allocations = 0;
+    counting = true;
+    {
+        const auto& result = parse_Row_array(json);
+        counting = false;
+        if (!result.is_Success()) {
+            std::printf("FAIL: parse error: %s\n", result.as_Error()._0.c_str());
+            return 1;
+        }
+        const auto& rows = result.as_Success()._0;
+        const auto& metas = result.as_Success()._1;
+        if (rows.size() != count || metas.size() != count || rows[9999].id != 9999 ||
+            rows[42].name != "row42" || rows[7].ids.size() != 3 || rows[7].tags[1] != "b" ||
+            !metas[5].has(__coi_field_Row_at) || !metas[5].at.has(__coi_field_Point_y)) {
+            std::printf("FAIL: decoded values are wrong\n");
+            return 1;
+        }
+    }
+    counting = false;
+
+    if (allocations != expected) {
+        std::printf("FAIL: %zu allocations, expected %zu\n", allocations, expected);
+        return 1;
+    }
+    return 0;
+}
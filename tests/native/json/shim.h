@@ -0,0 +1,28 @@
+// Minimal stand-in for the coi:: types used by the emitted JSON code, so the
+// runtime and generated decoders can be built and run natively.
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace coi {
+using string = std::string;
+using string_view = std::string_view;
+template<typename T> using vector = std::vector<T>;
+template<typename T, size_t N> using array = std::array<T, N>;
+using std::move;
+}
+
+namespace webcc {
+template<int N>
+struct formatter {
+    char buf[N] = {};
+    formatter& operator<<(double v) { std::snprintf(buf, N, "%.17g", v); return *this; }
+    const char* c_str() const { return buf; }
+};
+}
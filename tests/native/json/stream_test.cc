@@ -0,0 +1,105 @@
+// Json.feed decodes an array that arrives in chunks. Feed a document byte at
+// a time and split at every offset, and check that the elements match a
+// one-shot Json.parse, arrive as soon as they are complete, and that only the
+// element straddling a chunk boundary is ever buffered.
+
+#include "json_gen.h"
+#include <cstdio>
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, int a) {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s (%d)\n", what, a);
+}
+
+static Row make_row(int i) {
+    Row row;
+    row.id = i - 3;
+    row.name = "row \"" + std::to_string(i) + "\" ]}\\ [{";
+    row.done = i % 2 == 0;
+    row.score = i * 0.25;
+    row.at = {i * 1.5, -i * 1.0};
+    for (int k = 0; k < i % 4; k++) row.ids.push_back(k * i);
+    for (int k = 0; k < i % 3; k++) row.tags.push_back(k ? "t,\n" : "");
+    return row;
+}
+
+// Feed doc split at the given offsets; the decoded rows and metas are appended
+static bool feed_all(const coi::string& doc, const std::vector<size_t>& cuts,
+                     std::vector<Row>& rows, uint32_t& most_buffered) {
+    __coi_json::Stream stream;
+    size_t from = 0;
+    most_buffered = 0;
+    for (size_t i = 0; i <= cuts.size(); i++) {
+        size_t to = i < cuts.size() ? cuts[i] : doc.size();
+        auto r = feed_Row(stream, coi::string_view(doc).substr(from, to - from));
+        if (!r.is_Success()) return false;
+        for (auto& row : r.as_Success()._0) rows.push_back(row);
+        if (r.as_Success()._0.size() != r.as_Success()._1.size()) return false;
+        if (stream.tail_len > most_buffered) most_buffered = stream.tail_len;
+        if (stream.done() != (to > doc.rfind(']'))) return false;
+        from = to;
+    }
+    return true;
+}
+
+int main() {
+    std::vector<Row> want;
+    uint32_t largest = 0;
+    for (int i = 0; i < 12; i++) {
+        want.push_back(make_row(i));
+        uint32_t n = __coi_json::size(want.back());
+        if (n > largest) largest = n;
+    }
+    // Scalars and unknown values between the objects are skipped, as by Json.parse
+    coi::string body = __coi_json::stringify(want);
+    coi::string doc = " [ " + body.substr(1, body.size() - 2) + " , 5 , \"x]\" , [ {} ] , null ] \n";
+    coi::string expected = __coi_json::stringify(want);
+
+    auto whole = parse_Row_array(doc);
+    expect(whole.is_Success() && __coi_json::stringify(whole.as_Success()._0) == expected, "one-shot parse", 0);
+
+    // One chunk: every element is read in place
+    std::vector<Row> got;
+    uint32_t buffered;
+    expect(feed_all(doc, {}, got, buffered) && __coi_json::stringify(got) == expected, "single chunk", 0);
+    expect(buffered == 0, "single chunk buffers nothing", (int)buffered);
+
+    // Byte at a time
+    std::vector<size_t> bytes;
+    for (size_t i = 1; i < doc.size(); i++) bytes.push_back(i);
+    got.clear();
+    expect(feed_all(doc, bytes, got, buffered) && __coi_json::stringify(got) == expected, "byte at a time", 0);
+    expect(buffered <= largest, "byte at a time buffers one element", (int)buffered);
+
+    // Every two-chunk split
+    for (size_t cut = 0; cut <= doc.size(); cut++) {
+        got.clear();
+        expect(feed_all(doc, {cut}, got, buffered) && __coi_json::stringify(got) == expected, "split", (int)cut);
+        expect(buffered <= largest, "split buffers one element", (int)cut);
+    }
+
+    // An element is handed out by the chunk that completes it
+    __coi_json::Stream stream;
+    auto a = feed_Row(stream, "[{\"id\":1},{\"id\":");
+    expect(a.is_Success() && a.as_Success()._0.size() == 1 && a.as_Success()._1[0].has(0), "first element early", 0);
+    auto b = feed_Row(stream, "2}");
+    expect(b.is_Success() && b.as_Success()._0.size() == 1 && b.as_Success()._0[0].id == 2, "second element", 0);
+    auto c = feed_Row(stream, " ]");
+    expect(c.is_Success() && c.as_Success()._0.empty() && stream.done(), "closing bracket", 0);
+
+    // Anything after the array, or a malformed element, fails until reset
+    expect(feed_Row(stream, " x").is_Error(), "trailing garbage", 0);
+    expect(feed_Row(stream, "").is_Error(), "failure is sticky", 0);
+    stream.reset();
+    expect(feed_Row(stream, "[]").is_Success() && stream.done(), "reset", 0);
+    const char* bad[] = {"{}", "[{\"id\":1,}]", "[{\"id\":1}{\"id\":2}]", "[,{}]", "[{},]", "[tru e]", "[{\"id\":1]]"};
+    for (int i = 0; i < (int)(sizeof(bad) / sizeof(bad[0])); i++) {
+        bool failed = false;
+        __coi_json::Stream s;
+        for (const char* p = bad[i]; *p && !failed; p++) failed = feed_Row(s, coi::string_view(p, 1)).is_Error();
+        expect(failed, "malformed document", i);
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,82 @@
+// The runtime scans strings and skipped values a word at a time. Check that
+// quotes, escapes and brackets are found at every offset within a word, and
+// that a string without escapes is copied with a single allocation.
+
+#include "json_gen.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static bool counting = false;
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    if (counting) allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+static int failures = 0;
+
+static void expect(bool ok, const char* what, int a, int b) {
+    if (!ok && failures++ < 10) std::printf("FAIL: %s (%d, %d)\n", what, a, b);
+}
+
+int main() {
+    const char* escapes[][2] = {{"\\\"", "\""}, {"\\\\", "\\"}, {"\\n", "\n"}, {"\\/", "/"}};
+
+    for (int pad = 0; pad < 17; pad++) {
+        // pad shifts everything after it across word boundaries
+        coi::string lead = "{\"tags\":[\"" + coi::string(pad, 'p') + "\"],";
+
+        for (int n = 0; n < 40; n++) {
+            coi::string plain(n, 'a');
+            for (int i = 0; i < n; i++) plain[i] = 'a' + i % 26;
+
+            auto r = parse_Article(lead + "\"title\":\"" + plain + "\",\"id\":1}");
+            expect(r.is_Success() && r.as_Success()._0.title == plain && r.as_Success()._0.id == 1,
+                   "plain string", pad, n);
+
+            for (int at = 0; at <= n; at++) {
+                for (auto& e : escapes) {
+                    coi::string raw = plain.substr(0, at) + e[0] + plain.substr(at);
+                    coi::string want = plain.substr(0, at) + e[1] + plain.substr(at);
+                    auto q = parse_Article(lead + "\"title\":\"" + raw + "\",\"id\":2}");
+                    expect(q.is_Success() && q.as_Success()._0.title == want && q.as_Success()._0.id == 2,
+                           "escaped string", pad, at);
+                }
+            }
+
+            // An unknown value whose strings hold brackets and quotes is skipped whole
+            coi::string junk = "{\"a\":[\"" + plain + "]}\\\"\",{\"b\":\"" + plain + "{[\"}],\"c\":[[1],{}]}";
+            auto k = parse_Article(lead + "\"junk\":" + junk + ",\"id\":3}");
+            expect(k.is_Success() && k.as_Success()._0.id == 3, "skipped value", pad, n);
+
+            // Unterminated strings and containers are malformed at every length
+            expect(parse_Article(lead + "\"title\":\"" + plain).is_Error(), "open string", pad, n);
+            expect(parse_Article(lead + "\"junk\":[\"" + plain + "\"").is_Error(), "open array", pad, n);
+        }
+    }
+
+    // \u escapes decode to UTF-8, surrogate pairs to one code point
+    auto u = parse_Article("{\"title\":\"\\u00e9\\u20AC\\ud83d\\ude00\\u0041\"}");
+    expect(u.is_Success() && u.as_Success()._0.title == "\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80" "A",
+           "unicode escapes", 0, 0);
+    auto bad = parse_Article("{\"title\":\"\\u00g0\"}");
+    expect(bad.is_Success() && !bad.as_Success()._1.has(__coi_field_Article_title), "bad unicode escape", 0, 0);
+
+    coi::string body(1000, 'x');
+    coi::string json = "{\"body\":\"" + body + "\"}";
+    allocations = 0;
+    counting = true;
+    {
+        auto r = parse_Article(json);
+        counting = false;
+        expect(r.is_Success() && r.as_Success()._0.body == body, "long string", 0, 0);
+    }
+    expect(allocations == 1, "long string allocations", (int)allocations, 1);
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,92 @@
+// Json.stringify writes the exact encoding in one pass: check the output of
+// every kind of field, that it parses back, and that nothing but the output
+// string is allocated.
+
+#include "json_gen.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+static bool counting = false;
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    if (counting) allocations++;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete[](void* p, size_t) noexcept { std::free(p); }
+
+static int failures = 0;
+
+static void expect_eq(const coi::string& got, const coi::string& want, const char* what) {
+    if (got != want) {
+        failures++;
+        std::printf("FAIL: %s\n  got:  %s\n  want: %s\n", what, got.c_str(), want.c_str());
+    }
+}
+
+static size_t allocations_of(coi::string (*make)(const Task&), const Task& task, coi::string& out) {
+    allocations = 0;
+    counting = true;
+    out = make(task);
+    counting = false;
+    return allocations;
+}
+
+int main() {
+    Row row{};
+    row.id = -2147483647 - 1;
+    row.name = "quote \" backslash \\ tab \t nul-ish \x01 caf\xc3\xa9";
+    row.done = true;
+    row.score = 0.0 / 0.0;
+    row.at = Point{1.5, -2};
+    row.ids = {0, 42};
+    expect_eq(__coi_json::stringify(row),
+              "{\"id\":-2147483648,\"name\":\"quote \\\" backslash \\\\ tab \\t nul-ish \\u0001 caf\xc3\xa9\","
+              "\"done\":true,\"score\":null,\"at\":{\"x\":1.5,\"y\":-2},\"ids\":[0,42],\"tags\":[]}",
+              "row");
+
+    Task task{};
+    task.title = "plan";
+    task.level = Level::High;
+    task.slots = {1, 2, 3};
+    expect_eq(__coi_json::stringify(task), "{\"title\":\"plan\",\"level\":\"High\",\"slots\":[1,2,3],\"rows\":[]}", "task");
+    task.level = Level::_COUNT;
+    expect_eq(__coi_json::stringify(task), "{\"title\":\"plan\",\"level\":null,\"slots\":[1,2,3],\"rows\":[]}", "bad enum");
+
+    // Every control character has an escape
+    coi::string controls;
+    for (int c = 1; c < 32; c++) controls += (char)c;
+    Article article{};
+    article.body = controls;
+    coi::string encoded = __coi_json::stringify(article);
+    auto back = parse_Article(encoded);
+    expect_eq(back.is_Success() ? back.as_Success()._0.body : "<error>", controls, "control characters");
+
+    // Round trip through the decoder
+    row.score = 0.25;
+    row.tags = {"a", "b\"c"};
+    auto parsed = parse_Row(__coi_json::stringify(row));
+    expect_eq(parsed.is_Success() ? __coi_json::stringify(parsed.as_Success()._0) : "<error>",
+              __coi_json::stringify(row), "round trip");
+
+    // Small outputs are built on the stack: the result is the only allocation
+    coi::string out;
+    size_t small = allocations_of(__coi_json::stringify<Task>, task, out);
+    if (small != 1) { failures++; std::printf("FAIL: %zu allocations for a small task\n", small); }
+
+    // Large ones add a single scratch buffer of the exact size
+    for (int i = 0; i < 100; i++) task.rows.push_back(row);
+    size_t large = allocations_of(__coi_json::stringify<Task>, task, out);
+    if (large != 2 || out.size() != __coi_json::size(task)) {
+        failures++;
+        std::printf("FAIL: %zu allocations for a %zu-byte task\n", large, out.size());
+    }
+
+    return failures ? 1 : 0;
+}
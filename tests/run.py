@@ -11,6 +11,7 @@ sys.path.append(str(Path(__file__).parent))
 from runner.unit import UnitRunner
 from runner.integration import IntegrationRunner
 from runner.gallery import GalleryRunner
+from runner.native import NativeRunner
 
 # Paths
 SCRIPT_DIR = Path(__file__).parent.resolve()
@@ -23,6 +24,10 @@ def main():
     # Unit Tests
     p_unit = subparsers.add_parser("unit", help="Run unit tests")
 
+    # Native Tests
+    p_native = subparsers.add_parser("native", help="Run native tests of generated runtime code")
+    p_native.add_argument("--bench", action="store_true", help="Run the native benchmarks instead")
+
     # Gallery
     p_gallery = subparsers.add_parser("gallery", help="Run web visual gallery")
     p_gallery.add_argument("--scene", help="Scene name filter (e.g. input_*)")
@@ -46,7 +51,7 @@ def main():
     p_list.add_argument("--scene", help="Filter scenes")
 
     # All
-    p_all = subparsers.add_parser("all", help="Run all tests (unit + integration)")
+    p_all = subparsers.add_parser("all", help="Run all tests (unit + native + integration)")
     p_all.add_argument("--browser", help="Browser binary path")
     p_all.add_argument("--out", help="Output dir", default="tests/integration/web/.cache/integration")
     p_all.add_argument("--size", help="Viewport size", default="960x540")
@@ -59,6 +64,10 @@ def main():
     if args.command == "unit":
         runner = UnitRunner(PROJECT_ROOT)
         runner.run(SCRIPT_DIR)
+
+    elif args.command == "native":
+        runner = NativeRunner(PROJECT_ROOT)
+        runner.run(SCRIPT_DIR / "native", args.bench)
         
     elif args.command == "integration":
         runner = IntegrationRunner(PROJECT_ROOT)
@@ -68,6 +77,9 @@ def main():
         print("==> Running UNIT tests")
         unit = UnitRunner(PROJECT_ROOT)
         unit.run(SCRIPT_DIR)
+        print("\n==> Running NATIVE tests")
+        native = NativeRunner(PROJECT_ROOT)
+        native.run(SCRIPT_DIR / "native")
         print("\n==> Running INTEGRATION tests")
         integration = IntegrationRunner(PROJECT_ROOT)
         integration.run(args)
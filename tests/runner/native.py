@@ -0,0 +1,113 @@
+import os
+import sys
+import subprocess
+from pathlib import Path
+from .base import TestRunnerBase, GREEN, RED, NC
+
+class NativeRunner(TestRunnerBase):
+    """Builds and runs the native C++ tests in tests/native.
+
+    A suite directory may hold a sources.txt listing compiler sources (globs
+    relative to src/) to link into each program, and a gen.cc whose output
+    becomes <suite>_gen.h. gen.cc is linked against those sources, or
+    against the JSON code generator when the suite has none.
+    Every *_test.cc in the suite is then compiled and run (exit code 0
+    passes). With bench=True the *_bench.cc programs are built and run
+    instead, and their output is printed.
+    """
+
+    def __init__(self, root_dir):
+        super().__init__(root_dir)
+        self.cxx = os.environ.get("CXX", "clang++")
+        self.out_dir = self.root_dir / "tests/native/.cache"
+        self.objects = {}  # Source -> object, shared by the suites of one run
+
+    def compile(self, sources, output, includes):
+        cmd = [self.cxx, "-std=c++20", "-O2", "-Wall"]
+        cmd += [f"-I{path}" for path in includes]
+        cmd += [str(src) for src in sources] + ["-o", str(output)]
+        result = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True)
+        return result.returncode == 0, result.stdout
+
+    def compile_objects(self, sources, obj_dir, includes):
+        """Compiles sources to objects in parallel; returns (objects, failure log).
+
+        A source already compiled for another suite in this run is reused."""
+        obj_dir.mkdir(parents=True, exist_ok=True)
+        jobs = []
+        for src in sources:
+            if src in self.objects:
+                continue
+            obj = obj_dir / (str(src.relative_to(self.root_dir / "src")).replace("/", "_") + ".o")
+            cmd = [self.cxx, "-std=c++20", "-O2", "-Wall", "-c"]
+            cmd += [f"-I{path}" for path in includes] + [str(src), "-o", str(obj)]
+            jobs.append((src, obj, subprocess.Popen(cmd, stdout=subprocess.PIPE,
+                                                    stderr=subprocess.STDOUT, text=True)))
+        log = ""
+        for src, obj, job in jobs:
+            out, _ = job.communicate()
+            if job.returncode != 0:
+                log += out
+            else:
+                self.objects[src] = obj
+        return [self.objects.get(src) for src in sources], log
+
+    def run(self, native_dir, bench=False):
+        native_dir = Path(native_dir).resolve()
+        src_dir = self.root_dir / "src"
+        suites = sorted({path.parent for pattern in ("*/gen.cc", "*/sources.txt")
+                         for path in native_dir.glob(pattern)})
+
+        passed = 0
+        failures = []
+        for suite in suites:
+            build_dir = self.out_dir / suite.name
+            build_dir.mkdir(parents=True, exist_ok=True)
+
+            linked = []
+            if (suite / "sources.txt").exists():
+                sources = []
+                for pattern in (suite / "sources.txt").read_text().split():
+                    sources += sorted(src_dir.glob(pattern))
+                linked, log = self.compile_objects(sources, build_dir / "obj", [src_dir])
+                if log:
+                    failures.append((f"{suite.name}/sources.txt", log))
+                    continue
+
+            if (suite / "gen.cc").exists():
+                gen_bin = build_dir / "gen"
+                generators = [suite / "gen.cc"] + (linked or [src_dir / "codegen/json_codegen.cc"])
+                ok, log = self.compile(generators, gen_bin, [src_dir])
+                if ok:
+                    with open(build_dir / f"{suite.name}_gen.h", "w") as header:
+                        result = subprocess.run([str(gen_bin)], stdout=header, stderr=subprocess.PIPE, text=True)
+                    ok, log = result.returncode == 0, result.stderr
+                if not ok:
+                    failures.append((f"{suite.name}/gen.cc", log))
+                    continue
+
+            for test in sorted(suite.glob("*_bench.cc" if bench else "*_test.cc")):
+                name = f"{suite.name}/{test.name}"
+                test_bin = build_dir / test.stem
+                ok, log = self.compile([test] + linked, test_bin, [build_dir, suite, src_dir])
+                if ok:
+                    result = subprocess.run([str(test_bin)], stdout=subprocess.PIPE,
+                                            stderr=subprocess.STDOUT, text=True)
+                    ok, log = result.returncode == 0, result.stdout
+                    if bench:
+                        print(f"{name}\n{log}")
+                if ok:
+                    passed += 1
+                else:
+                    failures.append((name, log))
+
+        total = passed + len(failures)
+        if len(failures) == 0:
+            print(f"{GREEN}All {total} native tests passed!{NC}")
+        else:
+            print(f"{RED}{len(failures)} native test(s) failed:{NC}")
+            for name, log in failures:
+                print(f"  {RED}✗{NC} {name}")
+                print(log)
+            print(f"\n{GREEN}{passed} passed{NC}, {RED}{len(failures)} failed{NC} out of {total} tests")
+            sys.exit(1)